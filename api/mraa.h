@@ -33,9 +33,12 @@ extern "C" {
 #include "mraa/aio.h"
 #include "mraa/gpio.h"
 #include "mraa/spi.h"
+#include "mraa/spi_flash.h"
 #include "mraa/i2c.h"
 #include "mraa/uart.h"
+#include "mraa/uart_group.h"
 #include "mraa/uart_ow.h"
+#include "mraa/modbus.h"
 #include "mraa/led.h"
 
 #ifdef __cplusplus
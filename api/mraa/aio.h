@@ -52,6 +52,36 @@ extern "C" {
  */
 typedef struct _aio* mraa_aio_context;
 
+/**
+ * Opaque pointer definition to a group of AIO channels read together
+ */
+typedef struct _aio_group* mraa_aio_group_context;
+
+/** Most raw reads summed into one sample by mraa_aio_set_filter() */
+#define MRAA_AIO_FILTER_MAX_OVERSAMPLING 1024
+
+/** Longest window of mraa_aio_set_filter() */
+#define MRAA_AIO_FILTER_MAX_LENGTH 64
+
+/**
+ * Filters applied to decimated samples by mraa_aio_set_filter()
+ */
+typedef enum {
+    MRAA_AIO_FILTER_NONE = 0,           /**< decimate only */
+    MRAA_AIO_FILTER_MOVING_AVERAGE = 1, /**< mean of the last length samples */
+    MRAA_AIO_FILTER_EMA = 2,            /**< exponential moving average, weight 2 / (length + 1) */
+    MRAA_AIO_FILTER_MEDIAN = 3          /**< median of the last length samples */
+} mraa_aio_filter_t;
+
+/**
+ * Counters of a continuous capture
+ */
+typedef struct {
+    uint64_t samples;  /**< samples taken */
+    uint64_t overruns; /**< samples missed at the source, by a full kernel buffer or a late thread */
+    uint64_t dropped;  /**< samples lost because the ring was full */
+} mraa_aio_stream_stats_t;
+
 /**
  * Initialise an Analog input device, connected to the specified pin. Aio pins
  * are always 0 indexed reguardless of their position. Check your board mapping
@@ -106,6 +136,226 @@ mraa_result_t mraa_aio_set_bit(mraa_aio_context dev, int bits);
  */
 int mraa_aio_get_bit(mraa_aio_context dev);
 
+/**
+ * Scale raw samples, as mraa_aio_group_read() and the stream functions
+ * return them, to the bit width of the context like mraa_aio_read() does.
+ * The scaling is worked out when the context is set up and on
+ * mraa_aio_set_bit(), so this only shifts. On boards that replace AIO
+ * reads the samples are scaled already and are copied as they are.
+ *
+ * @param dev The AIO context the samples were taken on
+ * @param raw raw samples
+ * @param values filled with count scaled samples, may be raw
+ * @param count number of samples
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_scale(mraa_aio_context dev, const int32_t* raw, int32_t* values, size_t count);
+
+/**
+ * Scale raw samples to normalized floats (0.0f-1.0f) like
+ * mraa_aio_read_float() does.
+ *
+ * @param dev The AIO context the samples were taken on
+ * @param raw raw samples
+ * @param values filled with count normalized samples
+ * @param count number of samples
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_scale_float(mraa_aio_context dev, const int32_t* raw, float* values, size_t count);
+
+/**
+ * Set up the processing of mraa_aio_read_filtered() and
+ * mraa_aio_filter_samples(). Every oversampling raw samples are averaged
+ * into one, which then goes through the filter. The arithmetic is fixed
+ * point and keeps 8 fraction bits, so averaging gains resolution that
+ * mraa_aio_read_filtered_float() returns. mraa_aio_read() and
+ * mraa_aio_read_float() are not affected and keep returning raw reads.
+ * Setting a filter resets its state, oversampling 1 with
+ * MRAA_AIO_FILTER_NONE turns processing off.
+ *
+ * @param dev The AIO context
+ * @param oversampling raw samples per output sample, 1 to
+ * MRAA_AIO_FILTER_MAX_OVERSAMPLING
+ * @param type filter
+ * @param length window of the moving average and the median, period of
+ * the EMA, in output samples; 1 to MRAA_AIO_FILTER_MAX_LENGTH
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_set_filter(mraa_aio_context dev, unsigned int oversampling, mraa_aio_filter_t type, unsigned int length);
+
+/**
+ * Forget the samples the filter has seen, its set up stays
+ *
+ * @param dev The AIO context
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_filter_reset(mraa_aio_context dev);
+
+/**
+ * Take oversampling raw reads and return the next filtered value, scaled
+ * like mraa_aio_read(). Without a filter this is mraa_aio_read().
+ *
+ * @param dev The AIO context
+ * @return The filtered input voltage or -1 for error
+ */
+int mraa_aio_read_filtered(mraa_aio_context dev);
+
+/**
+ * Like mraa_aio_read_filtered() but return a normalized float
+ * (0.0f-1.0f) like mraa_aio_read_float(), with the resolution averaging
+ * gained. Without a filter this is mraa_aio_read_float().
+ *
+ * @param dev The AIO context
+ * @return The filtered input voltage as a normalized float, -1.0f for
+ * error
+ */
+float mraa_aio_read_filtered_float(mraa_aio_context dev);
+
+/**
+ * Run raw samples, such as from mraa_aio_group_read() or
+ * mraa_aio_stream_read(), through the processing of the context. Every
+ * oversampling of them give one filtered raw sample, which
+ * mraa_aio_scale() and mraa_aio_scale_float() convert. Samples left
+ * over are kept toward the next call, and the filter state is shared
+ * with mraa_aio_read_filtered(). Without a filter the samples are copied.
+ *
+ * @param dev The AIO context
+ * @param raw raw samples, left as they are
+ * @param filtered filled with the filtered samples, may be raw
+ * @param count number of raw samples
+ * @return number of filtered samples or -1 for error
+ */
+int mraa_aio_filter_samples(mraa_aio_context dev, const int32_t* raw, int32_t* filtered, int count);
+
+/**
+ * Group AIO channels to read them all with one call. Where the ADC has an
+ * IIO buffer and a sysfs trigger can be attached to it, every read takes
+ * one triggered scan of all channels. Otherwise the channels are read
+ * one after the other with a single pread() each. While a group uses the
+ * IIO buffer, mraa_aio_read() on its channels may fail as the driver
+ * refuses direct reads.
+ *
+ * @param channels AIO contexts, which must stay open while the group is used
+ * @param count number of channels
+ * @return group context or NULL
+ */
+mraa_aio_group_context mraa_aio_group_init(mraa_aio_context* channels, int count);
+
+/**
+ * Read all channels of a group. The samples are the raw ADC values as
+ * the driver reports them, without the shift to the bit width set by
+ * mraa_aio_set_bit(); mraa_aio_scale() applies it. On boards that
+ * replace AIO reads each channel is read with mraa_aio_read() instead.
+ *
+ * @param group AIO group context
+ * @param samples filled with one sample per channel, in the order the
+ * channels were given
+ * @param timestamp if not NULL, filled with the CLOCK_MONOTONIC time in
+ * nanoseconds the read started at
+ * @return number of samples or -1 for error
+ */
+int mraa_aio_group_read(mraa_aio_group_context group, int32_t* samples, uint64_t* timestamp);
+
+/**
+ * Get the number of channels of a group
+ *
+ * @param group AIO group context
+ * @return number of channels or -1 for error
+ */
+int mraa_aio_group_get_count(mraa_aio_group_context group);
+
+/**
+ * Tell whether a group reads through the IIO buffer
+ *
+ * @param group AIO group context
+ * @return true if scans are taken from the IIO buffer, false if the
+ * channels are read one by one
+ */
+mraa_boolean_t mraa_aio_group_is_buffered(mraa_aio_group_context group);
+
+/**
+ * Close a group, the AIO contexts stay open
+ *
+ * @param group AIO group context
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_group_close(mraa_aio_group_context group);
+
+/**
+ * Sample a channel continuously at a fixed rate into a ring. Where the ADC
+ * has an IIO buffer, an hrtimer trigger created through configfs takes
+ * the scans in the kernel; without one a thread fires a sysfs trigger at
+ * the rate, and without a buffer at all the thread reads the channel at
+ * the rate. While the capture runs, mraa_aio_read() on the channel may
+ * fail as the driver refuses direct reads. Samples are raw, as with
+ * mraa_aio_group_read().
+ *
+ * @param dev The AIO context
+ * @param rate_hz samples per second, 1 to 1000000000
+ * @param ring where the samples are kept until mraa_aio_stream_read(),
+ * must stay valid until the capture is stopped
+ * @param ring_size number of samples the ring holds
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_start(mraa_aio_context dev, unsigned int rate_hz, int32_t* ring, size_t ring_size);
+
+/**
+ * Sample a channel continuously at a fixed rate, handing the samples to a
+ * callback as in mraa_aio_stream_start(). The callback runs in the
+ * capture thread and gets one or more consecutive samples with the
+ * CLOCK_MONOTONIC time in nanoseconds of the first one; the ones after
+ * it follow a period apart.
+ *
+ * @param dev The AIO context
+ * @param rate_hz samples per second, 1 to 1000000000
+ * @param fptr function called with new samples
+ * @param args passed to fptr
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_start_callback(mraa_aio_context dev,
+                                             unsigned int rate_hz,
+                                             void (*fptr)(mraa_aio_context dev, const int32_t* samples, int count, uint64_t timestamp, void* args),
+                                             void* args);
+
+/**
+ * Take samples out of the ring of a capture, oldest first
+ *
+ * @param dev The AIO context
+ * @param samples filled with up to max samples
+ * @param max most samples to take
+ * @param timeout_ms how long to wait for a sample when the ring is empty,
+ * 0 not to wait, -1 to wait for ever
+ * @return number of samples, 0 on timeout or -1 for error
+ */
+int mraa_aio_stream_read(mraa_aio_context dev, int32_t* samples, int max, int timeout_ms);
+
+/**
+ * Get the counters of a capture
+ *
+ * @param dev The AIO context
+ * @param stats filled with the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_get_stats(mraa_aio_context dev, mraa_aio_stream_stats_t* stats);
+
+/**
+ * Tell whether a capture takes its samples from the IIO buffer
+ *
+ * @param dev The AIO context
+ * @return true if the samples come from the IIO buffer, false if the
+ * channel is read at the rate
+ */
+mraa_boolean_t mraa_aio_stream_is_buffered(mraa_aio_context dev);
+
+/**
+ * Stop a capture, mraa_aio_close() does so too. Samples still in the ring
+ * stay there but can't be read with mraa_aio_stream_read() any more.
+ *
+ * @param dev The AIO context
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_stream_stop(mraa_aio_context dev);
+
 #ifdef __cplusplus
 }
 #endif
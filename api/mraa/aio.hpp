@@ -130,6 +130,51 @@ class Aio
     {
         return mraa_aio_get_bit(m_aio);
     }
+    /**
+     * Average oversampling raw reads into each value of readFiltered()
+     * and run them through a filter, see mraa_aio_set_filter()
+     *
+     * @param oversampling raw reads per value
+     * @param type filter
+     * @param length window or period of the filter, in values
+     * @return mraa::Result type
+     */
+    Result
+    setFilter(unsigned int oversampling, AioFilter type = AIO_FILTER_NONE, unsigned int length = 1)
+    {
+        return (Result) mraa_aio_set_filter(m_aio, oversampling, (mraa_aio_filter_t) type, length);
+    }
+    /**
+     * Read the next filtered value, scaled like read()
+     *
+     * @throws std::invalid_argument in case of error
+     * @returns The filtered input voltage
+     */
+    unsigned int
+    readFiltered()
+    {
+        int x = mraa_aio_read_filtered(m_aio);
+        if (x == -1) {
+            throw std::invalid_argument("Unknown error in Aio::readFiltered()");
+        }
+        return (unsigned int) x;
+    }
+    /**
+     * Read the next filtered value as a normalized float, with the
+     * resolution averaging gained
+     *
+     * @throws std::invalid_argument in case of error
+     * @returns The filtered input voltage as a normalized float (0.0f-1.0f)
+     */
+    float
+    readFilteredFloat()
+    {
+        float x = mraa_aio_read_filtered_float(m_aio);
+        if (x == -1.0f) {
+            throw std::invalid_argument("Unknown error in Aio::readFilteredFloat()");
+        }
+        return x;
+    }
 
   private:
     mraa_aio_context m_aio;
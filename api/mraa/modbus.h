@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @file
+ * @brief Modbus RTU master module
+ *
+ * This module is a Modbus RTU master on top of a MRAA UART context. Frames
+ * are checked with a table driven CRC16, and the 3.5 character silent
+ * interval that separates frames is derived from the baud rate (fixed at
+ * 1750us above 19200 baud, as the specification asks).
+ *
+ * Besides single requests, register reads can be put on a poll schedule
+ * that spans any number of slaves. Each call to mraa_modbus_poll() sends
+ * all reads that are due, merging reads of adjacent or overlapping
+ * registers of the same slave and function into one request, and sends
+ * the requests back to back with just the silent interval in between.
+ * Request counts, errors and response latency are kept per slave.
+ *
+ * On RS-485 lines combine with mraa_uart_set_rs485() on the uart context.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common.h"
+#include "uart.h"
+
+/** Number of slave addresses, 0 is broadcast */
+#define MRAA_MODBUS_MAX_SLAVES 248
+
+/** Most registers a single read request may ask for */
+#define MRAA_MODBUS_MAX_READ_REGISTERS 125
+
+/** Most registers a single write request may carry */
+#define MRAA_MODBUS_MAX_WRITE_REGISTERS 123
+
+/** Largest RTU frame, address + PDU + CRC */
+#define MRAA_MODBUS_MAX_FRAME 256
+
+/**
+ * Modbus function codes
+ */
+typedef enum {
+    MRAA_MODBUS_READ_HOLDING_REGISTERS = 0x03, /**< read holding registers */
+    MRAA_MODBUS_READ_INPUT_REGISTERS = 0x04,   /**< read input registers */
+    MRAA_MODBUS_WRITE_SINGLE_REGISTER = 0x06,  /**< write one holding register */
+    MRAA_MODBUS_WRITE_MULTIPLE_REGISTERS = 0x10 /**< write consecutive holding registers */
+} mraa_modbus_function_t;
+
+/**
+ * Per slave counters
+ */
+typedef struct {
+    uint64_t requests;         /**< requests sent */
+    uint64_t responses;        /**< valid responses, exceptions included */
+    uint64_t timeouts;         /**< requests without a complete response in time */
+    uint64_t crc_errors;       /**< responses with a bad CRC */
+    uint64_t frame_errors;     /**< responses cut short, too long or from the wrong slave or function */
+    uint64_t io_errors;        /**< responses the uart failed to read */
+    uint64_t exceptions;       /**< exception responses */
+    uint64_t latency_total_us; /**< sum of request end to response end times */
+    uint64_t latency_min_us;   /**< quickest response */
+    uint64_t latency_max_us;   /**< slowest response */
+    uint8_t last_exception;    /**< exception code of the last exception response */
+} mraa_modbus_slave_stats_t;
+
+/**
+ * A register read on the poll schedule
+ */
+typedef struct {
+    uint8_t slave;                   /**< slave address */
+    mraa_modbus_function_t function; /**< MRAA_MODBUS_READ_HOLDING_REGISTERS or _INPUT_ */
+    uint16_t addr;                   /**< first register */
+    uint16_t count;                  /**< number of registers */
+    uint16_t* dest;                  /**< updated with the values on every successful poll */
+    unsigned int period_ms;          /**< poll interval */
+    uint64_t next_due_ms;            /**< when the read is due next */
+    mraa_result_t last_result;       /**< outcome of the last poll */
+    mraa_boolean_t active;           /**< slot is in use */
+} mraa_modbus_poll_t;
+
+/**
+ * Modbus RTU master context
+ */
+typedef struct _mraa_modbus {
+    /** Uart Context */
+    mraa_uart_context uart;
+    /** Line speed */
+    unsigned int baud;
+    /** Time of one 11 bit character in microseconds */
+    unsigned int char_us;
+    /** Silent interval between frames in microseconds */
+    unsigned int gap_us;
+    /** Response timeout in milliseconds */
+    unsigned int timeout_ms;
+    /** When the line last went quiet, monotonic microseconds */
+    uint64_t idle_since_us;
+    /** Poll schedule */
+    mraa_modbus_poll_t* polls;
+    /** Slots in polls */
+    int poll_capacity;
+    /** Per slave counters, indexed by slave address */
+    mraa_modbus_slave_stats_t stats[MRAA_MODBUS_MAX_SLAVES];
+} *mraa_modbus_context;
+
+/**
+ * Compute the Modbus CRC16 of a buffer
+ *
+ * @param data buffer
+ * @param length number of bytes
+ * @return CRC, sent low byte first
+ */
+uint16_t mraa_modbus_crc16(const uint8_t* data, size_t length);
+
+/**
+ * Initialise a Modbus RTU master on a board UART. The port is set to 8 data
+ * bits, the given parity and 2 stop bits without parity, 1 with.
+ *
+ * @param uart the index of the uart set to use
+ * @param baud line speed
+ * @param parity parity, Modbus defaults to even
+ * @return modbus context or NULL
+ */
+mraa_modbus_context mraa_modbus_init(int uart, unsigned int baud, mraa_uart_parity_t parity);
+
+/**
+ * Initialise a Modbus RTU master on a raw UART. No board setup.
+ *
+ * @param path for example "/dev/ttyS0"
+ * @param baud line speed
+ * @param parity parity, Modbus defaults to even
+ * @return modbus context or NULL
+ */
+mraa_modbus_context mraa_modbus_init_raw(const char* path, unsigned int baud, mraa_uart_parity_t parity);
+
+/**
+ * Destroy a modbus context, also closes the UART
+ *
+ * @param dev modbus context
+ * @return Result of operation
+ */
+mraa_result_t mraa_modbus_stop(mraa_modbus_context dev);
+
+/**
+ * Set how long to wait for a response after a request has been sent
+ *
+ * @param dev modbus context
+ * @param timeout_ms milliseconds, default 100
+ * @return Result of operation
+ */
+mraa_result_t mraa_modbus_set_timeout(mraa_modbus_context dev, unsigned int timeout_ms);
+
+/**
+ * Send a request and receive the response. The address and CRC are added
+ * and checked here, only the PDU (function code and data) is passed.
+ * Requests to the broadcast address 0 don't wait for a response.
+ *
+ * @param dev modbus context
+ * @param slave slave address
+ * @param pdu request function code and data
+ * @param pdu_length bytes in pdu
+ * @param response buffer for the response PDU, MRAA_MODBUS_MAX_FRAME bytes
+ * @param response_length set to the bytes in response
+ * @return MRAA_SUCCESS, MRAA_ERROR_NO_DATA_AVAILABLE on timeout,
+ * MRAA_ERROR_INVALID_RESOURCE for a broken response or
+ * MRAA_ERROR_UNSPECIFIED for an exception response
+ */
+mraa_result_t mraa_modbus_request(mraa_modbus_context dev,
+                                  uint8_t slave,
+                                  const uint8_t* pdu,
+                                  size_t pdu_length,
+                                  uint8_t* response,
+                                  size_t* response_length);
+
+/**
+ * Read holding or input registers
+ *
+ * @param dev modbus context
+ * @param slave slave address
+ * @param function MRAA_MODBUS_READ_HOLDING_REGISTERS or MRAA_MODBUS_READ_INPUT_REGISTERS
+ * @param addr first register
+ * @param count number of registers, up to MRAA_MODBUS_MAX_READ_REGISTERS
+ * @param dest buffer of count registers
+ * @return Result of operation, see mraa_modbus_request()
+ */
+mraa_result_t mraa_modbus_read_registers(mraa_modbus_context dev,
+                                         uint8_t slave,
+                                         mraa_modbus_function_t function,
+                                         uint16_t addr,
+                                         uint16_t count,
+                                         uint16_t* dest);
+
+/**
+ * Write a single holding register
+ *
+ * @param dev modbus context
+ * @param slave slave address
+ * @param addr register
+ * @param value value to write
+ * @return Result of operation, see mraa_modbus_request()
+ */
+mraa_result_t mraa_modbus_write_register(mraa_modbus_context dev, uint8_t slave, uint16_t addr, uint16_t value);
+
+/**
+ * Write consecutive holding registers
+ *
+ * @param dev modbus context
+ * @param slave slave address
+ * @param addr first register
+ * @param count number of registers, up to MRAA_MODBUS_MAX_WRITE_REGISTERS
+ * @param values values to write
+ * @return Result of operation, see mraa_modbus_request()
+ */
+mraa_result_t mraa_modbus_write_registers(mraa_modbus_context dev,
+                                          uint8_t slave,
+                                          uint16_t addr,
+                                          uint16_t count,
+                                          const uint16_t* values);
+
+/**
+ * Put a register read on the poll schedule. It is first due right away.
+ *
+ * @param dev modbus context
+ * @param slave slave address
+ * @param function MRAA_MODBUS_READ_HOLDING_REGISTERS or MRAA_MODBUS_READ_INPUT_REGISTERS
+ * @param addr first register
+ * @param count number of registers, up to MRAA_MODBUS_MAX_READ_REGISTERS
+ * @param dest buffer of count registers, updated by mraa_modbus_poll()
+ * @param period_ms poll interval
+ * @return poll id or -1 for error
+ */
+int mraa_modbus_poll_add(mraa_modbus_context dev,
+                         uint8_t slave,
+                         mraa_modbus_function_t function,
+                         uint16_t addr,
+                         uint16_t count,
+                         uint16_t* dest,
+                         unsigned int period_ms);
+
+/**
+ * Take a read off the poll schedule
+ *
+ * @param dev modbus context
+ * @param id poll id from mraa_modbus_poll_add()
+ * @return Result of operation
+ */
+mraa_result_t mraa_modbus_poll_remove(mraa_modbus_context dev, int id);
+
+/**
+ * Get the outcome of the last poll of a scheduled read
+ *
+ * @param dev modbus context
+ * @param id poll id from mraa_modbus_poll_add()
+ * @return result of the last poll, MRAA_ERROR_NO_DATA_AVAILABLE if not polled yet
+ */
+mraa_result_t mraa_modbus_poll_result(mraa_modbus_context dev, int id);
+
+/**
+ * Send every scheduled read that is due, merged per slave and function
+ *
+ * @param dev modbus context
+ * @return number of requests sent or -1 for error
+ */
+int mraa_modbus_poll(mraa_modbus_context dev);
+
+/**
+ * Get the time until the next scheduled read is due
+ *
+ * @param dev modbus context
+ * @return milliseconds, 0 if one is due, -1 if the schedule is empty
+ */
+int mraa_modbus_poll_next_ms(mraa_modbus_context dev);
+
+/**
+ * Get the counters of a slave
+ *
+ * @param dev modbus context
+ * @param slave slave address
+ * @param stats filled with the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_modbus_get_stats(mraa_modbus_context dev, uint8_t slave, mraa_modbus_slave_stats_t* stats);
+
+/**
+ * Zero the counters of all slaves
+ *
+ * @param dev modbus context
+ * @return Result of operation
+ */
+mraa_result_t mraa_modbus_reset_stats(mraa_modbus_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -63,6 +63,42 @@ typedef enum {
                            output data (change) on falling edge */
 } mraa_spi_mode_t;
 
+/**
+ * MRAA SPI bus widths, the number of data lines used per direction
+ */
+typedef enum {
+    MRAA_SPI_BUSWIDTH_SINGLE = 1, /**< Standard SPI, one line per direction */
+    MRAA_SPI_BUSWIDTH_DUAL = 2,   /**< Dual I/O, two lines shared by both directions */
+    MRAA_SPI_BUSWIDTH_QUAD = 4    /**< Quad I/O, four lines shared by both directions */
+} mraa_spi_buswidth_t;
+
+/**
+ * A single segment of a multi segment SPI message. All segments of a
+ * message are sent with chip select held active unless cs_change is set.
+ */
+typedef struct {
+    uint8_t* txbuf;                /**< data to send, may be NULL to clock out zeros */
+    uint8_t* rxbuf;                /**< buffer to receive data into, may be NULL */
+    int length;                    /**< length of the segment in bytes */
+    mraa_spi_buswidth_t tx_width;  /**< bus width used to send, 0 is single */
+    mraa_spi_buswidth_t rx_width;  /**< bus width used to receive, 0 is single */
+    mraa_boolean_t cs_change;      /**< deselect the device after this segment */
+} mraa_spi_segment_t;
+
+/**
+ * Transfer counters of a SPI context, see mraa_spi_get_stats()
+ */
+typedef struct {
+    uint64_t transfers;      /**< completed transfers, a multi segment message counts once */
+    uint64_t errors;         /**< failed transfers */
+    uint64_t bytes;          /**< bytes clocked over the bus by completed transfers */
+    uint64_t busy_ns;        /**< cumulative time spent in the driver for completed transfers */
+    uint64_t max_latency_ns; /**< longest single transfer */
+    uint64_t wire_ns;        /**< time the transferred bits take on the wire at the set clock */
+    uint64_t elapsed_ns;     /**< time since the counters were last reset */
+    float utilisation;       /**< estimated share of elapsed time the bus was busy for this context */
+} mraa_spi_stats_t;
+
 /**
  * Opaque pointer definition to the internal struct _spi
  */
@@ -94,6 +130,29 @@ mraa_spi_context mraa_spi_init_raw(unsigned int bus, unsigned int cs);
  */
 mraa_result_t mraa_spi_mode(mraa_spi_context dev, mraa_spi_mode_t mode);
 
+/**
+ * Request dual or quad I/O from the controller. Widths the controller or
+ * the device tree reject are stepped down towards single, so the call only
+ * fails if not even single width could be set. Use mraa_spi_get_buswidth()
+ * to find out what was granted.
+ *
+ * @param dev The Spi context
+ * @param tx widest bus width to use for sending
+ * @param rx widest bus width to use for receiving
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_buswidth(mraa_spi_context dev, mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx);
+
+/**
+ * Get the bus widths granted by the controller
+ *
+ * @param dev The Spi context
+ * @param tx set to the widest bus width available for sending
+ * @param rx set to the widest bus width available for receiving
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_get_buswidth(mraa_spi_context dev, mraa_spi_buswidth_t* tx, mraa_spi_buswidth_t* rx);
+
 /**
  * Set the SPI device operating clock frequency.
  *
@@ -103,6 +162,16 @@ mraa_result_t mraa_spi_mode(mraa_spi_context dev, mraa_spi_mode_t mode);
  */
 mraa_result_t mraa_spi_frequency(mraa_spi_context dev, int hz);
 
+/**
+ * Get the SPI clock frequency in use. For a bus bit-banged over gpios this
+ * is the rate measured over the last transfer, which can be well below the
+ * requested one when the gpios can't toggle fast enough.
+ *
+ * @param dev the Spi context
+ * @return frequency in hz or -1 for error
+ */
+int mraa_spi_get_frequency(mraa_spi_context dev);
+
 /**
  * Write Single Byte to the SPI device.
  *
@@ -168,7 +237,36 @@ mraa_result_t mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t
 mraa_result_t mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length);
 
 /**
- * Change the SPI lsb mode
+ * Transfer Buffer of uint32 to the SPI device. Both send and recv buffers
+ * are passed in. Meant for bits per word settings of 17 to 32, words are
+ * in cpu native byte order as with spidev.
+ *
+ * @param dev The Spi context
+ * @param data to send
+ * @param rxbuf buffer to recv data back, may be NULL
+ * @param length elements (in bytes) within buffer, Max 4096
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_transfer_buf_word32(mraa_spi_context dev, uint32_t* data, uint32_t* rxbuf, int length);
+
+/**
+ * Transfer a message made of several segments in a single transaction,
+ * chip select stays asserted in between. Each segment may use its own bus
+ * width, e.g. a single width command followed by a quad width read. Segment
+ * widths wider than granted by mraa_spi_buswidth() are narrowed to what the
+ * controller supports.
+ *
+ * @param dev The Spi context
+ * @param segments array of segments to transfer in order
+ * @param count number of segments
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_transfer_segments(mraa_spi_context dev, mraa_spi_segment_t* segments, int count);
+
+/**
+ * Change the SPI lsb mode. If the controller cannot send lsb first the bit
+ * order of every word is reversed in software instead, transparently to the
+ * transfer functions.
  *
  * @param dev The Spi context
  * @param lsb Use least significant bit transmission. 0 for msbi
@@ -185,6 +283,26 @@ mraa_result_t mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb);
  */
 mraa_result_t mraa_spi_bit_per_word(mraa_spi_context dev, unsigned int bits);
 
+/**
+ * Take a snapshot of the transfer counters of a context. Every transfer
+ * function is timed, wire time and utilisation are estimated from the bit
+ * count and the clock set with mraa_spi_frequency(). Contexts sharing a bus
+ * can be compared by utilisation to find the one keeping it busy.
+ *
+ * @param dev The Spi context
+ * @param stats filled with the counters accumulated since the last reset
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_get_stats(mraa_spi_context dev, mraa_spi_stats_t* stats);
+
+/**
+ * Zero the transfer counters of a context and restart the elapsed time
+ *
+ * @param dev The Spi context
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_reset_stats(mraa_spi_context dev);
+
 /**
  * De-inits an mraa_spi_context device
  *
@@ -47,6 +47,15 @@ typedef enum {
                       output data (change) on falling edge */
 } Spi_Mode;
 
+/**
+ * MRAA SPI bus widths
+ */
+typedef enum {
+    SPI_BUSWIDTH_SINGLE = 1, /**< Standard SPI, one line per direction */
+    SPI_BUSWIDTH_DUAL = 2,   /**< Dual I/O, two lines shared by both directions */
+    SPI_BUSWIDTH_QUAD = 4    /**< Quad I/O, four lines shared by both directions */
+} Spi_BusWidth;
+
 
 /**
 * @brief API to Serial Peripheral Interface
@@ -121,6 +130,20 @@ class Spi
         return (Result) mraa_spi_mode(m_spi, (mraa_spi_mode_t) mode);
     }
 
+    /**
+     * Request dual or quad I/O, widths the controller rejects are stepped
+     * down towards single
+     *
+     * @param tx widest bus width to use for sending
+     * @param rx widest bus width to use for receiving
+     * @return Result of operation
+     */
+    Result
+    busWidth(Spi_BusWidth tx, Spi_BusWidth rx)
+    {
+        return (Result) mraa_spi_buswidth(m_spi, (mraa_spi_buswidth_t) tx, (mraa_spi_buswidth_t) rx);
+    }
+
     /**
      * Set the SPI device operating clock frequency
      *
@@ -133,6 +156,18 @@ class Spi
         return (Result) mraa_spi_frequency(m_spi, hz);
     }
 
+    /**
+     * Get the SPI clock frequency in use, for a bit-banged bus the rate
+     * achieved over the last transfer
+     *
+     * @return frequency in hz or -1 for error
+     */
+    int
+    getFrequency()
+    {
+        return mraa_spi_get_frequency(m_spi);
+    }
+
     /**
      * Write single byte to the SPI device
      *
@@ -219,6 +254,35 @@ class Spi
     {
         return (Result) mraa_spi_transfer_buf_word(m_spi, txBuf, rxBuf, length);
     }
+
+    /**
+     * Transfer 32 bit words to and from SPI device Receive pointer may be
+     * null if return data is not needed.
+     *
+     * @param txBuf buffer to send
+     * @param rxBuf buffer to optionally receive data from spi device
+     * @param length size of buffer (in bytes) to send
+     * @return Result of operation
+     */
+    Result
+    transfer_word32(uint32_t* txBuf, uint32_t* rxBuf, int length)
+    {
+        return (Result) mraa_spi_transfer_buf_word32(m_spi, txBuf, rxBuf, length);
+    }
+
+    /**
+     * Transfer several segments in one transaction with chip select held,
+     * each segment may use its own bus width
+     *
+     * @param segments array of segments to transfer in order
+     * @param count number of segments
+     * @return Result of operation
+     */
+    Result
+    transferSegments(mraa_spi_segment_t* segments, int count)
+    {
+        return (Result) mraa_spi_transfer_segments(m_spi, segments, count);
+    }
 #endif
 
     /**
@@ -245,6 +309,32 @@ class Spi
         return (Result) mraa_spi_bit_per_word(m_spi, bits);
     }
 
+    /**
+     * Snapshot of the transfer counters since the last reset
+     *
+     * @return transfer counters
+     */
+    mraa_spi_stats_t
+    getStats()
+    {
+        mraa_spi_stats_t stats;
+        if (mraa_spi_get_stats(m_spi, &stats) != MRAA_SUCCESS) {
+            throw std::runtime_error("Error reading SPI statistics");
+        }
+        return stats;
+    }
+
+    /**
+     * Zero the transfer counters
+     *
+     * @return Result of operation
+     */
+    Result
+    resetStats()
+    {
+        return (Result) mraa_spi_reset_stats(m_spi);
+    }
+
   private:
     mraa_spi_context m_spi;
 };
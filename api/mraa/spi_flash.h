@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @file
+ * @brief SPI NOR flash module
+ *
+ * This module drives JEDEC compliant serial NOR flash devices on top of a
+ * MRAA SPI context. On init the device is identified with the JEDEC ID
+ * command and, where the part implements it, its Serial Flash Discoverable
+ * Parameters (SFDP, JESD216) table is parsed for size, page size, erase
+ * opcode and the fastest read mode the SPI controller can do (1-1-4 quad
+ * output, 1-1-2 dual output or single width fast read).
+ *
+ * Reads are issued as large chunked transfers sized to the spidev buffer,
+ * writes enable and program each page in a single SPI message and then
+ * poll the status register, waiting the typical page program time given by
+ * SFDP before the first poll. See tools/mraa-spi-flash.c for an example.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common.h"
+#include "spi.h"
+
+/** Size of the JEDEC manufacturer and device id */
+#define MRAA_SPI_FLASH_JEDEC_ID_SIZE 3
+
+/**
+ * SPI NOR flash command bytes
+ */
+typedef enum {
+    MRAA_SPI_FLASH_CMD_WRITE_STATUS = 0x01,    /**< write status register */
+    MRAA_SPI_FLASH_CMD_PAGE_PROGRAM = 0x02,    /**< program up to a page */
+    MRAA_SPI_FLASH_CMD_READ = 0x03,            /**< read, no dummy cycles */
+    MRAA_SPI_FLASH_CMD_WRITE_DISABLE = 0x04,   /**< clear write enable latch */
+    MRAA_SPI_FLASH_CMD_READ_STATUS = 0x05,     /**< read status register */
+    MRAA_SPI_FLASH_CMD_WRITE_ENABLE = 0x06,    /**< set write enable latch */
+    MRAA_SPI_FLASH_CMD_FAST_READ = 0x0b,       /**< read with dummy cycles */
+    MRAA_SPI_FLASH_CMD_SECTOR_ERASE = 0x20,    /**< erase 4KiB sector */
+    MRAA_SPI_FLASH_CMD_DUAL_READ = 0x3b,       /**< 1-1-2 fast read */
+    MRAA_SPI_FLASH_CMD_READ_SFDP = 0x5a,       /**< read SFDP tables */
+    MRAA_SPI_FLASH_CMD_QUAD_READ = 0x6b,       /**< 1-1-4 fast read */
+    MRAA_SPI_FLASH_CMD_READ_ID = 0x9f,         /**< read JEDEC id */
+    MRAA_SPI_FLASH_CMD_ENTER_4BYTE = 0xb7,     /**< enter 4 byte address mode */
+    MRAA_SPI_FLASH_CMD_CHIP_ERASE = 0xc7,      /**< erase whole chip */
+    MRAA_SPI_FLASH_CMD_BLOCK_ERASE = 0xd8      /**< erase 64KiB block */
+} mraa_spi_flash_cmd_t;
+
+/**
+ * SPI flash context, describes the device found on the bus
+ */
+typedef struct _mraa_spi_flash {
+    /** Spi Context */
+    mraa_spi_context spi;
+    /** JEDEC manufacturer id followed by the two device id bytes */
+    uint8_t jedec_id[MRAA_SPI_FLASH_JEDEC_ID_SIZE];
+    /** true if the size and modes below came from the SFDP table */
+    mraa_boolean_t sfdp;
+    /** Device size in bytes */
+    uint32_t size;
+    /** Program page size in bytes */
+    uint32_t page_size;
+    /** Size in bytes erased by erase_opcode, 0 if only chip erase is supported */
+    uint32_t erase_size;
+    /** Opcode erasing erase_size bytes */
+    uint8_t erase_opcode;
+    /** Opcode used for reads */
+    uint8_t read_opcode;
+    /** Dummy bytes following the address of a read */
+    uint8_t read_dummy;
+    /** Bus width of the data phase of a read */
+    mraa_spi_buswidth_t read_width;
+    /** Number of address bytes, 3 or 4 */
+    uint8_t addr_bytes;
+    /** Typical page program time in microseconds, 0 if unknown */
+    unsigned int program_time_us;
+    /** Largest single SPI message in bytes, from the spidev bufsiz */
+    unsigned int max_transfer;
+} *mraa_spi_flash_context;
+
+/**
+ * Initialise a spi_flash_context, uses SPI board mapping
+ *
+ * @param bus Bus to use, as listed in platform definition, normally 0
+ * @return spi_flash context or NULL if no flash was identified
+ */
+mraa_spi_flash_context mraa_spi_flash_init(int bus);
+
+/**
+ * Initialise a raw spi_flash_context. No board setup.
+ *
+ * @param bus Bus to use as listed by spidev
+ * @param cs Chip select to use as listed in spidev
+ * @return spi_flash context or NULL if no flash was identified
+ */
+mraa_spi_flash_context mraa_spi_flash_init_raw(unsigned int bus, unsigned int cs);
+
+/**
+ * Destroy a mraa_spi_flash_context, also closes the SPI context
+ *
+ * @param dev spi_flash context
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_flash_stop(mraa_spi_flash_context dev);
+
+/**
+ * Read the JEDEC manufacturer and device id
+ *
+ * @param dev spi_flash context
+ * @param id buffer of MRAA_SPI_FLASH_JEDEC_ID_SIZE bytes
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_flash_read_id(mraa_spi_flash_context dev, uint8_t* id);
+
+/**
+ * Read raw bytes from the SFDP address space
+ *
+ * @param dev spi_flash context
+ * @param addr SFDP address to start reading from
+ * @param data buffer to read into
+ * @param length number of bytes to read
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_flash_read_sfdp(mraa_spi_flash_context dev, uint32_t addr, uint8_t* data, int length);
+
+/**
+ * Read the status register
+ *
+ * @param dev spi_flash context
+ * @return status register value or -1 for error
+ */
+int mraa_spi_flash_read_status(mraa_spi_flash_context dev);
+
+/**
+ * Wait until the device finished its current program or erase operation
+ *
+ * @param dev spi_flash context
+ * @param timeout_ms milliseconds to wait at most
+ * @return MRAA_SUCCESS once ready, MRAA_ERROR_UNSPECIFIED on timeout
+ */
+mraa_result_t mraa_spi_flash_wait_ready(mraa_spi_flash_context dev, unsigned int timeout_ms);
+
+/**
+ * Read from the flash using the fastest read mode available, in chunks as
+ * large as the SPI driver accepts
+ *
+ * @param dev spi_flash context
+ * @param addr flash address to start reading from
+ * @param data buffer to read into
+ * @param length number of bytes to read
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_flash_read(mraa_spi_flash_context dev, uint32_t addr, uint8_t* data, uint32_t length);
+
+/**
+ * Program data to the flash. The range must have been erased before,
+ * writes may start and end anywhere and are split at page boundaries.
+ *
+ * @param dev spi_flash context
+ * @param addr flash address to start programming at
+ * @param data data to program
+ * @param length number of bytes to program
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_flash_write(mraa_spi_flash_context dev, uint32_t addr, const uint8_t* data, uint32_t length);
+
+/**
+ * Erase all erase units covering a range of the flash. addr and length
+ * must be multiples of erase_size.
+ *
+ * @param dev spi_flash context
+ * @param addr flash address to start erasing at
+ * @param length number of bytes to erase
+ * @return Result of operation, MRAA_ERROR_FEATURE_NOT_SUPPORTED if SFDP
+ * lists no erase type smaller than the chip
+ */
+mraa_result_t mraa_spi_flash_erase(mraa_spi_flash_context dev, uint32_t addr, uint32_t length);
+
+/**
+ * Erase the whole flash
+ *
+ * @param dev spi_flash context
+ * @return Result of operation
+ */
+mraa_result_t mraa_spi_flash_chip_erase(mraa_spi_flash_context dev);
+
+#ifdef __cplusplus
+}
+#endif
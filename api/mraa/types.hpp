@@ -258,4 +258,14 @@ typedef enum {
     UART_PARITY_SPACE = 4
 } UartParity;
 
+/**
+ * Enum representing the filters of Aio::setFilter()
+ */
+typedef enum {
+    AIO_FILTER_NONE = 0,           /**< decimate only */
+    AIO_FILTER_MOVING_AVERAGE = 1, /**< mean of the last values */
+    AIO_FILTER_EMA = 2,            /**< exponential moving average */
+    AIO_FILTER_MEDIAN = 3          /**< median of the last values */
+} AioFilter;
+
 }
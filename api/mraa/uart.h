@@ -44,12 +44,65 @@ extern "C" {
 #endif
 
 #include <stdio.h>
+#include <stdint.h>
+#include <sys/uio.h>
 
 #include "common.h"
 
 /** Mraa Uart Context */
 typedef struct _uart* mraa_uart_context;
 
+/**
+ * How RS-485 transceiver direction is switched, see mraa_uart_set_rs485()
+ */
+typedef enum {
+    MRAA_UART_RS485_OFF = 0,    /**< plain full duplex UART */
+    MRAA_UART_RS485_KERNEL = 1, /**< the serial driver drives RTS as DE */
+    MRAA_UART_RS485_GPIO = 2    /**< mraa drives a DE gpio around each write */
+} mraa_uart_rs485_mode_t;
+
+/**
+ * RS-485 half duplex configuration
+ */
+typedef struct {
+    mraa_boolean_t de_active_low; /**< DE is driven low while sending */
+    mraa_boolean_t rx_during_tx;  /**< keep receiving while sending, kernel mode only */
+    unsigned int delay_before_us; /**< DE asserted this long before the first bit */
+    unsigned int delay_after_us;  /**< DE held this long after the last bit */
+    int de_pin;                   /**< mraa pin for the gpio fallback, -1 for the platform's */
+} mraa_uart_rs485_config_t;
+
+/**
+ * Framing modes of the buffered frame reader, see mraa_uart_set_framing()
+ */
+typedef enum {
+    MRAA_UART_FRAME_DELIMITER = 0,     /**< frames end with a delimiter byte, e.g. '\n' */
+    MRAA_UART_FRAME_FIXED = 1,         /**< every frame has the same length */
+    MRAA_UART_FRAME_LENGTH_PREFIX = 2, /**< frames start with a 1, 2 or 4 byte payload length */
+    MRAA_UART_FRAME_SLIP = 3,          /**< RFC 1055 SLIP, frames end with 0xC0 */
+    MRAA_UART_FRAME_COBS = 4           /**< consistent overhead byte stuffing, frames end with 0x00 */
+} mraa_uart_frame_mode_t;
+
+/**
+ * Configuration of the buffered frame reader
+ */
+typedef struct {
+    mraa_uart_frame_mode_t mode; /**< how the byte stream is split into frames */
+    size_t buffer_size;          /**< receive buffer in bytes, 0 for 64KiB, bounds the frame size */
+    uint8_t delimiter;           /**< MRAA_UART_FRAME_DELIMITER: byte ending a frame */
+    size_t length;               /**< FIXED: frame length, LENGTH_PREFIX: prefix size */
+    mraa_boolean_t big_endian;   /**< LENGTH_PREFIX: byte order of the prefix */
+} mraa_uart_frame_config_t;
+
+/**
+ * A received frame. Points into the receive buffer of the context and is
+ * valid until the next mraa_uart_read_frame() or mraa_uart_set_framing().
+ */
+typedef struct {
+    const uint8_t* data; /**< payload, without delimiter, prefix or encoding */
+    size_t length;       /**< payload length in bytes */
+} mraa_uart_frame_t;
+
 /**
  * Initialise uart_context, uses board mapping
  *
@@ -68,7 +121,7 @@ mraa_uart_context mraa_uart_init_raw(const char* path);
 
 /**
  * Flush the outbound data.
- * Blocks until complete.
+ * Blocks until complete. Sends data held back by write coalescing first.
  *
  * @param dev The UART context
  * @return Result of operation
@@ -90,7 +143,8 @@ mraa_result_t mraa_uart_sendbreak(mraa_uart_context dev, int duration);
 /**
  * Set the baudrate.
  * Takes an int and will attempt to decide what baudrate  is
- * to be used on the UART hardware.
+ * to be used on the UART hardware. Where the kernel supports termios2
+ * any rate can be requested, otherwise only the standard B* rates.
  *
  * @param dev The UART context
  * @param baud unsigned int of baudrate i.e. 9600
@@ -98,6 +152,16 @@ mraa_result_t mraa_uart_sendbreak(mraa_uart_context dev, int duration);
  */
 mraa_result_t mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud);
 
+/**
+ * Get the baudrate set by the last mraa_uart_set_baudrate(). With termios2
+ * this is the rate read back from the driver, which can differ from the
+ * one requested when the UART clock divisor can't hit it exactly.
+ *
+ * @param dev The UART context
+ * @return baudrate or 0 if unknown
+ */
+unsigned int mraa_uart_get_baudrate(mraa_uart_context dev);
+
 /**
  * Set the transfer mode
  * For example setting the mode to 8N1 would be
@@ -122,9 +186,20 @@ mraa_result_t mraa_uart_set_mode(mraa_uart_context dev, int bytesize, mraa_uart_
 mraa_result_t mraa_uart_set_flowcontrol(mraa_uart_context dev, mraa_boolean_t xonxoff, mraa_boolean_t rtscts);
 
 /**
- * Set the timeout for read and write operations
+ * Set the timeout for read and write operations, in milliseconds.
  * <= 0 will disable that timeout
  *
+ * A read waits at most the read timeout for the first byte and returns 0
+ * if none came. With an interchar timeout it then keeps reading until the
+ * buffer is full or the line has been quiet for that long, which detects
+ * the end of a reply without knowing its length. A write with a write
+ * timeout blocks until the driver has sent all of the data, like
+ * mraa_uart_flush(), or until the timeout passed. It returns the number of
+ * bytes the driver took, all of which it still sends; when some of them
+ * had not left the port by the timeout errno is set to ETIMEDOUT.
+ *
+ * This resets VMIN/VTIME to return every read as soon as data is there.
+ *
  * @param dev The UART context
  * @param read read timeout
  * @param write write timeout
@@ -133,6 +208,44 @@ mraa_result_t mraa_uart_set_flowcontrol(mraa_uart_context dev, mraa_boolean_t xo
  */
 mraa_result_t mraa_uart_set_timeout(mraa_uart_context dev, int read, int write, int interchar);
 
+/**
+ * Set the termios VMIN and VTIME of the port and hand read timing to the
+ * driver, replacing the read and interchar timeouts of
+ * mraa_uart_set_timeout(). A larger VMIN makes fewer, larger reads at the
+ * cost of latency. See termios(3) for how the two combine.
+ *
+ * @param dev The UART context
+ * @param vmin minimum number of bytes for a read to return, 0 - 255
+ * @param vtime timer in tenths of a second, 0 - 255
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_set_vmin_vtime(mraa_uart_context dev, unsigned int vmin, unsigned int vtime);
+
+/**
+ * Trade throughput for latency on the receive path. Sets ASYNC_LOW_LATENCY
+ * on the serial driver so received bytes are pushed to the tty layer right
+ * away instead of being batched, and on ports exposing rx_trig_bytes in
+ * sysfs (8250 style UARTs with a programmable FIFO) lowers the FIFO level
+ * that raises a receive interrupt. The driver rounds rx_trigger down to a
+ * level the UART supports. Disabling restores the old FIFO level, and
+ * stopping the context restores both settings as they were found.
+ *
+ * @param dev The UART context
+ * @param enable turn low latency mode on or off
+ * @param rx_trigger FIFO level in bytes, 0 to leave it alone
+ * @return MRAA_ERROR_FEATURE_NOT_SUPPORTED if the driver doesn't support
+ * TIOCSSERIAL, or rx_trigger was given and the port has no rx_trig_bytes
+ */
+mraa_result_t mraa_uart_set_low_latency(mraa_uart_context dev, mraa_boolean_t enable, unsigned int rx_trigger);
+
+/**
+ * Get the receive FIFO interrupt level of the port
+ *
+ * @param dev The UART context
+ * @return level in bytes, or -1 if the port doesn't expose it
+ */
+int mraa_uart_get_rx_trigger(mraa_uart_context dev);
+
 /**
  * Set the blocking state for write operations
  *
@@ -214,6 +327,34 @@ int mraa_uart_read(mraa_uart_context dev, char* buf, size_t length);
  */
 int mraa_uart_write(mraa_uart_context dev, const char* buf, size_t length);
 
+/**
+ * Write several buffers in one go, e.g. a header, a payload and a CRC
+ * built separately, without copying them together first. The buffers go
+ * out in a single writev() when no write timeout is set.
+ *
+ * @param dev uart context
+ * @param iov buffers to send in order
+ * @param iovcnt number of buffers, up to 1024
+ * @return the number of bytes written, or -1 if an error occurred
+ */
+int mraa_uart_writev(mraa_uart_context dev, const struct iovec* iov, int iovcnt);
+
+/**
+ * Batch small writes. Data passed to mraa_uart_write() and
+ * mraa_uart_writev() is collected in a buffer of threshold bytes and only
+ * sent once the next write would fill it, in the same call as that write,
+ * or when mraa_uart_flush() is called. With max_delay_ms set, a timer
+ * thread also sends data that has waited that long. Writes report their
+ * bytes as written once buffered. A threshold of 0 sends what is buffered
+ * and turns coalescing off.
+ *
+ * @param dev uart context
+ * @param threshold buffer size in bytes, 0 to turn coalescing off
+ * @param max_delay_ms longest a byte may wait in the buffer, 0 for no limit
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_set_write_coalescing(mraa_uart_context dev, size_t threshold, unsigned int max_delay_ms);
+
 /**
  * Check to see if data is available on the device for reading
  *
@@ -223,6 +364,89 @@ int mraa_uart_write(mraa_uart_context dev, const char* buf, size_t length);
  */
 mraa_boolean_t mraa_uart_data_available(mraa_uart_context dev, unsigned int millis);
 
+/**
+ * Switch the UART to RS-485 half duplex operation, or back with NULL.
+ * The serial driver is asked first through TIOCSRS485 and, where it can,
+ * drives RTS as transceiver DE with no help. Otherwise a DE gpio, given
+ * in the config or declared by the platform, is asserted around every
+ * mraa_uart_write() and released as soon as the line status register
+ * shows the transmitter empty. The kernel rounds delays up to whole
+ * milliseconds.
+ *
+ * @param dev uart context
+ * @param config RS-485 settings, or NULL to turn RS-485 off
+ * @return MRAA_ERROR_FEATURE_NOT_SUPPORTED if neither the driver nor a
+ * DE gpio can do it
+ */
+mraa_result_t mraa_uart_set_rs485(mraa_uart_context dev, const mraa_uart_rs485_config_t* config);
+
+/**
+ * Get how RS-485 direction switching is done on a context
+ *
+ * @param dev uart context
+ * @return RS-485 mode in use
+ */
+mraa_uart_rs485_mode_t mraa_uart_get_rs485_mode(mraa_uart_context dev);
+
+/**
+ * Set up the buffered frame reader of a context, or tear it down when
+ * config is NULL. Received data goes into one large buffer filled by bulk
+ * reads and frames are handed out in place, SLIP and COBS frames are
+ * decoded in place as well. Bytes already buffered are dropped when the
+ * framing changes. Don't mix with mraa_uart_read() while it is set up.
+ *
+ * @param dev uart context
+ * @param config framing to use, or NULL
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_set_framing(mraa_uart_context dev, const mraa_uart_frame_config_t* config);
+
+/**
+ * Get the next frame from the buffered frame reader. Frames that don't fit
+ * the buffer or fail to decode are dropped and counted, see
+ * mraa_uart_get_frame_errors().
+ *
+ * @param dev uart context
+ * @param frame set to point at the frame payload on success
+ * @param millis number of milliseconds to wait for a whole frame, or 0 to
+ * only look at data already received
+ * @return MRAA_SUCCESS, MRAA_ERROR_NO_DATA_AVAILABLE if no complete frame
+ * arrived in time
+ */
+mraa_result_t mraa_uart_read_frame(mraa_uart_context dev, mraa_uart_frame_t* frame, unsigned int millis);
+
+/**
+ * Get the number of frames dropped by the frame reader since it was set up
+ *
+ * @param dev uart context
+ * @return number of dropped frames
+ */
+unsigned int mraa_uart_get_frame_errors(mraa_uart_context dev);
+
+/**
+ * Have received data delivered to a callback instead of polling for it.
+ * All contexts with a callback are served by one event thread shared by
+ * the process. Data is handed over once at least min_chunk bytes are
+ * buffered, or once the line has been idle for idle_ms with fewer bytes
+ * pending. The data is only valid during the call. Pass a NULL fptr to
+ * stop; once this returns the callback is not running and won't be called
+ * again. Don't mix with mraa_uart_read() or the frame reader.
+ *
+ * @param dev uart context
+ * @param fptr function called with each chunk of received data, or NULL
+ * @param args passed to fptr
+ * @param min_chunk bytes to collect before calling fptr, 0 or 1 to pass on
+ * every read as it comes
+ * @param idle_ms pass on a shorter chunk after this many milliseconds
+ * without new data, 0 to only ever pass on min_chunk bytes
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_set_rx_callback(mraa_uart_context dev,
+                                        void (*fptr)(const char* data, int length, void* args),
+                                        void* args,
+                                        unsigned int min_chunk,
+                                        unsigned int idle_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,12 @@
 #include <stdlib.h>
 #include <stdexcept>
 #include <cstring>
+#include <sys/uio.h>
+#ifndef SWIG
+#include <initializer_list>
+#include <utility>
+#include <vector>
+#endif
 
 namespace mraa
 {
@@ -172,6 +178,89 @@ class Uart
         return mraa_uart_write(m_uart, data.c_str(), (data.length()));
     }
 
+#ifndef SWIG
+    /**
+     * Non owning view of a buffer to send, standing in for
+     * std::span<const uint8_t>. Converts from anything with data() and
+     * size(), like std::string, std::vector or std::array.
+     */
+    struct Span {
+        const void* data; /**< first byte */
+        size_t size;      /**< length in bytes */
+
+        Span(const void* data, size_t size) : data(data), size(size)
+        {
+        }
+
+        template <typename Container, typename = decltype(std::declval<const Container&>().data())>
+        Span(const Container& c) : data(c.data()), size(c.size() * sizeof(*c.data()))
+        {
+        }
+    };
+
+    /**
+     * Write several buffers in one call, see mraa_uart_writev()
+     *
+     * @param spans buffers to send in order
+     * @param count number of buffers
+     * @return the number of bytes written, or -1 if an error occurred
+     */
+    int
+    writev(const Span* spans, size_t count)
+    {
+        struct iovec local[8];
+        std::vector<struct iovec> heap;
+        struct iovec* iov = local;
+        if (count > 8) {
+            heap.resize(count);
+            iov = heap.data();
+        }
+        for (size_t i = 0; i < count; i++) {
+            iov[i].iov_base = const_cast<void*>(spans[i].data);
+            iov[i].iov_len = spans[i].size;
+        }
+        return mraa_uart_writev(m_uart, iov, (int) count);
+    }
+
+    /**
+     * Write several buffers in one call, as in writev({header, payload, crc})
+     *
+     * @param spans buffers to send in order
+     * @return the number of bytes written, or -1 if an error occurred
+     */
+    int
+    writev(std::initializer_list<Span> spans)
+    {
+        return writev(spans.begin(), spans.size());
+    }
+
+    /**
+     * Write several buffers in one call
+     *
+     * @param spans buffers to send in order
+     * @return the number of bytes written, or -1 if an error occurred
+     */
+    int
+    writev(const std::vector<Span>& spans)
+    {
+        return writev(spans.data(), spans.size());
+    }
+#endif
+
+    /**
+     * Batch small writes until flush(), a size threshold or a delay, see
+     * mraa_uart_set_write_coalescing()
+     *
+     * @param threshold buffer size in bytes, 0 to turn coalescing off
+     * @param maxDelayMs longest a byte may wait in the buffer, 0 for no limit
+     * @return Result of operation
+     */
+    Result
+    setWriteCoalescing(size_t threshold, unsigned int maxDelayMs = 0)
+    {
+        return (Result) mraa_uart_set_write_coalescing(m_uart, threshold, maxDelayMs);
+    }
+
     /**
      * Check to see if data is available on the device for reading
      *
@@ -187,9 +276,118 @@ class Uart
             return false;
     }
 
+    /**
+     * Have received data delivered to a callback from the shared uart event
+     * thread, see mraa_uart_set_rx_callback()
+     *
+     * @param fptr function called with each chunk of received data, or NULL to stop
+     * @param args passed to fptr
+     * @param minChunk bytes to collect before calling fptr
+     * @param idleMs pass on a shorter chunk after this many idle milliseconds
+     * @return Result of operation
+     */
+    Result
+    setRxCallback(void (*fptr)(const char* data, int length, void* args),
+                  void* args,
+                  unsigned int minChunk = 1,
+                  unsigned int idleMs = 0)
+    {
+        return (Result) mraa_uart_set_rx_callback(m_uart, fptr, args, minChunk, idleMs);
+    }
+
+    /**
+     * Switch to RS-485 half duplex operation, see mraa_uart_set_rs485()
+     *
+     * @param config RS-485 settings
+     * @return Result of operation
+     */
+    Result
+    setRs485(const mraa_uart_rs485_config_t& config)
+    {
+        return (Result) mraa_uart_set_rs485(m_uart, &config);
+    }
+
+    /**
+     * Switch RS-485 operation off again
+     *
+     * @return Result of operation
+     */
+    Result
+    disableRs485()
+    {
+        return (Result) mraa_uart_set_rs485(m_uart, NULL);
+    }
+
+    /**
+     * Get how RS-485 direction switching is done
+     *
+     * @return RS-485 mode in use
+     */
+    mraa_uart_rs485_mode_t
+    getRs485Mode()
+    {
+        return mraa_uart_get_rs485_mode(m_uart);
+    }
+
+    /**
+     * Set up the buffered frame reader, see mraa_uart_set_framing()
+     *
+     * @param config framing to use
+     * @return Result of operation
+     */
+    Result
+    setFraming(const mraa_uart_frame_config_t& config)
+    {
+        return (Result) mraa_uart_set_framing(m_uart, &config);
+    }
+
+    /**
+     * Get the next frame from the buffered frame reader. The frame points
+     * into the receive buffer and is only valid until the next read.
+     *
+     * @param frame set to the frame payload
+     * @param millis number of milliseconds to wait for a whole frame
+     * @return true if a frame was received, false on timeout
+     */
+    bool
+    readFrame(mraa_uart_frame_t& frame, unsigned int millis = 0)
+    {
+        mraa_result_t ret = mraa_uart_read_frame(m_uart, &frame, millis);
+        if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+            return false;
+        }
+        if (ret != MRAA_SUCCESS) {
+            throw std::runtime_error("Error reading frame");
+        }
+        return true;
+    }
+
+    /**
+     * Hand every received frame to a callback, until no further frame
+     * arrives within millis. The callback is called as
+     * callback(const uint8_t* data, size_t length) and the data is only
+     * valid for the duration of the call.
+     *
+     * @param callback function or functor receiving the frames
+     * @param millis number of milliseconds to wait for each frame
+     * @return number of frames delivered
+     */
+    template <typename Callback>
+    int
+    readFrames(Callback callback, unsigned int millis = 0)
+    {
+        mraa_uart_frame_t frame;
+        int count = 0;
+        while (readFrame(frame, millis)) {
+            callback(frame.data, frame.length);
+            count++;
+        }
+        return count;
+    }
+
     /**
      * Flush the outbound data.
-     * Blocks until complete.
+     * Blocks until complete. Sends data held back by write coalescing first.
      *
      * @return Result of operation
      */
@@ -228,6 +426,17 @@ class Uart
         return (Result) mraa_uart_set_baudrate(m_uart, baud);
     }
 
+    /**
+     * Get the baudrate set last, as read back from the driver
+     *
+     * @return baudrate or 0 if unknown
+     */
+    unsigned int
+    getBaudRate()
+    {
+        return mraa_uart_get_baudrate(m_uart);
+    }
+
     /**
      * Set the transfer mode
      * For example setting the mode to 8N1 would be
@@ -258,8 +467,8 @@ class Uart
     }
 
     /**
-     * Set the timeout for read and write operations
-     * <= 0 will disable that timeout
+     * Set the timeout for read and write operations, in milliseconds.
+     * <= 0 will disable that timeout, see mraa_uart_set_timeout()
      *
      * @param read read timeout
      * @param write write timeout
@@ -272,6 +481,44 @@ class Uart
         return (Result) mraa_uart_set_timeout(m_uart, read, write, interchar);
     }
 
+    /**
+     * Set the termios VMIN and VTIME of the port, replacing the read and
+     * interchar timeouts, see mraa_uart_set_vmin_vtime()
+     *
+     * @param vmin minimum number of bytes for a read to return, 0 - 255
+     * @param vtime timer in tenths of a second, 0 - 255
+     * @return Result of operation
+     */
+    Result
+    setVminVtime(unsigned int vmin, unsigned int vtime)
+    {
+        return (Result) mraa_uart_set_vmin_vtime(m_uart, vmin, vtime);
+    }
+
+    /**
+     * Trade throughput for receive latency, see mraa_uart_set_low_latency()
+     *
+     * @param enable turn low latency mode on or off
+     * @param rxTrigger receive FIFO level in bytes, 0 to leave it alone
+     * @return Result of operation
+     */
+    Result
+    setLowLatency(bool enable, unsigned int rxTrigger = 0)
+    {
+        return (Result) mraa_uart_set_low_latency(m_uart, enable, rxTrigger);
+    }
+
+    /**
+     * Get the receive FIFO interrupt level of the port
+     *
+     * @return level in bytes, or -1 if the port doesn't expose it
+     */
+    int
+    getRxTrigger()
+    {
+        return mraa_uart_get_rx_trigger(m_uart);
+    }
+
     /**
      * Set the blocking state for write operations
      *
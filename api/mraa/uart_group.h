@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @file
+ * @brief UART port group
+ *
+ * A port group services any number of UART contexts from a single thread.
+ * Every port gets a read callback and an output queue, and the thread
+ * waits on all of them at once with an edge triggered epoll set, so a
+ * gateway with dozens of ports needs neither a thread per port nor a
+ * call to mraa_uart_data_available() per port and round.
+ *
+ * Received data is handed to the callback of the port in chunks as read()
+ * returns it. Data written through mraa_uart_group_write() goes out right
+ * away as far as the port takes it and the rest is queued and sent by the
+ * group thread once the port can take more. Bytes that don't fit in the
+ * queue are dropped and counted.
+ *
+ * Callbacks run on the group thread with the group locked, they may write
+ * to any port of the group but must not block.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common.h"
+#include "uart.h"
+
+/** Output queue size used when none is given */
+#define MRAA_UART_GROUP_DEFAULT_QUEUE 4096
+
+/**
+ * Opaque pointer definition to a UART port group
+ */
+typedef struct _uart_group* mraa_uart_group_context;
+
+/**
+ * Per port counters
+ */
+typedef struct {
+    uint64_t rx_bytes;     /**< bytes received and passed to the callback */
+    uint64_t tx_bytes;     /**< bytes written to the port */
+    uint64_t tx_overflows; /**< bytes dropped because the output queue was full */
+    uint64_t rx_overruns;  /**< characters the driver lost since the port was added, 0 if it can't tell */
+    size_t tx_queued;      /**< bytes waiting in the output queue */
+} mraa_uart_group_stats_t;
+
+/**
+ * Create an empty port group and start its thread
+ *
+ * @return group context or NULL
+ */
+mraa_uart_group_context mraa_uart_group_init();
+
+/**
+ * Remove all ports from a group, stop its thread and free it. The uart
+ * contexts stay open.
+ *
+ * @param group group context
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_group_stop(mraa_uart_group_context group);
+
+/**
+ * Add a port to a group. The port is switched to non-blocking mode while
+ * it is in the group. A port can be in one group at a time and must not
+ * have a callback from mraa_uart_set_rx_callback(), write coalescing or
+ * GPIO driven RS-485 direction switching. mraa_uart_stop() takes the port
+ * out of its group.
+ *
+ * @param group group context
+ * @param dev uart context
+ * @param fptr called with the port and every chunk of received data
+ * @param args passed on to fptr
+ * @param queue_size output queue size, 0 for MRAA_UART_GROUP_DEFAULT_QUEUE
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_group_add(mraa_uart_group_context group,
+                                  mraa_uart_context dev,
+                                  void (*fptr)(mraa_uart_context dev, const char* data, int length, void* args),
+                                  void* args,
+                                  size_t queue_size);
+
+/**
+ * Take a port out of its group. Once this returns its callback is not
+ * running and won't be called again. Queued output is discarded.
+ *
+ * @param group group context
+ * @param dev uart context
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_group_remove(mraa_uart_group_context group, mraa_uart_context dev);
+
+/**
+ * Send data on a port of the group without blocking. What the port
+ * can't take right away is queued.
+ *
+ * @param group group context
+ * @param dev uart context
+ * @param buf data to send
+ * @param length bytes in buf
+ * @return bytes sent or queued, less than length if the queue overflowed,
+ * -1 for error
+ */
+int mraa_uart_group_write(mraa_uart_group_context group, mraa_uart_context dev, const char* buf, size_t length);
+
+/**
+ * Get the counters of a port
+ *
+ * @param group group context
+ * @param dev uart context
+ * @param stats filled with the counters
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_group_get_stats(mraa_uart_group_context group, mraa_uart_context dev, mraa_uart_group_stats_t* stats);
+
+/**
+ * Get the number of ports in a group
+ *
+ * @param group group context
+ * @return number of ports or -1 for error
+ */
+int mraa_uart_group_get_count(mraa_uart_group_context group);
+
+#ifdef __cplusplus
+}
+#endif
@@ -69,6 +69,14 @@ extern "C" {
 /** 8 bytes (64 bits) for a device rom code */
 #define MRAA_UART_OW_ROMCODE_SIZE 8
 
+/**
+ * 1-wire bus speeds
+ */
+typedef enum {
+    MRAA_UART_OW_SPEED_STANDARD = 0, /**< standard speed, about 16 kbit/s */
+    MRAA_UART_OW_SPEED_OVERDRIVE = 1 /**< overdrive speed, about 100 kbit/s */
+} mraa_uart_ow_speed_t;
+
 /** for now, we simply use the normal MRAA UART context */
 typedef struct _mraa_uart_ow {
     /** Uart Context */
@@ -81,19 +89,56 @@ typedef struct _mraa_uart_ow {
     int LastFamilyDiscrepancy;
     /** Context las device flag */
     mraa_boolean_t LastDeviceFlag;
+    /** How long to wait for the bus in milliseconds, 0 to derive it from the bit rate */
+    unsigned int timeout_ms;
+    /** Bus speed the resets and bit slots are timed for */
+    mraa_uart_ow_speed_t speed;
 } *mraa_uart_ow_context;
 
+/**
+ * Opaque pointer definition to a bus inventory
+ */
+typedef struct _mraa_uart_ow_inventory* mraa_uart_ow_inventory_context;
+
+/**
+ * A device added to or removed from a bus inventory
+ */
+typedef struct {
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE]; /**< rom code of the device */
+    mraa_boolean_t present;                /**< true if it was added, false if it went away */
+} mraa_uart_ow_change_t;
+
 /**
  * UART One Wire ROM related Command bytes
  */
 typedef enum {
-    MRAA_UART_OW_CMD_READ_ROM = 0x33,         /**< read rom, when only one device on bus */
-    MRAA_UART_OW_CMD_MATCH_ROM = 0x55,        /**< match a specific rom code */
-    MRAA_UART_OW_CMD_SKIP_ROM = 0xcc,         /**< skip match/search rom */
-    MRAA_UART_OW_CMD_SEARCH_ROM_ALARM = 0xec, /**< search all roms in alarm state */
-    MRAA_UART_OW_CMD_SEARCH_ROM = 0xf0        /**< search all rom codes */
+    MRAA_UART_OW_CMD_READ_ROM = 0x33,            /**< read rom, when only one device on bus */
+    MRAA_UART_OW_CMD_MATCH_ROM = 0x55,           /**< match a specific rom code */
+    MRAA_UART_OW_CMD_SKIP_ROM = 0xcc,            /**< skip match/search rom */
+    MRAA_UART_OW_CMD_SKIP_ROM_OVERDRIVE = 0x3c,  /**< skip rom, all devices go to overdrive */
+    MRAA_UART_OW_CMD_MATCH_ROM_OVERDRIVE = 0x69, /**< match rom at overdrive speed, the device goes to overdrive */
+    MRAA_UART_OW_CMD_SEARCH_ROM_ALARM = 0xec,    /**< search all roms in alarm state */
+    MRAA_UART_OW_CMD_SEARCH_ROM = 0xf0           /**< search all rom codes */
 } mraa_uart_ow_rom_cmd_t;
 
+/**
+ * DS18B20 family (DS18B20, DS18S20, DS1822) function commands
+ */
+typedef enum {
+    MRAA_UART_OW_CMD_CONVERT_T = 0x44,      /**< start a temperature conversion */
+    MRAA_UART_OW_CMD_READ_SCRATCHPAD = 0xbe /**< read the 9 byte scratchpad */
+} mraa_uart_ow_temp_cmd_t;
+
+/**
+ * A temperature read by mraa_uart_ow_read_temperatures()
+ */
+typedef struct {
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE]; /**< rom code of the device */
+    int16_t raw;                           /**< temperature register, 1/16 degree C on a DS18B20 */
+    uint8_t scratchpad[9];                 /**< scratchpad as read */
+    mraa_boolean_t ok;                     /**< the scratchpad was read and its CRC matched */
+} mraa_uart_ow_temperature_t;
+
 /**
  * Initialise uart_ow_context, uses UART board mapping
  *
@@ -127,6 +172,51 @@ const char* mraa_uart_ow_get_dev_path(mraa_uart_ow_context dev);
  */
 mraa_result_t mraa_uart_ow_stop(mraa_uart_ow_context dev);
 
+/**
+ * Set how long to wait for the bus to echo a batch of bit slots (or a
+ * reset pulse) before giving up.  By default this is the time the
+ * echoes take at the current bit rate plus 50ms.
+ *
+ * @param dev uart_ow context
+ * @param timeout_ms milliseconds, 0 to derive it from the bit rate
+ * @return mraa_result_t
+ */
+mraa_result_t mraa_uart_ow_set_timeout(mraa_uart_ow_context dev, unsigned int timeout_ms);
+
+/**
+ * Set the bus speed the resets and bit slots are timed for.  This only
+ * changes the timing, see mraa_uart_ow_overdrive() to put devices into
+ * overdrive.  Going back to standard speed, the next reset puts all
+ * devices back to standard speed too.
+ *
+ * @param dev uart_ow context
+ * @param speed bus speed
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_set_speed(mraa_uart_ow_context dev, mraa_uart_ow_speed_t speed);
+
+/**
+ * Get the bus speed of a context
+ *
+ * @param dev uart_ow context
+ * @return bus speed
+ */
+mraa_uart_ow_speed_t mraa_uart_ow_get_speed(mraa_uart_ow_context dev);
+
+/**
+ * Put devices into overdrive and switch the context to overdrive
+ * speed.  This sends a standard speed reset, then an overdrive skip rom
+ * command for all devices, or an overdrive match rom and the rom code
+ * for one device.  Devices not capable of overdrive ignore it.  After a
+ * skip rom every device is selected, like after a skip rom at standard
+ * speed, after a match rom the device matched is.
+ *
+ * @param dev uart_ow context
+ * @param id the 8-byte rom code of the device, or NULL for all devices
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_overdrive(mraa_uart_ow_context dev, uint8_t* id);
+
 /**
  * Read a byte from the 1-wire bus
  *
@@ -144,6 +234,21 @@ int mraa_uart_ow_read_byte(mraa_uart_ow_context dev);
  */
 int mraa_uart_ow_write_byte(mraa_uart_ow_context dev, uint8_t byte);
 
+/**
+ * Write a block of bytes to a 1-wire bus and read back the bytes
+ * present during their time slots, for example a rom command with the
+ * rom code and a function command, or a whole scratchpad read when
+ * sending 0xff bytes.  The bit slots of up to 20 bytes go out in a
+ * single uart write and their echoes are collected in one bulk read,
+ * instead of a round trip per bit.
+ *
+ * @param dev uart_ow context
+ * @param buf the bytes to write, replaced with the bytes read back
+ * @param length the number of bytes in buf
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_block(mraa_uart_ow_context dev, uint8_t* buf, size_t length);
+
 /**
  * Write a bit to a 1-wire bus and read a bit corresponding to the
  * time slot back.  This is possible due to the way we wired the TX
@@ -178,6 +283,87 @@ mraa_result_t mraa_uart_ow_reset(mraa_uart_ow_context dev);
  */
 mraa_result_t mraa_uart_ow_rom_search(mraa_uart_ow_context dev, mraa_boolean_t start, uint8_t* id);
 
+/**
+ * Check that a device is on the bus.  This is a search that only
+ * follows the path of the given rom code, so all of it goes out in one
+ * go instead of waiting for the bus at every bit.
+ *
+ * @param dev uart_ow context
+ * @param id the 8-byte rom code to look for
+ * @return MRAA_SUCCESS if the device answered,
+ * MRAA_ERROR_UART_OW_NO_DEVICES if not, or another mraa_result_t value
+ * on failure
+ */
+mraa_result_t mraa_uart_ow_rom_verify(mraa_uart_ow_context dev, uint8_t* id);
+
+/**
+ * Create an empty bus inventory.  An inventory remembers the rom codes
+ * found on a bus, so they don't have to be searched for again to talk to
+ * the devices or to notice that one was plugged in or went away.
+ *
+ * @param dev uart_ow context, must stay open while the inventory is used
+ * @return inventory context or NULL
+ */
+mraa_uart_ow_inventory_context mraa_uart_ow_inventory_init(mraa_uart_ow_context dev);
+
+/**
+ * Free a bus inventory
+ *
+ * @param inv inventory context
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_inventory_stop(mraa_uart_ow_inventory_context inv);
+
+/**
+ * Search the bus and bring the inventory up to date.  With a family
+ * code the search skips straight to that family, and only devices of
+ * that family are added or removed.
+ *
+ * @param inv inventory context
+ * @param family family code (first byte of the rom code) to search
+ * for, -1 for all devices
+ * @param changes filled with the devices added and removed, may be NULL
+ * @param max_changes room in changes
+ * @return number of changes, which can be more than max_changes, or -1
+ * for error, in which case the inventory is left alone
+ */
+int mraa_uart_ow_inventory_search(mraa_uart_ow_inventory_context inv,
+                                  int family,
+                                  mraa_uart_ow_change_t* changes,
+                                  int max_changes);
+
+/**
+ * Check that every device of the inventory is still on the bus with
+ * mraa_uart_ow_rom_verify() and remove those that aren't.  Much quicker
+ * than a search, but doesn't find new devices.
+ *
+ * @param inv inventory context
+ * @param changes filled with the devices removed, may be NULL
+ * @param max_changes room in changes
+ * @return number of devices removed, which can be more than max_changes,
+ * or -1 for error
+ */
+int mraa_uart_ow_inventory_verify(mraa_uart_ow_inventory_context inv, mraa_uart_ow_change_t* changes, int max_changes);
+
+/**
+ * Get the number of devices in an inventory
+ *
+ * @param inv inventory context
+ * @return number of devices or -1 for error
+ */
+int mraa_uart_ow_inventory_get_count(mraa_uart_ow_inventory_context inv);
+
+/**
+ * Get the rom code of a device of an inventory.  Devices keep the order
+ * they were found in.
+ *
+ * @param inv inventory context
+ * @param index device index, 0 to mraa_uart_ow_inventory_get_count() - 1
+ * @param id filled with the 8-byte rom code
+ * @return one of the mraa_result_t values
+ */
+mraa_result_t mraa_uart_ow_inventory_get_id(mraa_uart_ow_inventory_context inv, int index, uint8_t* id);
+
 /**
  * Send a command byte to a device on the 1-wire bus
  *
@@ -189,6 +375,32 @@ mraa_result_t mraa_uart_ow_rom_search(mraa_uart_ow_context dev, mraa_boolean_t s
  */
 mraa_result_t mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id);
 
+/**
+ * Read the temperature of many DS18B20 family devices at once.  A
+ * single skip rom and convert T starts the conversion on all devices
+ * together, then the scratchpad of every device is read with one reset
+ * and one block each and checked against its CRC.  Sampling the whole
+ * bus takes one conversion time plus the readout instead of one
+ * conversion time per device.
+ *
+ * Devices on external power signal the end of the conversion, so with
+ * conversion_ms 0 the wait ends as soon as all of them are done (750ms
+ * at most).  Parasite powered devices can't, pass their conversion time
+ * for them.
+ *
+ * @param dev uart_ow context
+ * @param readings array with the id of each device to read filled in,
+ * raw, scratchpad and ok are set
+ * @param count number of entries in readings
+ * @param conversion_ms time to wait for the conversion, 0 to wait for
+ * the devices to signal they are done
+ * @return the number of devices read successfully or -1 for error
+ */
+int mraa_uart_ow_read_temperatures(mraa_uart_ow_context dev,
+                                   mraa_uart_ow_temperature_t* readings,
+                                   int count,
+                                   unsigned int conversion_ms);
+
 /**
  * Perform a Dallas 1-wire compliant CRC8 computation on a buffer
  *
@@ -198,6 +410,38 @@ mraa_result_t mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, ui
  */
 uint8_t mraa_uart_ow_crc8(uint8_t* buffer, uint16_t length);
 
+/**
+ * Same as mraa_uart_ow_crc8() but takes four bytes per step with four
+ * lookup tables, which pays off most on longer buffers such as EEPROM
+ * pages.
+ *
+ * @param buffer the buffer containing the data
+ * @param length the length of the buffer
+ * @return the computed CRC
+ */
+uint8_t mraa_uart_ow_crc8_slice4(uint8_t* buffer, uint16_t length);
+
+/**
+ * Perform a Dallas 1-wire compliant CRC16 computation on a buffer, as
+ * used by the DS2438 and the EEPROM parts. Devices send the inverted
+ * CRC, least significant byte first.
+ *
+ * @param buffer the buffer containing the data
+ * @param length the length of the buffer
+ * @return the computed CRC
+ */
+uint16_t mraa_uart_ow_crc16(uint8_t* buffer, uint16_t length);
+
+/**
+ * Same as mraa_uart_ow_crc16() but takes four bytes per step with four
+ * lookup tables
+ *
+ * @param buffer the buffer containing the data
+ * @param length the length of the buffer
+ * @return the computed CRC
+ */
+uint16_t mraa_uart_ow_crc16_slice4(uint8_t* buffer, uint16_t length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,6 +30,10 @@
 #include "uart_ow.h"
 #include <cstring>
 #include <stdexcept>
+#include <string>
+#ifndef SWIG
+#include <vector>
+#endif
 
 namespace mraa
 {
@@ -112,6 +116,19 @@ class UartOW
         return ret_val;
     }
 
+    /**
+     * Set how long to wait for the bus to echo a batch of bit slots (or
+     * a reset pulse) before giving up
+     *
+     * @param timeout_ms milliseconds, 0 to derive it from the bit rate
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    setTimeout(unsigned int timeout_ms)
+    {
+        return (mraa::Result) mraa_uart_ow_set_timeout(m_uart, timeout_ms);
+    }
+
     /**
      * Read a byte from the 1-wire bus
      *
@@ -146,6 +163,24 @@ class UartOW
         return (uint8_t) res;
     }
 
+    /**
+     * Write a block of bytes to a 1-wire bus and read back the bytes
+     * present during their time slots.  The bit slots of up to 20
+     * bytes go out in a single uart write.
+     *
+     * @param buffer the bytes to write, use 0xff to read
+     * @throws std::invalid_argument in case of error
+     * @return the bytes read back during the time slots
+     */
+    std::string
+    block(std::string buffer)
+    {
+        if (mraa_uart_ow_block(m_uart, (uint8_t*) &buffer[0], buffer.size()) != MRAA_SUCCESS) {
+            throw std::invalid_argument("Unknown UART_OW error");
+        }
+        return buffer;
+    }
+
     /**
      * Write a bit to a 1-wire bus and read a bit corresponding to the
      * time slot back.  This is possible due to the way we wired the TX
@@ -165,6 +200,44 @@ class UartOW
         return ((res) ? true : false);
     }
 
+    /**
+     * Set the bus speed the resets and bit slots are timed for
+     *
+     * @param speed bus speed
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    setSpeed(mraa_uart_ow_speed_t speed)
+    {
+        return (mraa::Result) mraa_uart_ow_set_speed(m_uart, speed);
+    }
+
+    /**
+     * Put all devices into overdrive and switch to overdrive speed
+     *
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    overdrive()
+    {
+        return (mraa::Result) mraa_uart_ow_overdrive(m_uart, NULL);
+    }
+
+    /**
+     * Put one device into overdrive and switch to overdrive speed
+     *
+     * @param id std::string containing the 8-byte rom code of the device
+     * @return one of the mraa::Result values
+     */
+    mraa::Result
+    overdrive(std::string id)
+    {
+        if (id.size() != MRAA_UART_OW_ROMCODE_SIZE) {
+            throw std::invalid_argument(std::string(__FUNCTION__) + ": id must be 8 bytes only");
+        }
+        return (mraa::Result) mraa_uart_ow_overdrive(m_uart, (uint8_t*) id.data());
+    }
+
     /**
      * Send a reset pulse to the 1-wire bus and test for device presence
      *
@@ -223,6 +296,21 @@ class UartOW
         }
     }
 
+    /**
+     * Check that a device is on the bus, quicker than searching for it
+     *
+     * @param id std::string containing the 8-byte rom code to look for
+     * @return true if the device answered
+     */
+    bool
+    verify(std::string id)
+    {
+        if (id.size() != MRAA_UART_OW_ROMCODE_SIZE) {
+            throw std::invalid_argument(std::string(__FUNCTION__) + ": id must be 8 bytes only");
+        }
+        return mraa_uart_ow_rom_verify(m_uart, (uint8_t*) id.data()) == MRAA_SUCCESS;
+    }
+
     /**
      * Send a command byte to a device on the 1-wire bus
      *
@@ -262,6 +350,36 @@ class UartOW
         }
     }
 
+#ifndef SWIG
+    /**
+     * Read the temperature of many DS18B20 family devices at once, with
+     * one conversion started on all of them together.  See
+     * mraa_uart_ow_read_temperatures().
+     *
+     * @param ids rom codes of the devices, 8 bytes each
+     * @param conversion_ms time to wait for the conversion, 0 to wait
+     * for the devices to signal they are done
+     * @throws std::invalid_argument in case of error
+     * @return a reading per id, in the same order
+     */
+    std::vector<mraa_uart_ow_temperature_t>
+    readTemperatures(const std::vector<std::string>& ids, unsigned int conversion_ms = 0)
+    {
+        std::vector<mraa_uart_ow_temperature_t> readings(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) {
+            if (ids[i].size() != MRAA_UART_OW_ROMCODE_SIZE) {
+                throw std::invalid_argument(std::string(__FUNCTION__) +
+                                            ": ids must be 8 bytes only");
+            }
+            memcpy(readings[i].id, ids[i].data(), MRAA_UART_OW_ROMCODE_SIZE);
+        }
+        if (mraa_uart_ow_read_temperatures(m_uart, readings.data(), readings.size(), conversion_ms) < 0) {
+            throw std::invalid_argument("Unknown UART_OW error");
+        }
+        return readings;
+    }
+#endif
+
     /**
      * Perform a Dallas 1-wire compliant CRC8 computation on a buffer
      *
@@ -288,6 +406,32 @@ class UartOW
         return mraa_uart_ow_crc8((uint8_t*) buffer.data(), buffer.size());
     }
 
+    /**
+     * Perform a Dallas 1-wire compliant CRC16 computation on a buffer
+     *
+     * @param buffer the buffer containing the data
+     * @param length the length of the buffer
+     * @return the computed CRC
+     */
+    uint16_t
+    crc16(uint8_t* buffer, uint16_t length)
+    {
+        return mraa_uart_ow_crc16(buffer, length);
+    }
+
+    /**
+     * Perform a Dallas 1-wire compliant CRC16 computation on a
+     * std::string based buffer
+     *
+     * @param buffer std::string buffer containing the data
+     * @return the computed CRC
+     */
+    uint16_t
+    crc16(std::string buffer)
+    {
+        return mraa_uart_ow_crc16((uint8_t*) buffer.data(), buffer.size());
+    }
+
   private:
     mraa_uart_ow_context m_uart;
 };
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Read a channel without scaling the value to the bit width of the
+ * context. Boards that replace AIO reads return scaled values already.
+ *
+ * @param dev The AIO context
+ * @return the value as the ADC reports it or -1 for error
+ */
+int mraa_aio_read_raw(mraa_aio_context dev);
+
+/**
+ * Free the filter of a context, if it has one
+ *
+ * @param dev The AIO context
+ */
+void mraa_aio_filter_free(mraa_aio_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "common.h"
+
+/** The IIO device the aio channels live on */
+#define MRAA_AIO_IIO_DEVICE 0
+
+/**
+ * Where a value sits in a scan of an IIO buffer and how to unpack it
+ */
+typedef struct {
+    int location;              /**< byte offset in the scan */
+    int bytes;                 /**< storage size, 1, 2, 4 or 8 */
+    int bits;                  /**< bits used */
+    int shift;                 /**< right shift before masking */
+    mraa_boolean_t is_signed;  /**< sign extend from bits */
+    mraa_boolean_t big_endian; /**< stored big endian */
+} mraa_aio_iio_element_t;
+
+/**
+ * An IIO buffer set up to capture some voltage channels of the aio IIO
+ * device
+ */
+typedef struct {
+    int fd;                            /**< /dev/iio:deviceN, non-blocking */
+    int scan_size;                     /**< bytes per scan */
+    int count;                         /**< channels captured */
+    mraa_aio_iio_element_t* elements;  /**< layout of each channel, in the order asked for */
+    unsigned int* channels;            /**< the channels, to disable them again */
+    int timestamp_location;            /**< byte offset of the timestamp in a scan, -1 if none */
+    int trigger_now_fd;                /**< trigger_now of a sysfs trigger, -1 if none */
+    mraa_boolean_t hrtimer;            /**< an hrtimer trigger takes the scans by itself */
+    mraa_boolean_t trigger_set;        /**< a trigger is attached to the device */
+    mraa_boolean_t hrtimer_created;    /**< the hrtimer trigger was created here, removed on close */
+    mraa_boolean_t sysfs_trig_added;   /**< the sysfs trigger was added here, removed on close */
+    mraa_boolean_t timestamp_enabled;  /**< the timestamp scan element was enabled */
+} mraa_aio_iio_buffer_t;
+
+/**
+ * Parse the type of a scan element, such as "le:s12/16>>4", into an
+ * element without its location
+ *
+ * @param type contents of the _type file of the scan element
+ * @param element filled with the layout
+ * @return MRAA_ERROR_INVALID_RESOURCE if the type can't be unpacked
+ */
+mraa_result_t mraa_aio_iio_parse_type(const char* type, mraa_aio_iio_element_t* element);
+
+/**
+ * Place scan elements in a scan the way the kernel does, each aligned to
+ * its own size, and set their locations
+ *
+ * @param elements the enabled scan elements, in index order
+ * @param count number of elements
+ * @return bytes per scan, padded to the largest element
+ */
+int mraa_aio_iio_scan_layout(mraa_aio_iio_element_t* elements, int count);
+
+/**
+ * Enable the scan elements of the channels, attach a trigger to the
+ * device and enable its buffer.
+ *
+ * Without a rate a sysfs trigger is attached and scans are taken with
+ * mraa_aio_iio_buffer_trigger(). With a rate the timestamp is captured
+ * too, and an hrtimer trigger running at that rate is created through
+ * configfs. If that can't be had a sysfs trigger is attached instead,
+ * hrtimer is false and the caller fires it with mraa_aio_iio_buffer_fire().
+ *
+ * @param buf filled with the buffer state
+ * @param channels voltage channel numbers
+ * @param count number of channels
+ * @param rate_hz scans per second, 0 to take them on demand
+ * @param length scans the kernel buffer holds, 0 for a default
+ * @return MRAA_ERROR_FEATURE_NOT_SUPPORTED if the device has no buffer,
+ * no scan element for one of the channels, or no trigger can be had, so
+ * the caller can fall back to sysfs reads
+ */
+mraa_result_t mraa_aio_iio_buffer_open(mraa_aio_iio_buffer_t* buf,
+                                       const unsigned int* channels,
+                                       int count,
+                                       unsigned int rate_hz,
+                                       int length);
+
+/**
+ * Disable the buffer and the scan elements, remove the triggers created
+ * for it and close everything
+ *
+ * @param buf buffer state
+ */
+void mraa_aio_iio_buffer_close(mraa_aio_iio_buffer_t* buf);
+
+/**
+ * Fire the sysfs trigger of the buffer
+ *
+ * @param buf buffer state
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_iio_buffer_fire(mraa_aio_iio_buffer_t* buf);
+
+/**
+ * Read the scans waiting in the buffer, waiting for one if there are none
+ *
+ * @param buf buffer state
+ * @param scans room for max_scans scans of scan_size bytes
+ * @param max_scans most scans to read
+ * @param timeout_ms how long to wait, -1 for ever
+ * @return scans read, 0 on timeout or -1 for error
+ */
+int mraa_aio_iio_buffer_read(mraa_aio_iio_buffer_t* buf, uint8_t* scans, int max_scans, int timeout_ms);
+
+/**
+ * Fire the trigger of the buffer and read the scan it takes
+ *
+ * @param buf buffer state
+ * @param scan filled with scan_size bytes
+ * @param timeout_ms how long to wait for the scan
+ * @return Result of operation
+ */
+mraa_result_t mraa_aio_iio_buffer_trigger(mraa_aio_iio_buffer_t* buf, uint8_t* scan, int timeout_ms);
+
+/**
+ * Unpack the value of every channel from a scan
+ *
+ * @param buf buffer state
+ * @param scan scan_size bytes
+ * @param samples filled with one raw value per channel
+ */
+void mraa_aio_iio_buffer_unpack(const mraa_aio_iio_buffer_t* buf, const uint8_t* scan, int32_t* samples);
+
+/**
+ * Get the timestamp of a scan
+ *
+ * @param buf buffer state
+ * @param scan scan_size bytes
+ * @return nanoseconds or -1 if scans have no timestamp
+ */
+int64_t mraa_aio_iio_buffer_timestamp(const mraa_aio_iio_buffer_t* buf, const uint8_t* scan);
+
+#ifdef __cplusplus
+}
+#endif
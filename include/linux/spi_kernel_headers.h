@@ -18,6 +18,11 @@
 #define SPI_MODE_2 (SPI_CPOL|0)
 #define SPI_MODE_3 (SPI_CPOL|SPI_CPHA)
 
+#define SPI_TX_DUAL 0x100
+#define SPI_TX_QUAD 0x200
+#define SPI_RX_DUAL 0x400
+#define SPI_RX_QUAD 0x800
+
 #define SPI_IOC_MAGIC 'k'
 
 struct spi_ioc_transfer {
@@ -17,9 +17,18 @@ extern "C" {
 #define MOCK_SPI_DEFAULT_MODE MRAA_SPI_MODE0
 #define MOCK_SPI_DEFAULT_LSBMODE 0
 #define MOCK_SPI_DEFAULT_BIT_PER_WORD 8
+// The mock controller can do dual I/O but not quad
+#define MOCK_SPI_MAX_BUSWIDTH MRAA_SPI_BUSWIDTH_DUAL
 // This is XORed with each byte/word of the transmitted message to get the received one
 #define MOCK_SPI_REPLY_DATA_MODIFIER_BYTE 0xAB
 #define MOCK_SPI_REPLY_DATA_MODIFIER_WORD 0xABBA
+#define MOCK_SPI_REPLY_DATA_MODIFIER_WORD32 0xABBAABBA
+// Multi segment transfers talk to an emulated 256KiB SPI NOR flash with SFDP
+#define MOCK_SPI_FLASH_SIZE (256 * 1024)
+#define MOCK_SPI_FLASH_PAGE_SIZE 256
+#define MOCK_SPI_FLASH_JEDEC_ID { 0xEF, 0x40, 0x12 }
+// Number of status register reads a program or erase stays busy for
+#define MOCK_SPI_FLASH_BUSY_POLLS 2
 
 mraa_result_t
 mraa_mock_spi_init_raw_replace(mraa_spi_context dev, unsigned int bus, unsigned int cs);
@@ -51,6 +60,15 @@ mraa_mock_spi_transfer_buf_replace(mraa_spi_context dev, uint8_t* data, uint8_t*
 mraa_result_t
 mraa_mock_spi_transfer_buf_word_replace(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length);
 
+mraa_result_t
+mraa_mock_spi_transfer_buf_word32_replace(mraa_spi_context dev, uint32_t* data, uint32_t* rxbuf, int length);
+
+mraa_result_t
+mraa_mock_spi_buswidth_replace(mraa_spi_context dev, mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx);
+
+mraa_result_t
+mraa_mock_spi_transfer_segments_replace(mraa_spi_context dev, mraa_spi_segment_t* segments, int count);
+
 #ifdef __cplusplus
 }
 #endif
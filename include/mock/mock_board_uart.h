@@ -13,8 +13,25 @@ extern "C" {
 
 #include "mraa_internal.h"
 
-// ASCII code for "Z", used as a basis for our mock reads
-#define MOCK_UART_DATA_BYTE 0x5A
+/**
+ * Impairments of a mock UART line, applied in both directions
+ */
+typedef struct {
+    unsigned int latency_us; /**< added to the arrival of every byte */
+    unsigned int drop_ppm;   /**< bytes lost, per million */
+    unsigned int parity_ppm; /**< bytes arriving with a parity error, per million */
+    unsigned int seed;       /**< seed of the impairment generator, 0 keeps the current one */
+} mraa_mock_uart_line_config_t;
+
+/**
+ * Counters of a mock UART line
+ */
+typedef struct {
+    uint64_t tx_bytes;      /**< bytes delivered to the far end */
+    uint64_t rx_bytes;      /**< bytes delivered to the application */
+    uint64_t dropped;       /**< bytes lost on the line */
+    uint64_t parity_errors; /**< bytes hit by a parity error */
+} mraa_mock_uart_line_stats_t;
 
 mraa_result_t
 mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud);
@@ -22,6 +39,9 @@ mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud);
 mraa_result_t
 mraa_mock_uart_init_raw_replace(mraa_uart_context dev, const char* path);
 
+mraa_result_t
+mraa_mock_uart_stop_pre(mraa_uart_context dev);
+
 mraa_result_t
 mraa_mock_uart_flush_replace(mraa_uart_context dev);
 
@@ -34,20 +54,38 @@ mraa_mock_uart_set_flowcontrol_replace(mraa_uart_context dev, mraa_boolean_t xon
 mraa_result_t
 mraa_mock_uart_set_mode_replace(mraa_uart_context dev, int bytesize, mraa_uart_parity_t parity, int stopbits);
 
+/**
+ * Set the latency, drop and parity error rates of the line of a mock UART
+ * context
+ *
+ * @param dev uart context on the mock UART
+ * @param config impairments
+ * @return Result of operation
+ */
 mraa_result_t
-mraa_mock_uart_set_non_blocking_replace(mraa_uart_context dev, mraa_boolean_t nonblock);
-
-mraa_result_t
-mraa_mock_uart_set_timeout_replace(mraa_uart_context dev, int read, int write, int interchar);
-
-mraa_boolean_t
-mraa_mock_uart_data_available_replace(mraa_uart_context dev, unsigned int millis);
+mraa_mock_uart_set_line(mraa_uart_context dev, const mraa_mock_uart_line_config_t* config);
 
+/**
+ * Take over the far end of the line of a mock UART context, which is a
+ * loopback otherwise. Bytes written to the returned socket arrive at the
+ * context at line rate, bytes the context writes can be read from it.
+ * Closing it makes the line a loopback again.
+ *
+ * @param dev uart context on the mock UART
+ * @return socket of the far end or -1 for error
+ */
 int
-mraa_mock_uart_write_replace(mraa_uart_context dev, const char* buf, size_t len);
+mraa_mock_uart_open_peer(mraa_uart_context dev);
 
-int
-mraa_mock_uart_read_replace(mraa_uart_context dev, char* buf, size_t len);
+/**
+ * Get the counters of the line of a mock UART context
+ *
+ * @param dev uart context on the mock UART
+ * @param stats filled with the counters
+ * @return Result of operation
+ */
+mraa_result_t
+mraa_mock_uart_get_line_stats(mraa_uart_context dev, mraa_mock_uart_line_stats_t* stats);
 
 #ifdef __cplusplus
 }
@@ -89,6 +89,9 @@ typedef struct {
     mraa_result_t (*spi_frequency_replace) (mraa_spi_context dev, int hz);
     mraa_result_t (*spi_transfer_buf_replace) (mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length);
     mraa_result_t (*spi_transfer_buf_word_replace) (mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length);
+    mraa_result_t (*spi_transfer_buf_word32_replace) (mraa_spi_context dev, uint32_t* data, uint32_t* rxbuf, int length);
+    mraa_result_t (*spi_buswidth_replace) (mraa_spi_context dev, mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx);
+    mraa_result_t (*spi_transfer_segments_replace) (mraa_spi_context dev, mraa_spi_segment_t* segments, int count);
     int (*spi_write_replace) (mraa_spi_context dev, uint8_t data);
     int (*spi_write_word_replace) (mraa_spi_context dev, uint16_t data);
     mraa_result_t (*spi_stop_replace) (mraa_spi_context dev);
@@ -106,4 +109,5 @@ typedef struct {
     int (*uart_read_replace) (mraa_uart_context dev, char* buf, size_t len);
     int (*uart_write_replace)(mraa_uart_context dev, const char* buf, size_t len);
     mraa_boolean_t (*uart_data_available_replace) (mraa_uart_context dev, unsigned int millis);
+    mraa_result_t (*uart_stop_pre) (mraa_uart_context dev);
 } mraa_adv_func_t;
@@ -154,6 +154,14 @@ int mraa_find_i2c_bus_pci(const char* pci_device, const char *pci_id, const char
  */
 mraa_result_t mraa_find_uart_bus_pci(const char* pci_dev_path, char** dev_name);
 
+/**
+ * helper function to read CLOCK_MONOTONIC, for timeouts, pacing and
+ * statistics
+ *
+ * @return monotonic time in nanoseconds
+ */
+uint64_t mraa_monotonic_ns();
+
 #if defined(IMRAA)
 /**
  * read Imraa subplatform lock file, caller is responsible to free return
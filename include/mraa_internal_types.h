@@ -57,6 +57,7 @@
 #define RAW_PIN_KEY "rawpin"
 #define RXPIN_KEY "rx"
 #define TXPIN_KEY "tx"
+#define DEPIN_KEY "de"
 #define UART_PATH_KEY "path"
 #define CLOCK_KEY "clock"
 #define MISO_KEY "miso"
@@ -67,6 +68,7 @@
 #define IO_KEY "layout"
 #define PLATFORM_KEY "platform"
 #define BUS_KEY "bus"
+#define SOFT_KEY "soft"
 
 // IO keys
 #define AIO_KEY "a"
@@ -195,6 +197,18 @@ struct _spi {
     int clock;          /**< clock to run transactions at */
     mraa_boolean_t lsb; /**< least significant bit mode */
     unsigned int bpw;   /**< Bits per word */
+    uint8_t tx_nbits;   /**< widest tx bus width granted by the controller, 0 or 1 is single */
+    uint8_t rx_nbits;   /**< widest rx bus width granted by the controller, 0 or 1 is single */
+    mraa_boolean_t lsb_soft; /**< lsb mode is emulated by reversing bits in software */
+    uint8_t* soft_buf;  /**< scratch tx buffer used by software bit order conversion */
+    int soft_buf_len;   /**< allocated size of soft_buf in bytes */
+    mraa_gpio_context gpio_out;  /**< bit-banged bus: sclk, mosi and optional cs outputs */
+    mraa_gpio_context gpio_miso; /**< bit-banged bus: miso input, NULL if not wired */
+    int gpio_levels[3]; /**< bit-banged bus: current levels of the gpio_out pins */
+    long half_period_ns; /**< bit-banged bus: half of the requested clock period */
+    int clock_achieved; /**< bit-banged bus: clock measured over the last transfer, 0 if none yet */
+    mraa_spi_stats_t stats; /**< transfer counters, elapsed_ns and utilisation unused */
+    uint64_t stats_since_ns; /**< monotonic time the counters were last reset */
     mraa_adv_func_t* advance_func; /**< override function table */
     /*@}*/
 #ifdef PERIPHERALMAN
@@ -227,7 +241,13 @@ struct _aio {
     unsigned int channel; /**< the channel as on board and ADC module */
     int adc_in_fp; /**< File Pointer to raw sysfs */
     int value_bit; /**< 10 bits by default. Can be increased if board */
+    int raw_bits; /**< bits the ADC returns */
+    unsigned int shift_left; /**< raw values are shifted left then right to value_bit */
+    unsigned int shift_right;
+    float float_scale; /**< 1 over the largest scaled value */
     mraa_adv_func_t* advance_func; /**< override function table */
+    struct _aio_stream* stream; /**< continuous capture, NULL if off */
+    struct _aio_filter* filter; /**< oversampling and filter state, NULL if off */
     /*@}*/
 };
 
@@ -239,6 +259,20 @@ struct _uart {
     int index; /**< the uart index, as known to the os. */
     const char* path; /**< the uart device path. */
     int fd; /**< file descriptor for device. */
+    unsigned int baudrate; /**< rate achieved by the last set_baudrate */
+    int read_timeout_ms; /**< wait for the first byte of a read, 0 for none */
+    int write_timeout_ms; /**< deadline for a write to drain, 0 for none */
+    int interchar_ms; /**< gap ending a read, 0 for none */
+    struct _uart_frame* frame; /**< buffered frame reader, NULL if not set up */
+    struct _uart_rx* rx; /**< rx callback registration, NULL if none */
+    struct _uart_coalesce* coalesce; /**< write coalescing buffer, NULL if off */
+    struct _uart_group* group; /**< port group the port is in, NULL if none */
+    int de_pin; /**< platform rs485 DE pin, -1 if none */
+    mraa_uart_rs485_mode_t rs485_mode; /**< how rs485 direction is switched */
+    mraa_uart_rs485_config_t rs485; /**< rs485 settings in use */
+    mraa_gpio_context rs485_de; /**< DE gpio in MRAA_UART_RS485_GPIO mode */
+    int low_latency_saved; /**< ASYNC_LOW_LATENCY as found, -1 if untouched */
+    int rx_trig_saved; /**< rx_trig_bytes as found, -1 if untouched */
     mraa_adv_func_t* advance_func; /**< override function table */
     /*@}*/
 #if defined(PERIPHERALMAN)
@@ -404,6 +438,7 @@ typedef struct {
     int mosi; /**< Master Out, Slave In. */
     int miso; /**< Master In, Slave Out. */
     int cs; /**< Chip Select, used when the board is a spi slave */
+    mraa_boolean_t soft; /**< Bus is bit-banged over the sclk, mosi, miso and cs gpios */
     /*@}*/
 } mraa_spi_bus_t;
 
@@ -418,6 +453,8 @@ typedef struct {
     int tx; /**< uart tx */
     int cts; /**< uart cts */
     int rts; /**< uart rts */
+    int de; /**< rs485 driver enable gpio pin, only if has_de */
+    mraa_boolean_t has_de; /**< a gpio drives the rs485 transceiver DE */
     char* device_path; /**< To store "/dev/ttyS1" for example */
     /*@}*/
 } mraa_uart_dev_t;
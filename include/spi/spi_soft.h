@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Create a SPI context that bit-bangs the bus over the sclk, mosi, miso and
+ * cs pins of a board SPI bus. Every mraa_spi_* call on the context is served
+ * by the soft backend through its own function table.
+ *
+ * @param bus board description of the bus, sclk and mosi are required
+ * @return spi context or NULL on failure
+ */
+mraa_spi_context mraa_spi_soft_init(mraa_spi_bus_t* bus);
+
+#ifdef __cplusplus
+}
+#endif
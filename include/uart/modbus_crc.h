@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * CRC16 lookup table of the reflected polynomial 0xA001, advancing a CRC
+ * by one byte as crc = (crc >> 8) ^ table[(crc ^ byte) & 0xff]. Modbus
+ * starts the CRC at 0xFFFF, 1-Wire at 0.
+ */
+extern const uint16_t mraa_modbus_crc_table[256];
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/uio.h>
+
+#include "mraa_internal.h"
+
+/** Most buffers a single writev() takes on Linux */
+#define UART_IOV_MAX 1024
+
+/** iovec arrays up to this size are built on the stack */
+#define UART_IOV_LOCAL 8
+
+/**
+ * Write buffers to the port right away, driving the RS-485 DE gpio when
+ * set up
+ *
+ * @param dev uart context
+ * @param iov buffers to send
+ * @param count number of buffers
+ * @return bytes sent or a negative value for error
+ */
+int mraa_uart_write_direct(mraa_uart_context dev, const struct iovec* iov, int count);
+
+/**
+ * Add buffers to the write coalescing buffer of a context, sending it
+ * together with them once the threshold is reached
+ *
+ * @param dev uart context with write coalescing set up
+ * @param iov buffers to send
+ * @param count number of buffers
+ * @return bytes of iov accepted or a negative value for error
+ */
+int mraa_uart_coalesce_write(mraa_uart_context dev, const struct iovec* iov, int count);
+
+/**
+ * Send whatever the write coalescing buffer of a context holds
+ *
+ * @param dev uart context with write coalescing set up
+ * @return Result of operation
+ */
+mraa_result_t mraa_uart_coalesce_flush(mraa_uart_context dev);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "mraa_internal.h"
+
+/**
+ * Assert the DE gpio of a context in MRAA_UART_RS485_GPIO mode and wait
+ * the configured delay before sending
+ *
+ * @param dev uart context
+ */
+void mraa_uart_rs485_begin(mraa_uart_context dev);
+
+/**
+ * Wait until the transmitter is empty, hold DE for the configured delay
+ * and release it
+ *
+ * @param dev uart context
+ * @param sent bytes just written, for the wire time estimate
+ */
+void mraa_uart_rs485_end(mraa_uart_context dev, int sent);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "common.h"
+
+/**
+ * Set input and output speed of a tty to any integer rate using the
+ * termios2 BOTHER interface. Lives in its own file as the kernel termios2
+ * definitions clash with the libc <termios.h> ones.
+ *
+ * @param fd tty file descriptor
+ * @param baud rate in bits per second
+ * @return MRAA_ERROR_FEATURE_NOT_SUPPORTED if the kernel or the driver
+ * lacks termios2, so the caller can fall back to the B* constants
+ */
+mraa_result_t mraa_uart_termios2_set_speed(int fd, unsigned int baud);
+
+/**
+ * Read back the output speed of a tty as stored by the driver, which may
+ * differ from the rate last requested when the divisor can't match it
+ *
+ * @param fd tty file descriptor
+ * @return rate in bits per second, 0 if termios2 is not available
+ */
+unsigned int mraa_uart_termios2_get_speed(int fd);
+
+#ifdef __cplusplus
+}
+#endif
@@ -11,13 +11,34 @@
 #include <errno.h>
 
 #include "aio.h"
+#include "aio/aio_filter.h"
 #include "mraa_internal.h"
 
 #define DEFAULT_BITS 10
 
-static int raw_bits;
-static unsigned int shifter_value;
-static float max_analog_value;
+// Work out once how raw ADC values map to value_bit, so that reads only
+// shift. Boards that replace reads return scaled values already.
+static void
+aio_update_scale(mraa_aio_context dev)
+{
+    float max_analog_value;
+
+    dev->shift_left = 0;
+    dev->shift_right = 0;
+    if (dev->raw_bits < dev->value_bit) {
+        dev->shift_left = dev->value_bit - dev->raw_bits;
+        max_analog_value = ((1 << dev->raw_bits) - 1) << dev->shift_left;
+    } else {
+        dev->shift_right = dev->raw_bits - dev->value_bit;
+        max_analog_value = ((1 << dev->raw_bits) - 1) >> dev->shift_right;
+    }
+    dev->float_scale = 1.0f / max_analog_value;
+
+    if (IS_FUNC_DEFINED(dev, aio_read_replace)) {
+        dev->shift_left = 0;
+        dev->shift_right = 0;
+    }
+}
 
 static mraa_result_t
 aio_get_valid_fp(mraa_aio_context dev)
@@ -144,21 +165,15 @@ mraa_aio_init(unsigned int aio)
         }
     }
 
-    raw_bits = mraa_adc_raw_bits();
-
-    if (raw_bits < dev->value_bit) {
-        shifter_value = dev->value_bit - raw_bits;
-        max_analog_value = ((1 << raw_bits) - 1) << shifter_value;
-    } else {
-        shifter_value = raw_bits - dev->value_bit;
-        max_analog_value = ((1 << raw_bits) - 1) >> shifter_value;
-    }
+    // the ADC of the platform the channel is on, which may be a sub platform
+    dev->raw_bits = board->adc_raw;
+    aio_update_scale(dev);
 
     return dev;
 }
 
 int
-mraa_aio_read(mraa_aio_context dev)
+mraa_aio_read_raw(mraa_aio_context dev)
 {
     if (dev == NULL) {
         syslog(LOG_ERR, "aio: read: context is invalid");
@@ -196,14 +211,19 @@ mraa_aio_read(mraa_aio_context dev)
         return -1;
     }
 
-    /* Adjust the raw analog input reading to supported resolution value*/
-    if (raw_bits < dev->value_bit) {
-        analog_value = analog_value << shifter_value;
-    } else {
-        analog_value = analog_value >> shifter_value;
+    return analog_value;
+}
+
+int
+mraa_aio_read(mraa_aio_context dev)
+{
+    int analog_value = mraa_aio_read_raw(dev);
+    if (analog_value == -1) {
+        return -1;
     }
 
-    return analog_value;
+    /* Adjust the raw analog input reading to supported resolution value*/
+    return ((unsigned int) analog_value << dev->shift_left) >> dev->shift_right;
 }
 
 float
@@ -216,7 +236,7 @@ mraa_aio_read_float(mraa_aio_context dev)
 
     unsigned int analog_value_int = mraa_aio_read(dev);
 
-    return analog_value_int / max_analog_value;
+    return analog_value_int * dev->float_scale;
 }
 
 mraa_result_t
@@ -227,6 +247,10 @@ mraa_aio_close(mraa_aio_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    // the capture thread reads through dev, stop it before dev goes away
+    mraa_aio_stream_stop(dev);
+    mraa_aio_filter_free(dev);
+
     if (IS_FUNC_DEFINED(dev, aio_close_replace)) {
         return dev->advance_func->aio_close_replace(dev);
     }
@@ -248,6 +272,7 @@ mraa_aio_set_bit(mraa_aio_context dev, int bits)
         return MRAA_ERROR_INVALID_RESOURCE;
     }
     dev->value_bit = bits;
+    aio_update_scale(dev);
     return MRAA_SUCCESS;
 }
 
@@ -260,3 +285,44 @@ mraa_aio_get_bit(mraa_aio_context dev)
     }
     return dev->value_bit;
 }
+
+mraa_result_t
+mraa_aio_scale(mraa_aio_context dev, const int32_t* raw, int32_t* values, size_t count)
+{
+    size_t i;
+
+    if (dev == NULL || (count > 0 && (raw == NULL || values == NULL))) {
+        syslog(LOG_ERR, "aio: scale: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    // the same shift for every sample, no branch in the loop so the
+    // compiler can vectorise it
+    const unsigned int left = dev->shift_left;
+    const unsigned int right = dev->shift_right;
+    for (i = 0; i < count; i++) {
+        values[i] = (int32_t) (((uint32_t) raw[i] << left) >> right);
+    }
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_scale_float(mraa_aio_context dev, const int32_t* raw, float* values, size_t count)
+{
+    size_t i;
+
+    if (dev == NULL || (count > 0 && (raw == NULL || values == NULL))) {
+        syslog(LOG_ERR, "aio: scale_float: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    const unsigned int left = dev->shift_left;
+    const unsigned int right = dev->shift_right;
+    const float scale = dev->float_scale;
+    for (i = 0; i < count; i++) {
+        values[i] = (((uint32_t) raw[i] << left) >> right) * scale;
+    }
+
+    return MRAA_SUCCESS;
+}
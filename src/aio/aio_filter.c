@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "aio.h"
+#include "aio/aio_filter.h"
+
+// fraction bits kept through decimation and filtering
+#define AIO_FILTER_FRACTION 8
+// fraction bits of the EMA weight
+#define AIO_FILTER_ALPHA 16
+
+// Raw samples are summed oversampling at a time into one decimated sample
+// with AIO_FILTER_FRACTION fraction bits, which then goes through the
+// filter. All in integers, 64 bits leave room for any ADC width.
+struct _aio_filter {
+    unsigned int oversampling;
+    mraa_aio_filter_t type;
+    unsigned int length;
+    int64_t alpha; /**< EMA weight 2 / (length + 1) */
+
+    int64_t acc;          /**< raw samples summed toward the next decimated one */
+    unsigned int pending; /**< how many */
+
+    int64_t window[MRAA_AIO_FILTER_MAX_LENGTH]; /**< last decimated samples */
+    unsigned int head;                          /**< where the next goes */
+    unsigned int filled;                        /**< how many are in */
+    int64_t sum;                                /**< of the window */
+    int64_t ema;
+};
+
+// Drop the fraction bits, to the nearest
+static int64_t
+_aio_filter_round(int64_t value)
+{
+    return (value + (1 << (AIO_FILTER_FRACTION - 1))) >> AIO_FILTER_FRACTION;
+}
+
+static void
+_aio_filter_reset(struct _aio_filter* f)
+{
+    f->acc = 0;
+    f->pending = 0;
+    f->head = 0;
+    f->filled = 0;
+    f->sum = 0;
+    f->ema = 0;
+}
+
+// Median of the window, insertion sorted into a copy as it is short
+static int64_t
+_aio_filter_median(const struct _aio_filter* f)
+{
+    int64_t sorted[MRAA_AIO_FILTER_MAX_LENGTH];
+    unsigned int i, j;
+
+    for (i = 0; i < f->filled; i++) {
+        int64_t x = f->window[i];
+        for (j = i; j > 0 && sorted[j - 1] > x; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = x;
+    }
+    if (f->filled % 2 == 0) {
+        return (sorted[f->filled / 2 - 1] + sorted[f->filled / 2]) / 2;
+    }
+    return sorted[f->filled / 2];
+}
+
+// Run one decimated sample through the filter
+static int64_t
+_aio_filter_step(struct _aio_filter* f, int64_t x)
+{
+    switch (f->type) {
+        case MRAA_AIO_FILTER_MOVING_AVERAGE:
+        case MRAA_AIO_FILTER_MEDIAN:
+            if (f->filled == f->length) {
+                f->sum -= f->window[f->head];
+            } else {
+                f->filled++;
+            }
+            f->window[f->head] = x;
+            f->sum += x;
+            f->head = (f->head + 1) % f->length;
+            if (f->type == MRAA_AIO_FILTER_MEDIAN) {
+                return _aio_filter_median(f);
+            }
+            return (f->sum + f->filled / 2) / f->filled;
+        case MRAA_AIO_FILTER_EMA:
+            // start from the first sample rather than climb from 0
+            if (f->filled == 0) {
+                f->filled = 1;
+                f->ema = x;
+            } else {
+                f->ema += ((x - f->ema) * f->alpha + (1 << (AIO_FILTER_ALPHA - 1))) >> AIO_FILTER_ALPHA;
+            }
+            return f->ema;
+        default:
+            return x;
+    }
+}
+
+// Add a raw sample, a decimated and filtered sample is ready when it
+// returns true
+static mraa_boolean_t
+_aio_filter_add(struct _aio_filter* f, int32_t raw, int64_t* filtered)
+{
+    f->acc += raw;
+    if (++f->pending < f->oversampling) {
+        return 0;
+    }
+    int64_t x = ((f->acc << AIO_FILTER_FRACTION) + f->oversampling / 2) / f->oversampling;
+    f->acc = 0;
+    f->pending = 0;
+    *filtered = _aio_filter_step(f, x);
+    return 1;
+}
+
+// Take oversampling raw reads and return the filtered sample, with
+// fraction bits
+static mraa_result_t
+_aio_filter_read(mraa_aio_context dev, int64_t* filtered)
+{
+    struct _aio_filter* f = dev->filter;
+    int raw;
+
+    do {
+        raw = mraa_aio_read_raw(dev);
+        if (raw == -1) {
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+    } while (!_aio_filter_add(f, raw, filtered));
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_set_filter(mraa_aio_context dev, unsigned int oversampling, mraa_aio_filter_t type, unsigned int length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: set_filter: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (oversampling < 1 || oversampling > MRAA_AIO_FILTER_MAX_OVERSAMPLING) {
+        syslog(LOG_ERR, "aio: set_filter: oversampling must be 1 to %d", MRAA_AIO_FILTER_MAX_OVERSAMPLING);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    switch (type) {
+        case MRAA_AIO_FILTER_NONE:
+            length = 1;
+            break;
+        case MRAA_AIO_FILTER_MOVING_AVERAGE:
+        case MRAA_AIO_FILTER_EMA:
+        case MRAA_AIO_FILTER_MEDIAN:
+            if (length < 1 || length > MRAA_AIO_FILTER_MAX_LENGTH) {
+                syslog(LOG_ERR, "aio: set_filter: length must be 1 to %d", MRAA_AIO_FILTER_MAX_LENGTH);
+                return MRAA_ERROR_INVALID_PARAMETER;
+            }
+            break;
+        default:
+            syslog(LOG_ERR, "aio: set_filter: unknown filter %d", type);
+            return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (oversampling == 1 && type == MRAA_AIO_FILTER_NONE) {
+        mraa_aio_filter_free(dev);
+        return MRAA_SUCCESS;
+    }
+
+    if (dev->filter == NULL) {
+        dev->filter = calloc(1, sizeof(struct _aio_filter));
+        if (dev->filter == NULL) {
+            syslog(LOG_ERR, "aio: set_filter: failed to allocate memory for filter");
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+    struct _aio_filter* f = dev->filter;
+    f->oversampling = oversampling;
+    f->type = type;
+    f->length = length;
+    f->alpha = (2 << AIO_FILTER_ALPHA) / (length + 1);
+    _aio_filter_reset(f);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_filter_reset(mraa_aio_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: filter_reset: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->filter != NULL) {
+        _aio_filter_reset(dev->filter);
+    }
+
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_aio_read_filtered(mraa_aio_context dev)
+{
+    int64_t filtered;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: read_filtered: context is invalid");
+        return -1;
+    }
+    if (dev->filter == NULL) {
+        return mraa_aio_read(dev);
+    }
+
+    if (_aio_filter_read(dev, &filtered) != MRAA_SUCCESS) {
+        return -1;
+    }
+
+    // scale with the fraction still there, then round as
+    // mraa_aio_filter_samples() does, capped at what mraa_aio_read() can return
+    int64_t value = _aio_filter_round((filtered << dev->shift_left) >> dev->shift_right);
+    int64_t max = (((1LL << dev->raw_bits) - 1) << dev->shift_left) >> dev->shift_right;
+    return (int) (value < max || max <= 0 ? value : max);
+}
+
+float
+mraa_aio_read_filtered_float(mraa_aio_context dev)
+{
+    int64_t filtered;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: read_filtered_float: context is invalid");
+        return -1.0f;
+    }
+    if (dev->filter == NULL) {
+        return mraa_aio_read_float(dev);
+    }
+
+    if (_aio_filter_read(dev, &filtered) != MRAA_SUCCESS) {
+        return -1.0f;
+    }
+
+    // the fraction bits stay, which is where oversampling gains resolution
+    float value = ((filtered << dev->shift_left) >> dev->shift_right) * dev->float_scale / (1 << AIO_FILTER_FRACTION);
+    return value < 1.0f ? value : 1.0f;
+}
+
+int
+mraa_aio_filter_samples(mraa_aio_context dev, const int32_t* raw, int32_t* filtered, int count)
+{
+    int i, n = 0;
+    int64_t value;
+
+    if (dev == NULL || (count > 0 && (raw == NULL || filtered == NULL))) {
+        syslog(LOG_ERR, "aio: filter_samples: context is invalid");
+        return -1;
+    }
+    if (dev->filter == NULL) {
+        if (count > 0 && filtered != raw) {
+            memmove(filtered, raw, count * sizeof(int32_t));
+        }
+        return count > 0 ? count : 0;
+    }
+
+    // filtered never gets ahead of raw, so the two may be the same array
+    for (i = 0; i < count; i++) {
+        if (_aio_filter_add(dev->filter, raw[i], &value)) {
+            filtered[n++] = (int32_t) _aio_filter_round(value);
+        }
+    }
+
+    return n;
+}
+
+void
+mraa_aio_filter_free(mraa_aio_context dev)
+{
+    free(dev->filter);
+    dev->filter = NULL;
+}
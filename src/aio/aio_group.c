@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "aio.h"
+#include "aio/aio_iio.h"
+#include "mraa_internal.h"
+
+// how long a triggered scan may take
+#define AIO_SCAN_TIMEOUT_MS 1000
+
+struct _aio_group {
+    mraa_aio_context* channels;
+    int count;
+    mraa_boolean_t replaced; /**< a board replaces aio reads, go through mraa_aio_read() */
+    mraa_boolean_t buffered; /**< scans come from the IIO buffer */
+    mraa_aio_iio_buffer_t buffer;
+    uint8_t* scan;
+};
+
+mraa_aio_group_context
+mraa_aio_group_init(mraa_aio_context* channels, int count)
+{
+    int i;
+
+    if (channels == NULL || count < 1) {
+        syslog(LOG_ERR, "aio: group_init: no channels");
+        return NULL;
+    }
+    for (i = 0; i < count; i++) {
+        if (channels[i] == NULL) {
+            syslog(LOG_ERR, "aio: group_init: channel context %d is invalid", i);
+            return NULL;
+        }
+    }
+
+    mraa_aio_group_context group = calloc(1, sizeof(struct _aio_group));
+    if (group == NULL) {
+        syslog(LOG_ERR, "aio: group_init: failed to allocate memory for context");
+        return NULL;
+    }
+    group->channels = calloc(count, sizeof(mraa_aio_context));
+    unsigned int* numbers = calloc(count, sizeof(unsigned int));
+    if (group->channels == NULL || numbers == NULL) {
+        syslog(LOG_ERR, "aio: group_init: failed to allocate memory for context");
+        free(numbers);
+        free(group->channels);
+        free(group);
+        return NULL;
+    }
+    memcpy(group->channels, channels, count * sizeof(mraa_aio_context));
+    group->count = count;
+
+    for (i = 0; i < count; i++) {
+        numbers[i] = channels[i]->channel;
+        if (IS_FUNC_DEFINED(channels[i], aio_read_replace)) {
+            group->replaced = 1;
+        }
+    }
+
+    if (!group->replaced && mraa_aio_iio_buffer_open(&group->buffer, numbers, count, 0, 0) == MRAA_SUCCESS) {
+        group->scan = malloc(group->buffer.scan_size);
+        if (group->scan != NULL) {
+            group->buffered = 1;
+        } else {
+            mraa_aio_iio_buffer_close(&group->buffer);
+        }
+    }
+    free(numbers);
+
+    return group;
+}
+
+int
+mraa_aio_group_read(mraa_aio_group_context group, int32_t* samples, uint64_t* timestamp)
+{
+    int i;
+
+    if (group == NULL || samples == NULL) {
+        syslog(LOG_ERR, "aio: group_read: context is invalid");
+        return -1;
+    }
+
+    if (timestamp != NULL) {
+        *timestamp = mraa_monotonic_ns();
+    }
+
+    if (group->buffered) {
+        if (mraa_aio_iio_buffer_trigger(&group->buffer, group->scan, AIO_SCAN_TIMEOUT_MS) != MRAA_SUCCESS) {
+            return -1;
+        }
+        mraa_aio_iio_buffer_unpack(&group->buffer, group->scan, samples);
+        return group->count;
+    }
+
+    for (i = 0; i < group->count; i++) {
+        mraa_aio_context dev = group->channels[i];
+
+        if (group->replaced) {
+            samples[i] = mraa_aio_read(dev);
+            if (samples[i] == -1) {
+                return -1;
+            }
+            continue;
+        }
+
+        // one pread per channel rather than seek, read and seek again
+        char buffer[17];
+        ssize_t len = pread(dev->adc_in_fp, buffer, sizeof(buffer) - 1, 0);
+        if (len < 1) {
+            syslog(LOG_ERR, "aio: group_read: failed to read channel %u", dev->channel);
+            return -1;
+        }
+        buffer[len] = '\0';
+
+        char* end;
+        errno = 0;
+        samples[i] = (int32_t) strtol(buffer, &end, 10);
+        if (end == buffer || errno != 0) {
+            syslog(LOG_ERR, "aio: group_read: channel %u value is not a decimal number", dev->channel);
+            return -1;
+        }
+    }
+
+    return group->count;
+}
+
+int
+mraa_aio_group_get_count(mraa_aio_group_context group)
+{
+    if (group == NULL) {
+        syslog(LOG_ERR, "aio: group_get_count: context is invalid");
+        return -1;
+    }
+
+    return group->count;
+}
+
+mraa_boolean_t
+mraa_aio_group_is_buffered(mraa_aio_group_context group)
+{
+    if (group == NULL) {
+        syslog(LOG_ERR, "aio: group_is_buffered: context is invalid");
+        return 0;
+    }
+
+    return group->buffered;
+}
+
+mraa_result_t
+mraa_aio_group_close(mraa_aio_group_context group)
+{
+    if (group == NULL) {
+        syslog(LOG_ERR, "aio: group_close: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (group->buffered) {
+        mraa_aio_iio_buffer_close(&group->buffer);
+    }
+    free(group->scan);
+    free(group->channels);
+    free(group);
+
+    return MRAA_SUCCESS;
+}
@@ -0,0 +1,532 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "aio/aio_iio.h"
+#include "iio.h"
+#include "mraa_internal.h"
+
+#define MAX_SIZE 256
+#define IIO_DEVICES "/sys/bus/iio/devices/"
+#define IIO_SYSFS_TRIGGER IIO_DEVICES "iio_sysfs_trigger/add_trigger"
+#define IIO_SYSFS_TRIGGER_REMOVE IIO_DEVICES "iio_sysfs_trigger/remove_trigger"
+#define IIO_CONFIGFS_HRTIMER "/sys/kernel/config/iio/triggers/hrtimer/"
+// scans the buffer holds, a scan is read right after it is triggered
+#define AIO_BUFFER_LENGTH 16
+
+// channel of the timestamp scan element
+#define AIO_TIMESTAMP -2
+
+// an enabled scan element while the layout is worked out
+struct _aio_iio_scan_element {
+    int index;
+    int channel; // voltage channel number, AIO_TIMESTAMP or -1 for other elements
+};
+
+static mraa_result_t
+_aio_iio_write(const char* path, const char* value)
+{
+    int fd = open(path, O_WRONLY);
+    if (fd == -1) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    ssize_t len = strlen(value);
+    mraa_result_t ret = write(fd, value, len) == len ? MRAA_SUCCESS : MRAA_ERROR_INVALID_RESOURCE;
+    close(fd);
+    return ret;
+}
+
+static int
+_aio_iio_read(const char* path, char* value, size_t size)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        return -1;
+    }
+    ssize_t len = read(fd, value, size - 1);
+    close(fd);
+    if (len < 0) {
+        return -1;
+    }
+    value[len] = '\0';
+    // drop the newline
+    if (len > 0 && value[len - 1] == '\n') {
+        value[--len] = '\0';
+    }
+    return len;
+}
+
+mraa_result_t
+mraa_aio_iio_parse_type(const char* type, mraa_aio_iio_element_t* element)
+{
+    char endian, sign;
+    int bits, storage, shift = 0;
+
+    if (sscanf(type, "%ce:%c%d/%d>>%d", &endian, &sign, &bits, &storage, &shift) < 4) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    if (storage != 8 && storage != 16 && storage != 32 && storage != 64) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    element->bytes = storage / 8;
+    element->bits = bits;
+    element->shift = shift;
+    element->is_signed = sign == 's';
+    element->big_endian = endian == 'b';
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_aio_iio_scan_layout(mraa_aio_iio_element_t* elements, int count)
+{
+    int location = 0, largest = 1;
+    int i;
+
+    // each aligned to its own size, the scan padded to the largest one
+    for (i = 0; i < count; i++) {
+        location = (location + elements[i].bytes - 1) / elements[i].bytes * elements[i].bytes;
+        elements[i].location = location;
+        location += elements[i].bytes;
+        if (elements[i].bytes > largest) {
+            largest = elements[i].bytes;
+        }
+    }
+    return (location + largest - 1) / largest * largest;
+}
+
+// Work out where the enabled scan elements sit in a scan, the kernel puts
+// them in index order
+static mraa_result_t
+_aio_iio_layout(mraa_aio_iio_buffer_t* buf)
+{
+    char path[MAX_SIZE], value[32];
+    struct dirent* ent;
+    int i;
+
+    snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements", MRAA_AIO_IIO_DEVICE);
+    DIR* dir = opendir(path);
+    if (dir == NULL) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    int size = 0, count = 0;
+    struct _aio_iio_scan_element* enabled = NULL;
+    mraa_aio_iio_element_t* elements = NULL;
+
+    while ((ent = readdir(dir)) != NULL) {
+        size_t len = strlen(ent->d_name);
+        if (len < 4 || strcmp(ent->d_name + len - 3, "_en") != 0) {
+            continue;
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "%.*s", (int) len - 3, ent->d_name);
+
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/%s_en", MRAA_AIO_IIO_DEVICE, name);
+        if (_aio_iio_read(path, value, sizeof(value)) < 1 || value[0] != '1') {
+            continue;
+        }
+
+        if (count == size) {
+            size = size ? size * 2 : 16;
+            void* grown = realloc(enabled, size * sizeof(*enabled));
+            if (grown != NULL) {
+                enabled = grown;
+                grown = realloc(elements, size * sizeof(*elements));
+            }
+            if (grown == NULL) {
+                free(enabled);
+                free(elements);
+                closedir(dir);
+                return MRAA_ERROR_NO_RESOURCES;
+            }
+            elements = grown;
+        }
+
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/%s_index", MRAA_AIO_IIO_DEVICE, name);
+        if (_aio_iio_read(path, value, sizeof(value)) < 1) {
+            continue;
+        }
+        enabled[count].index = atoi(value);
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/%s_type", MRAA_AIO_IIO_DEVICE, name);
+        if (_aio_iio_read(path, value, sizeof(value)) < 1 ||
+            mraa_aio_iio_parse_type(value, &elements[count]) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "aio: scan element %s has no usable type", name);
+            free(enabled);
+            free(elements);
+            closedir(dir);
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        enabled[count].channel = strcmp(name, "in_timestamp") == 0 ? AIO_TIMESTAMP : -1;
+        if (strncmp(name, "in_voltage", 10) == 0) {
+            char* end;
+            long channel = strtol(name + 10, &end, 10);
+            if (end != name + 10 && *end == '\0') {
+                enabled[count].channel = channel;
+            }
+        }
+        count++;
+    }
+    closedir(dir);
+
+    // order by index, the lists are short
+    int j;
+    for (i = 1; i < count; i++) {
+        for (j = i; j > 0 && enabled[j - 1].index > enabled[j].index; j--) {
+            struct _aio_iio_scan_element tmp = enabled[j];
+            enabled[j] = enabled[j - 1];
+            enabled[j - 1] = tmp;
+            mraa_aio_iio_element_t element = elements[j];
+            elements[j] = elements[j - 1];
+            elements[j - 1] = element;
+        }
+    }
+
+    buf->scan_size = mraa_aio_iio_scan_layout(elements, count);
+
+    for (i = 0; i < count; i++) {
+        if (enabled[i].channel == AIO_TIMESTAMP && elements[i].bytes == 8) {
+            buf->timestamp_location = elements[i].location;
+        }
+    }
+
+    mraa_result_t ret = MRAA_SUCCESS;
+    for (i = 0; i < buf->count && ret == MRAA_SUCCESS; i++) {
+        ret = MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        for (j = 0; j < count; j++) {
+            if (enabled[j].channel == (int) buf->channels[i]) {
+                buf->elements[i] = elements[j];
+                ret = MRAA_SUCCESS;
+                break;
+            }
+        }
+    }
+    free(enabled);
+    free(elements);
+
+    return ret;
+}
+
+// Find the trigger device of a trigger name, returns its number or -1
+static int
+_aio_iio_find_trigger(const char* name)
+{
+    char path[MAX_SIZE], value[MAX_SIZE];
+    struct dirent* ent;
+    int found = -1;
+
+    DIR* dir = opendir(IIO_DEVICES);
+    if (dir == NULL) {
+        return -1;
+    }
+    while ((ent = readdir(dir)) != NULL && found < 0) {
+        int num;
+        if (sscanf(ent->d_name, "trigger%d", &num) != 1) {
+            continue;
+        }
+        snprintf(path, MAX_SIZE, IIO_DEVICES "%.64s/name", ent->d_name);
+        if (_aio_iio_read(path, value, sizeof(value)) > 0 && strcmp(value, name) == 0) {
+            found = num;
+        }
+    }
+    closedir(dir);
+
+    return found;
+}
+
+// Remove the hrtimer trigger if it was created for this buffer
+static void
+_aio_iio_hrtimer_remove(mraa_aio_iio_buffer_t* buf)
+{
+    char path[MAX_SIZE];
+
+    if (buf->hrtimer_created) {
+        snprintf(path, MAX_SIZE, IIO_CONFIGFS_HRTIMER "mraa-aio%d", MRAA_AIO_IIO_DEVICE);
+        if (rmdir(path) != 0) {
+            syslog(LOG_WARNING, "aio: failed to remove trigger %s: %s", path, strerror(errno));
+        }
+        buf->hrtimer_created = 0;
+    }
+}
+
+// Attach an hrtimer trigger running at rate_hz, created through configfs
+static mraa_result_t
+_aio_iio_hrtimer(mraa_aio_iio_buffer_t* buf, unsigned int rate_hz)
+{
+#if !defined(PERIPHERALMAN)
+    char path[MAX_SIZE], value[32], trigger[32];
+
+    snprintf(trigger, sizeof(trigger), "mraa-aio%d", MRAA_AIO_IIO_DEVICE);
+    snprintf(path, MAX_SIZE, "hrtimer/%s", trigger);
+    // one left by someone else is used but not removed
+    int num = _aio_iio_find_trigger(trigger);
+    if (num < 0) {
+        if (mraa_iio_create_trigger(NULL, path) != MRAA_SUCCESS) {
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        buf->hrtimer_created = 1;
+        num = _aio_iio_find_trigger(trigger);
+    }
+    if (num < 0) {
+        _aio_iio_hrtimer_remove(buf);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    snprintf(path, MAX_SIZE, IIO_DEVICES "trigger%d/sampling_frequency", num);
+    snprintf(value, sizeof(value), "%u", rate_hz);
+    if (_aio_iio_write(path, value) != MRAA_SUCCESS) {
+        _aio_iio_hrtimer_remove(buf);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/trigger/current_trigger", MRAA_AIO_IIO_DEVICE);
+    if (_aio_iio_write(path, trigger) != MRAA_SUCCESS) {
+        _aio_iio_hrtimer_remove(buf);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    buf->trigger_set = 1;
+    buf->hrtimer = 1;
+    return MRAA_SUCCESS;
+#else
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+#endif
+}
+
+// Attach a sysfs trigger of our own, numbered after the device. One that
+// is already there is used but not removed.
+static mraa_result_t
+_aio_iio_sysfs_trigger(mraa_aio_iio_buffer_t* buf)
+{
+    char path[MAX_SIZE], value[32], trigger[32];
+
+    snprintf(trigger, sizeof(trigger), "sysfstrig%d", MRAA_AIO_IIO_DEVICE);
+    int num = _aio_iio_find_trigger(trigger);
+    if (num < 0) {
+        snprintf(value, sizeof(value), "%d", MRAA_AIO_IIO_DEVICE);
+        buf->sysfs_trig_added = _aio_iio_write(IIO_SYSFS_TRIGGER, value) == MRAA_SUCCESS;
+        num = _aio_iio_find_trigger(trigger);
+    }
+    if (num < 0) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    snprintf(path, MAX_SIZE, IIO_DEVICES "trigger%d/trigger_now", num);
+    buf->trigger_now_fd = open(path, O_WRONLY);
+    if (buf->trigger_now_fd == -1) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/trigger/current_trigger", MRAA_AIO_IIO_DEVICE);
+    if (_aio_iio_write(path, trigger) != MRAA_SUCCESS) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    buf->trigger_set = 1;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_iio_buffer_open(mraa_aio_iio_buffer_t* buf, const unsigned int* channels, int count, unsigned int rate_hz, int length)
+{
+    char path[MAX_SIZE], value[MAX_SIZE];
+    int i;
+
+    memset(buf, 0, sizeof(*buf));
+    buf->fd = -1;
+    buf->trigger_now_fd = -1;
+    buf->timestamp_location = -1;
+
+    // no buffer, or someone else is using it
+    snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/buffer/enable", MRAA_AIO_IIO_DEVICE);
+    if (_aio_iio_read(path, value, sizeof(value)) < 1 || value[0] != '0') {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    buf->count = count;
+    buf->elements = calloc(count, sizeof(mraa_aio_iio_element_t));
+    buf->channels = calloc(count, sizeof(unsigned int));
+    if (buf->elements == NULL || buf->channels == NULL) {
+        mraa_aio_iio_buffer_close(buf);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    memcpy(buf->channels, channels, count * sizeof(unsigned int));
+
+    for (i = 0; i < count; i++) {
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/in_voltage%u_en", MRAA_AIO_IIO_DEVICE,
+                 channels[i]);
+        if (_aio_iio_write(path, "1") != MRAA_SUCCESS) {
+            syslog(LOG_NOTICE, "aio: channel %u can't be captured in the IIO buffer", channels[i]);
+            mraa_aio_iio_buffer_close(buf);
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+    }
+
+    // continuous capture wants the kernel's time of every scan, on the
+    // monotonic clock where the driver lets us choose
+    if (rate_hz > 0) {
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/in_timestamp_en", MRAA_AIO_IIO_DEVICE);
+        buf->timestamp_enabled = _aio_iio_write(path, "1") == MRAA_SUCCESS;
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/current_timestamp_clock", MRAA_AIO_IIO_DEVICE);
+        _aio_iio_write(path, "monotonic\n");
+    }
+
+    if ((rate_hz == 0 || _aio_iio_hrtimer(buf, rate_hz) != MRAA_SUCCESS) && _aio_iio_sysfs_trigger(buf) != MRAA_SUCCESS) {
+        syslog(LOG_NOTICE, "aio: no trigger for the IIO buffer");
+        mraa_aio_iio_buffer_close(buf);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (_aio_iio_layout(buf) != MRAA_SUCCESS) {
+        mraa_aio_iio_buffer_close(buf);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/buffer/length", MRAA_AIO_IIO_DEVICE);
+    snprintf(value, sizeof(value), "%d", length > 0 ? length : AIO_BUFFER_LENGTH);
+    _aio_iio_write(path, value);
+
+    snprintf(path, MAX_SIZE, "/dev/iio:device%d", MRAA_AIO_IIO_DEVICE);
+    buf->fd = open(path, O_RDONLY | O_NONBLOCK);
+    snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/buffer/enable", MRAA_AIO_IIO_DEVICE);
+    if (buf->fd == -1 || _aio_iio_write(path, "1") != MRAA_SUCCESS) {
+        syslog(LOG_NOTICE, "aio: failed to enable the IIO buffer");
+        mraa_aio_iio_buffer_close(buf);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+void
+mraa_aio_iio_buffer_close(mraa_aio_iio_buffer_t* buf)
+{
+    char path[MAX_SIZE];
+    int i;
+
+    if (buf->fd != -1) {
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/buffer/enable", MRAA_AIO_IIO_DEVICE);
+        _aio_iio_write(path, "0");
+        close(buf->fd);
+        buf->fd = -1;
+    }
+    if (buf->trigger_set) {
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/trigger/current_trigger", MRAA_AIO_IIO_DEVICE);
+        _aio_iio_write(path, "\n");
+        buf->trigger_set = 0;
+    }
+    if (buf->trigger_now_fd != -1) {
+        close(buf->trigger_now_fd);
+        buf->trigger_now_fd = -1;
+    }
+    _aio_iio_hrtimer_remove(buf);
+    if (buf->sysfs_trig_added) {
+        snprintf(path, MAX_SIZE, "%d", MRAA_AIO_IIO_DEVICE);
+        _aio_iio_write(IIO_SYSFS_TRIGGER_REMOVE, path);
+        buf->sysfs_trig_added = 0;
+    }
+    if (buf->timestamp_enabled) {
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/in_timestamp_en", MRAA_AIO_IIO_DEVICE);
+        _aio_iio_write(path, "0");
+        buf->timestamp_enabled = 0;
+    }
+    for (i = 0; buf->channels != NULL && i < buf->count; i++) {
+        snprintf(path, MAX_SIZE, IIO_DEVICES "iio:device%d/scan_elements/in_voltage%u_en", MRAA_AIO_IIO_DEVICE,
+                 buf->channels[i]);
+        _aio_iio_write(path, "0");
+    }
+    free(buf->elements);
+    free(buf->channels);
+    buf->elements = NULL;
+    buf->channels = NULL;
+    buf->count = 0;
+}
+
+mraa_result_t
+mraa_aio_iio_buffer_fire(mraa_aio_iio_buffer_t* buf)
+{
+    if (pwrite(buf->trigger_now_fd, "1", 1, 0) != 1) {
+        syslog(LOG_ERR, "aio: failed to trigger a scan: %s", strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_aio_iio_buffer_read(mraa_aio_iio_buffer_t* buf, uint8_t* scans, int max_scans, int timeout_ms)
+{
+    for (;;) {
+        ssize_t len = read(buf->fd, scans, (size_t) max_scans * buf->scan_size);
+        if (len > 0 && len % buf->scan_size == 0) {
+            return len / buf->scan_size;
+        }
+        if (len >= 0 || (errno != EAGAIN && errno != EINTR)) {
+            syslog(LOG_ERR, "aio: failed to read a scan");
+            return -1;
+        }
+        struct pollfd pfd = { buf->fd, POLLIN, 0 };
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready == 0) {
+            return 0;
+        } else if (ready < 0 && errno != EINTR) {
+            return -1;
+        }
+    }
+}
+
+mraa_result_t
+mraa_aio_iio_buffer_trigger(mraa_aio_iio_buffer_t* buf, uint8_t* scan, int timeout_ms)
+{
+    mraa_result_t ret = mraa_aio_iio_buffer_fire(buf);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+
+    int scans = mraa_aio_iio_buffer_read(buf, scan, 1, timeout_ms);
+    if (scans == 0) {
+        return MRAA_ERROR_NO_DATA_AVAILABLE;
+    }
+    return scans == 1 ? MRAA_SUCCESS : MRAA_ERROR_INVALID_RESOURCE;
+}
+
+int64_t
+mraa_aio_iio_buffer_timestamp(const mraa_aio_iio_buffer_t* buf, const uint8_t* scan)
+{
+    int64_t timestamp;
+
+    if (buf->timestamp_location < 0) {
+        return -1;
+    }
+    // the timestamp is a native endian s64
+    memcpy(&timestamp, scan + buf->timestamp_location, sizeof(timestamp));
+    return timestamp;
+}
+
+void
+mraa_aio_iio_buffer_unpack(const mraa_aio_iio_buffer_t* buf, const uint8_t* scan, int32_t* samples)
+{
+    int i, b;
+
+    for (i = 0; i < buf->count; i++) {
+        const mraa_aio_iio_element_t* element = &buf->elements[i];
+        const uint8_t* data = scan + element->location;
+        uint64_t value = 0;
+
+        for (b = 0; b < element->bytes; b++) {
+            int at = element->big_endian ? b : element->bytes - 1 - b;
+            value = (value << 8) | data[at];
+        }
+        value >>= element->shift;
+        if (element->bits < 64) {
+            value &= (1ULL << element->bits) - 1;
+            if (element->is_signed && (value & (1ULL << (element->bits - 1)))) {
+                value |= ~((1ULL << element->bits) - 1);
+            }
+        }
+        samples[i] = (int32_t) value;
+    }
+}
@@ -0,0 +1,416 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "aio.h"
+#include "aio/aio_iio.h"
+#include "mraa_internal.h"
+
+// scans taken from the IIO buffer with one read()
+#define AIO_STREAM_BATCH 64
+// scans the kernel buffer holds, about a tenth of a second at 10 kHz
+#define AIO_STREAM_BUFFER_LENGTH 1024
+// how often the thread looks at the stop flag while nothing arrives
+#define AIO_STREAM_POLL_MS 100
+// fastest rate that still gives a period of a nanosecond
+#define AIO_STREAM_MAX_RATE 1000000000U
+
+enum _aio_stream_source {
+    AIO_STREAM_HRTIMER, /**< the kernel takes the scans at the rate */
+    AIO_STREAM_TRIGGER, /**< the thread fires a sysfs trigger at the rate */
+    AIO_STREAM_POLLED   /**< the thread reads the channel at the rate */
+};
+
+// One capture per context. Samples go either into the ring the caller
+// gave, which mraa_aio_stream_read() drains, or to the callback straight
+// from the thread.
+struct _aio_stream {
+    mraa_aio_context dev;
+    enum _aio_stream_source source;
+    uint64_t period_ns;
+    mraa_aio_iio_buffer_t buffer;
+    uint8_t* scans;
+    mraa_aio_group_context group; /**< the polled source reads through a group of one */
+
+    int32_t* ring;
+    size_t ring_size;
+    size_t head;  /**< oldest sample */
+    size_t count; /**< samples waiting */
+    void (*fptr)(mraa_aio_context, const int32_t*, int, uint64_t, void*);
+    void* args;
+
+    mraa_aio_stream_stats_t stats;
+    uint64_t last_timestamp; /**< of the last sample, 0 before the first */
+    mraa_boolean_t stop;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    pthread_t thread;
+};
+
+static void
+_aio_stream_to_timespec(uint64_t ns, struct timespec* ts)
+{
+    ts->tv_sec = ns / 1000000000ULL;
+    ts->tv_nsec = ns % 1000000000ULL;
+}
+
+// Count the samples missed between the last one and one taken at
+// timestamp, half a period late is still on time
+static void
+_aio_stream_check_gap(struct _aio_stream* st, uint64_t timestamp)
+{
+    if (st->last_timestamp != 0 && timestamp > st->last_timestamp) {
+        uint64_t periods = (timestamp - st->last_timestamp + st->period_ns / 2) / st->period_ns;
+        if (periods > 1) {
+            st->stats.overruns += periods - 1;
+        }
+    }
+    st->last_timestamp = timestamp;
+}
+
+// Hand samples taken at the rate from timestamp on to the ring or the
+// callback
+static void
+_aio_stream_deliver(struct _aio_stream* st, const int32_t* samples, int count, uint64_t timestamp)
+{
+    int i;
+
+    pthread_mutex_lock(&st->lock);
+    st->stats.samples += count;
+    if (st->ring != NULL) {
+        for (i = 0; i < count; i++) {
+            if (st->count == st->ring_size) {
+                // the reader keeps what it hasn't read, newer samples are lost
+                st->stats.dropped += count - i;
+                break;
+            }
+            st->ring[(st->head + st->count) % st->ring_size] = samples[i];
+            st->count++;
+        }
+        pthread_cond_broadcast(&st->cond);
+    }
+    pthread_mutex_unlock(&st->lock);
+
+    if (st->fptr != NULL) {
+        st->fptr(st->dev, samples, count, timestamp, st->args);
+    }
+}
+
+// Take one sample when the thread paces the capture
+static mraa_result_t
+_aio_stream_sample(struct _aio_stream* st, int32_t* sample, uint64_t* timestamp)
+{
+    if (st->source == AIO_STREAM_POLLED) {
+        return mraa_aio_group_read(st->group, sample, timestamp) == 1 ? MRAA_SUCCESS : MRAA_ERROR_UNSPECIFIED;
+    }
+
+    mraa_result_t ret = mraa_aio_iio_buffer_trigger(&st->buffer, st->scans, AIO_STREAM_POLL_MS);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    mraa_aio_iio_buffer_unpack(&st->buffer, st->scans, sample);
+    int64_t ts = mraa_aio_iio_buffer_timestamp(&st->buffer, st->scans);
+    *timestamp = ts > 0 ? (uint64_t) ts : mraa_monotonic_ns();
+    return MRAA_SUCCESS;
+}
+
+// The kernel takes the scans, read them as they come
+static void
+_aio_stream_run_hrtimer(struct _aio_stream* st)
+{
+    int32_t samples[AIO_STREAM_BATCH];
+    int i;
+
+    while (!st->stop) {
+        int n = mraa_aio_iio_buffer_read(&st->buffer, st->scans, AIO_STREAM_BATCH, AIO_STREAM_POLL_MS);
+        if (n < 0) {
+            syslog(LOG_ERR, "aio%u: stream: IIO buffer read failed, stopping", st->dev->channel);
+            return;
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        uint64_t first = 0;
+        pthread_mutex_lock(&st->lock);
+        for (i = 0; i < n; i++) {
+            const uint8_t* scan = st->scans + i * st->buffer.scan_size;
+            int64_t ts = mraa_aio_iio_buffer_timestamp(&st->buffer, scan);
+            uint64_t timestamp = ts > 0 ? (uint64_t) ts : mraa_monotonic_ns();
+            if (i == 0) {
+                first = timestamp;
+            }
+            // a full kernel buffer drops scans, which shows as a gap
+            _aio_stream_check_gap(st, timestamp);
+            mraa_aio_iio_buffer_unpack(&st->buffer, scan, &samples[i]);
+        }
+        pthread_mutex_unlock(&st->lock);
+
+        _aio_stream_deliver(st, samples, n, first);
+    }
+}
+
+// Take a sample every period on an absolute schedule. Waking up late
+// loses the periods already past, those are counted and skipped rather
+// than caught up on in a burst.
+static void
+_aio_stream_run_paced(struct _aio_stream* st)
+{
+    uint64_t next = mraa_monotonic_ns();
+    struct timespec deadline;
+    int32_t sample;
+    uint64_t timestamp;
+
+    pthread_mutex_lock(&st->lock);
+    while (!st->stop) {
+        _aio_stream_to_timespec(next, &deadline);
+        if (pthread_cond_timedwait(&st->cond, &st->lock, &deadline) != ETIMEDOUT) {
+            continue;
+        }
+        uint64_t now = mraa_monotonic_ns();
+        if (now >= next + st->period_ns) {
+            uint64_t missed = (now - next) / st->period_ns;
+            st->stats.overruns += missed;
+            next += missed * st->period_ns;
+        }
+        next += st->period_ns;
+        pthread_mutex_unlock(&st->lock);
+
+        mraa_result_t ret = _aio_stream_sample(st, &sample, &timestamp);
+        if (ret == MRAA_SUCCESS) {
+            _aio_stream_deliver(st, &sample, 1, timestamp);
+        }
+
+        pthread_mutex_lock(&st->lock);
+        if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+            st->stats.overruns++;
+        } else if (ret != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "aio%u: stream: failed to take a sample, stopping", st->dev->channel);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&st->lock);
+}
+
+static void*
+_aio_stream_thread_main(void* arg)
+{
+    struct _aio_stream* st = (struct _aio_stream*) arg;
+
+    if (st->source == AIO_STREAM_HRTIMER) {
+        _aio_stream_run_hrtimer(st);
+    } else {
+        _aio_stream_run_paced(st);
+    }
+
+    // gave up on an error, don't leave readers waiting
+    pthread_mutex_lock(&st->lock);
+    st->stop = 1;
+    pthread_cond_broadcast(&st->cond);
+    pthread_mutex_unlock(&st->lock);
+
+    return NULL;
+}
+
+static void
+_aio_stream_free(struct _aio_stream* st)
+{
+    if (st->group != NULL) {
+        mraa_aio_group_close(st->group);
+    }
+    if (st->buffer.fd != -1) {
+        mraa_aio_iio_buffer_close(&st->buffer);
+    }
+    pthread_cond_destroy(&st->cond);
+    pthread_mutex_destroy(&st->lock);
+    free(st->scans);
+    free(st);
+}
+
+static mraa_result_t
+_aio_stream_start(mraa_aio_context dev,
+                  unsigned int rate_hz,
+                  int32_t* ring,
+                  size_t ring_size,
+                  void (*fptr)(mraa_aio_context, const int32_t*, int, uint64_t, void*),
+                  void* args)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: stream_start: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (rate_hz == 0 || rate_hz > AIO_STREAM_MAX_RATE) {
+        syslog(LOG_ERR, "aio%u: stream_start: rate must be 1 to %u Hz", dev->channel, AIO_STREAM_MAX_RATE);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    if (dev->stream != NULL) {
+        syslog(LOG_ERR, "aio%u: stream_start: already streaming", dev->channel);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    struct _aio_stream* st = calloc(1, sizeof(struct _aio_stream));
+    if (st == NULL) {
+        syslog(LOG_ERR, "aio%u: stream_start: failed to allocate memory for context", dev->channel);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    st->dev = dev;
+    st->period_ns = 1000000000ULL / rate_hz;
+    st->ring = ring;
+    st->ring_size = ring_size;
+    st->fptr = fptr;
+    st->args = args;
+    st->buffer.fd = -1;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&st->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&st->lock, NULL);
+
+    if (!IS_FUNC_DEFINED(dev, aio_read_replace) &&
+        mraa_aio_iio_buffer_open(&st->buffer, &dev->channel, 1, rate_hz, AIO_STREAM_BUFFER_LENGTH) == MRAA_SUCCESS) {
+        st->source = st->buffer.hrtimer ? AIO_STREAM_HRTIMER : AIO_STREAM_TRIGGER;
+        st->scans = malloc((size_t) AIO_STREAM_BATCH * st->buffer.scan_size);
+        if (st->scans == NULL) {
+            syslog(LOG_ERR, "aio%u: stream_start: failed to allocate memory for scans", dev->channel);
+            _aio_stream_free(st);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    } else {
+        st->source = AIO_STREAM_POLLED;
+        st->group = mraa_aio_group_init(&dev, 1);
+        if (st->group == NULL) {
+            _aio_stream_free(st);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+
+    int err = pthread_create(&st->thread, NULL, _aio_stream_thread_main, st);
+    if (err != 0) {
+        syslog(LOG_ERR, "aio%u: stream_start: pthread_create() failed: %s", dev->channel, strerror(err));
+        _aio_stream_free(st);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    dev->stream = st;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_aio_stream_start(mraa_aio_context dev, unsigned int rate_hz, int32_t* ring, size_t ring_size)
+{
+    if (ring == NULL || ring_size == 0) {
+        syslog(LOG_ERR, "aio: stream_start: no ring");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    return _aio_stream_start(dev, rate_hz, ring, ring_size, NULL, NULL);
+}
+
+mraa_result_t
+mraa_aio_stream_start_callback(mraa_aio_context dev,
+                               unsigned int rate_hz,
+                               void (*fptr)(mraa_aio_context dev, const int32_t* samples, int count, uint64_t timestamp, void* args),
+                               void* args)
+{
+    if (fptr == NULL) {
+        syslog(LOG_ERR, "aio: stream_start_callback: no callback");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    return _aio_stream_start(dev, rate_hz, NULL, 0, fptr, args);
+}
+
+int
+mraa_aio_stream_read(mraa_aio_context dev, int32_t* samples, int max, int timeout_ms)
+{
+    if (dev == NULL || dev->stream == NULL || dev->stream->ring == NULL) {
+        syslog(LOG_ERR, "aio: stream_read: context is not streaming into a ring");
+        return -1;
+    }
+    if (samples == NULL || max < 1) {
+        return 0;
+    }
+    struct _aio_stream* st = dev->stream;
+    int n = 0;
+
+    pthread_mutex_lock(&st->lock);
+    if (st->count == 0 && timeout_ms != 0) {
+        struct timespec deadline;
+        _aio_stream_to_timespec(mraa_monotonic_ns() + (uint64_t) timeout_ms * 1000000ULL, &deadline);
+        while (st->count == 0 && !st->stop) {
+            if (timeout_ms > 0) {
+                if (pthread_cond_timedwait(&st->cond, &st->lock, &deadline) == ETIMEDOUT) {
+                    break;
+                }
+            } else {
+                pthread_cond_wait(&st->cond, &st->lock);
+            }
+        }
+    }
+    while (n < max && st->count > 0) {
+        samples[n++] = st->ring[st->head];
+        st->head = (st->head + 1) % st->ring_size;
+        st->count--;
+    }
+    pthread_mutex_unlock(&st->lock);
+
+    return n;
+}
+
+mraa_result_t
+mraa_aio_stream_get_stats(mraa_aio_context dev, mraa_aio_stream_stats_t* stats)
+{
+    if (dev == NULL || dev->stream == NULL || stats == NULL) {
+        syslog(LOG_ERR, "aio: stream_get_stats: context is not streaming");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    pthread_mutex_lock(&dev->stream->lock);
+    *stats = dev->stream->stats;
+    pthread_mutex_unlock(&dev->stream->lock);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_boolean_t
+mraa_aio_stream_is_buffered(mraa_aio_context dev)
+{
+    if (dev == NULL || dev->stream == NULL) {
+        syslog(LOG_ERR, "aio: stream_is_buffered: context is not streaming");
+        return 0;
+    }
+
+    return dev->stream->source != AIO_STREAM_POLLED;
+}
+
+mraa_result_t
+mraa_aio_stream_stop(mraa_aio_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "aio: stream_stop: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    struct _aio_stream* st = dev->stream;
+    if (st == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    pthread_mutex_lock(&st->lock);
+    st->stop = 1;
+    pthread_cond_broadcast(&st->cond);
+    pthread_mutex_unlock(&st->lock);
+    pthread_join(st->thread, NULL);
+
+    dev->stream = NULL;
+    _aio_stream_free(st);
+
+    return MRAA_SUCCESS;
+}
@@ -569,6 +569,9 @@ mraa_iio_create_trigger(mraa_iio_context dev, const char* trigger)
         // we actually don't care if this doesn't succeed, as it just means
         // it's already been initialised
         mkdir(buf, configfs_status.st_mode);
+        if (stat(buf, &configfs_status) == 0) {
+            return MRAA_SUCCESS;
+        }
     }
 
     return MRAA_ERROR_UNSPECIFIED;
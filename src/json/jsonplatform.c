@@ -426,6 +426,20 @@ mraa_init_json_platform_spi(json_object* jobj_spi, mraa_board_t* board, int inde
     } else {
         return ret;
     }
+    // check to see if this SPI is bit-banged over the gpios above
+    if (json_object_object_get_ex(jobj_spi, SOFT_KEY, &jobj_temp)) {
+        if (!json_object_is_type(jobj_temp, json_type_boolean)) {
+            syslog(LOG_ERR, "init_json_platform: Soft SPI key has an incorrect value");
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        if (json_object_get_boolean(jobj_temp)) {
+            if (board->spi_bus[pos].sclk == -1 || board->spi_bus[pos].mosi == -1) {
+                syslog(LOG_ERR, "init_json_platform: Soft SPI %d needs clock and mosi pins", pos);
+                return MRAA_ERROR_INVALID_RESOURCE;
+            }
+            board->spi_bus[pos].soft = 1;
+        }
+    }
     // check to see if this SPI is the default one
     if (json_object_object_get_ex(jobj_spi, DEFAULT_KEY, &jobj_temp)) {
         if (!json_object_is_type(jobj_temp, json_type_boolean)) {
@@ -497,6 +511,18 @@ mraa_init_json_platform_uart(json_object* jobj_uart, mraa_board_t* board, int in
         return ret;
     }
 
+    // Setup the rs485 DE pin, a plain gpio
+    ret = mraa_init_json_platform_get_index(jobj_uart, UART_KEY, DEPIN_KEY, index, &pin,
+                                            board->phy_pin_count - 1);
+    if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+        board->uart_dev[pos].has_de = 0;
+    } else if (ret == MRAA_SUCCESS) {
+        board->uart_dev[pos].de = pin;
+        board->uart_dev[pos].has_de = 1;
+    } else {
+        return ret;
+    }
+
     // Setup the path
     if (json_object_object_get_ex(jobj_uart, UART_PATH_KEY, &jobj_temp)) {
         if (!json_object_is_type(jobj_temp, json_type_string)) {
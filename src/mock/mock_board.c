@@ -41,7 +41,6 @@ mraa_mock_board()
     b->i2c_bus[0].scl = 3;
     b->def_i2c_bus = b->i2c_bus[0].bus_id;
 
-    b->spi_bus_count = 1;
     b->def_spi_bus = 0;
     b->spi_bus[0].bus_id = 0;
     b->spi_bus[0].slave_s = 0;
@@ -49,6 +48,15 @@ mraa_mock_board()
     b->spi_bus[0].mosi = 5;
     b->spi_bus[0].miso = 6;
     b->spi_bus[0].sclk = 7;
+    // bus 1 bit-bangs the same pins as gpios, with mosi looped back to miso
+    b->spi_bus_count = 2;
+    b->spi_bus[1].bus_id = 1;
+    b->spi_bus[1].slave_s = 0;
+    b->spi_bus[1].cs = 4;
+    b->spi_bus[1].mosi = 5;
+    b->spi_bus[1].miso = 5;
+    b->spi_bus[1].sclk = 7;
+    b->spi_bus[1].soft = 1;
 
     b->pwm_default_period = 0;
     b->pwm_max_period = 0;
@@ -58,6 +66,8 @@ mraa_mock_board()
     b->def_uart_dev = 0;
     b->uart_dev[0].rx = 8;
     b->uart_dev[0].tx = 9;
+    b->uart_dev[0].de = 0;
+    b->uart_dev[0].has_de = 1;
     b->uart_dev[0].device_path = UART_DEV_PATH;
 
     b->pins = (mraa_pininfo_t*) malloc(sizeof(mraa_pininfo_t) * MRAA_MOCK_PINCOUNT);
@@ -108,17 +118,16 @@ mraa_mock_board()
     b->adv_func->spi_write_word_replace = &mraa_mock_spi_write_word_replace;
     b->adv_func->spi_transfer_buf_replace = &mraa_mock_spi_transfer_buf_replace;
     b->adv_func->spi_transfer_buf_word_replace = &mraa_mock_spi_transfer_buf_word_replace;
+    b->adv_func->spi_transfer_buf_word32_replace = &mraa_mock_spi_transfer_buf_word32_replace;
+    b->adv_func->spi_buswidth_replace = &mraa_mock_spi_buswidth_replace;
+    b->adv_func->spi_transfer_segments_replace = &mraa_mock_spi_transfer_segments_replace;
     b->adv_func->uart_init_raw_replace = &mraa_mock_uart_init_raw_replace;
     b->adv_func->uart_set_baudrate_replace = &mraa_mock_uart_set_baudrate_replace;
     b->adv_func->uart_flush_replace = &mraa_mock_uart_flush_replace;
     b->adv_func->uart_sendbreak_replace = &mraa_mock_uart_sendbreak_replace;
     b->adv_func->uart_set_flowcontrol_replace = &mraa_mock_uart_set_flowcontrol_replace;
     b->adv_func->uart_set_mode_replace = &mraa_mock_uart_set_mode_replace;
-    b->adv_func->uart_set_non_blocking_replace = &mraa_mock_uart_set_non_blocking_replace;
-    b->adv_func->uart_set_timeout_replace = &mraa_mock_uart_set_timeout_replace;
-    b->adv_func->uart_data_available_replace = &mraa_mock_uart_data_available_replace;
-    b->adv_func->uart_write_replace = &mraa_mock_uart_write_replace;
-    b->adv_func->uart_read_replace = &mraa_mock_uart_read_replace;
+    b->adv_func->uart_stop_pre = &mraa_mock_uart_stop_pre;
 
     // Pin definitions
     int pos = 0;
@@ -148,25 +157,33 @@ mraa_mock_board()
     pos++;
 
     strncpy(b->pins[pos].name, "SPI0CS", 8);
-    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 0, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 1, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].gpio.pinmap = pos;
+    b->pins[pos].gpio.mux_total = 0;
     b->pins[pos].spi.mux_total = 0;
     b->pins[pos].spi.pinmap = 0;
     pos++;
 
     strncpy(b->pins[pos].name, "SPI0MOSI", 8);
-    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 0, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 1, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].gpio.pinmap = pos;
+    b->pins[pos].gpio.mux_total = 0;
     b->pins[pos].spi.mux_total = 0;
     b->pins[pos].spi.pinmap = 0;
     pos++;
 
     strncpy(b->pins[pos].name, "SPI0MISO", 8);
-    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 0, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 1, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].gpio.pinmap = pos;
+    b->pins[pos].gpio.mux_total = 0;
     b->pins[pos].spi.mux_total = 0;
     b->pins[pos].spi.pinmap = 0;
     pos++;
 
     strncpy(b->pins[pos].name, "SPI0SCLK", 8);
-    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 0, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].capabilities = (mraa_pincapabilities_t){ 1, 1, 0, 0, 1, 0, 0, 0 };
+    b->pins[pos].gpio.pinmap = pos;
+    b->pins[pos].gpio.mux_total = 0;
     b->pins[pos].spi.mux_total = 0;
     b->pins[pos].spi.pinmap = 0;
     pos++;
@@ -10,6 +10,10 @@
 
 #include "common.h"
 #include "mock/mock_board_gpio.h"
+#include "mock/mock_board.h"
+
+// Level last driven on each pin, shared by all contexts open on that pin
+static int mock_gpio_level[MRAA_MOCK_PINCOUNT];
 
 mraa_result_t
 mraa_mock_gpio_init_internal_replace(mraa_gpio_context dev, int pin)
@@ -68,6 +72,10 @@ mraa_mock_gpio_read_dir_replace(mraa_gpio_context dev, mraa_gpio_dir_t* dir)
 int
 mraa_mock_gpio_read_replace(mraa_gpio_context dev)
 {
+    // an input sees whatever another context drives onto the same pin
+    if (dev->mock_dir == MRAA_GPIO_IN && dev->pin >= 0 && dev->pin < MRAA_MOCK_PINCOUNT) {
+        return mock_gpio_level[dev->pin];
+    }
     return dev->mock_state;
 }
 
@@ -85,6 +93,9 @@ mraa_mock_gpio_write_replace(mraa_gpio_context dev, int value)
     }
 
     dev->mock_state = value;
+    if (dev->pin >= 0 && dev->pin < MRAA_MOCK_PINCOUNT) {
+        mock_gpio_level[dev->pin] = value;
+    }
     return MRAA_SUCCESS;
 }
 
@@ -59,6 +59,12 @@ mraa_mock_spi_bit_per_word_replace(mraa_spi_context dev, unsigned int bits)
 mraa_result_t
 mraa_mock_spi_lsbmode_replace(mraa_spi_context dev, mraa_boolean_t lsb)
 {
+    // Like Edison and Galileo Gen1, the mock controller can't shift LSB first,
+    // which exercises the generic software bit order fallback
+    if (lsb) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
     dev->lsb = lsb;
     return MRAA_SUCCESS;
 }
@@ -160,3 +166,244 @@ mraa_mock_spi_transfer_buf_word_replace(mraa_spi_context dev, uint16_t* data, ui
 
     return MRAA_SUCCESS;
 }
+
+mraa_result_t
+mraa_mock_spi_transfer_buf_word32_replace(mraa_spi_context dev, uint32_t* data, uint32_t* rxbuf, int length)
+{
+    if (data == NULL) {
+        syslog(LOG_ERR, "spi: transfer_buf_word32: Incoming data is null, cannot proceed");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (length <= 0) {
+        syslog(LOG_ERR, "spi: transfer_buf_word32: Length given is equal to or less than zero, cannot proceed");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (rxbuf != NULL) {
+        // length is given in bytes, but arrays are comprised of 32 bit words
+        int i;
+        for (i = 0; i < (length / 4); ++i) {
+            rxbuf[i] = data[i] ^ MOCK_SPI_REPLY_DATA_MODIFIER_WORD32;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_mock_spi_buswidth_replace(mraa_spi_context dev, mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx)
+{
+    // Narrow to what the mock controller can do, like a real one would
+    dev->tx_nbits = (uint8_t) (tx > MOCK_SPI_MAX_BUSWIDTH ? MOCK_SPI_MAX_BUSWIDTH : tx);
+    dev->rx_nbits = (uint8_t) (rx > MOCK_SPI_MAX_BUSWIDTH ? MOCK_SPI_MAX_BUSWIDTH : rx);
+    return MRAA_SUCCESS;
+}
+
+#define MOCK_FLASH_SR_WIP 0x01
+#define MOCK_FLASH_SR_WEL 0x02
+
+static uint8_t mock_flash[MOCK_SPI_FLASH_SIZE];
+static mraa_boolean_t mock_flash_ready = 0;
+static uint8_t mock_flash_status = 0;
+static int mock_flash_busy = 0;
+static int mock_flash_addr_bytes = 3;
+
+// State of the command currently clocked in while chip select is asserted
+static struct {
+    uint8_t cmd;
+    int pos;
+    uint32_t addr;
+} mock_flash_cs;
+
+// SFDP header, one parameter header and a 16 DWORD basic flash parameter
+// table: 4KiB erase 0x20, 1-1-2 0x3B and 1-1-4 0x6B with 8 dummy clocks,
+// 2Mbit density and 256 byte pages with a typical 32us program time
+static const uint8_t mock_flash_sfdp[] = {
+    'S',  'F',  'D',  'P',  0x06, 0x01, 0x00, 0xFF,
+    0x00, 0x06, 0x01, 0x10, 0x10, 0x00, 0x00, 0xFF,
+    0x01, 0x20, 0x41, 0x00, 0xFF, 0xFF, 0x1F, 0x00,
+    0x00, 0x00, 0x08, 0x6B, 0x08, 0x3B, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x80, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static int
+mock_flash_cmd_addr_bytes(uint8_t cmd)
+{
+    switch (cmd) {
+        case 0x5A:
+            return 3;
+        case 0x02:
+        case 0x03:
+        case 0x0B:
+        case 0x3B:
+        case 0x6B:
+        case 0x20:
+        case 0xD8:
+            return mock_flash_addr_bytes;
+        default:
+            return 0;
+    }
+}
+
+static int
+mock_flash_cmd_dummy_bytes(uint8_t cmd)
+{
+    return (cmd == 0x0B || cmd == 0x3B || cmd == 0x6B || cmd == 0x5A) ? 1 : 0;
+}
+
+static void
+mock_flash_erase(uint32_t addr, uint32_t size)
+{
+    addr = (addr % MOCK_SPI_FLASH_SIZE) & ~(size - 1);
+    memset(mock_flash + addr, 0xFF, size);
+}
+
+/**
+ * Clock one byte into the emulated flash and return the byte it drives
+ */
+static uint8_t
+mock_flash_clock_byte(uint8_t tx)
+{
+    static const uint8_t jedec_id[] = MOCK_SPI_FLASH_JEDEC_ID;
+    int pos = mock_flash_cs.pos++;
+
+    if (pos == 0) {
+        mock_flash_cs.cmd = tx;
+        mock_flash_cs.addr = 0;
+        return 0xFF;
+    }
+
+    uint8_t cmd = mock_flash_cs.cmd;
+    if (cmd == 0x05) {
+        uint8_t status = mock_flash_status;
+        if ((mock_flash_status & MOCK_FLASH_SR_WIP) && --mock_flash_busy <= 0) {
+            mock_flash_status &= ~MOCK_FLASH_SR_WIP;
+        }
+        return status;
+    }
+    // a busy flash only answers status reads
+    if (mock_flash_status & MOCK_FLASH_SR_WIP) {
+        return 0xFF;
+    }
+    if (cmd == 0x9F) {
+        return pos <= (int) sizeof(jedec_id) ? jedec_id[pos - 1] : 0xFF;
+    }
+
+    int addr_bytes = mock_flash_cmd_addr_bytes(cmd);
+    if (pos <= addr_bytes) {
+        mock_flash_cs.addr = (mock_flash_cs.addr << 8) | tx;
+        return 0xFF;
+    }
+    int offset = pos - 1 - addr_bytes - mock_flash_cmd_dummy_bytes(cmd);
+    if (addr_bytes == 0 || offset < 0) {
+        return 0xFF;
+    }
+
+    uint32_t addr = mock_flash_cs.addr;
+    switch (cmd) {
+        case 0x03:
+        case 0x0B:
+        case 0x3B:
+        case 0x6B:
+            return mock_flash[(addr + offset) % MOCK_SPI_FLASH_SIZE];
+        case 0x5A:
+            return (addr + offset) < sizeof(mock_flash_sfdp) ? mock_flash_sfdp[addr + offset] : 0xFF;
+        case 0x02:
+            if (mock_flash_status & MOCK_FLASH_SR_WEL) {
+                // programming can only clear bits and wraps within the page
+                uint32_t page = addr & ~(MOCK_SPI_FLASH_PAGE_SIZE - 1);
+                uint32_t col = (addr + offset) % MOCK_SPI_FLASH_PAGE_SIZE;
+                mock_flash[(page + col) % MOCK_SPI_FLASH_SIZE] &= tx;
+            }
+            return 0xFF;
+        default:
+            return 0xFF;
+    }
+}
+
+/**
+ * Chip select deasserted, latch the command that was clocked in
+ */
+static void
+mock_flash_cs_release()
+{
+    uint8_t cmd = mock_flash_cs.cmd;
+    int complete = mock_flash_cs.pos > mock_flash_cmd_addr_bytes(cmd);
+    int pos = mock_flash_cs.pos;
+    uint32_t addr = mock_flash_cs.addr;
+
+    memset(&mock_flash_cs, 0, sizeof(mock_flash_cs));
+    if (pos == 0 || !complete || (mock_flash_status & MOCK_FLASH_SR_WIP)) {
+        return;
+    }
+
+    switch (cmd) {
+        case 0x06:
+            mock_flash_status |= MOCK_FLASH_SR_WEL;
+            return;
+        case 0x04:
+            mock_flash_status &= ~MOCK_FLASH_SR_WEL;
+            return;
+        case 0xB7:
+            mock_flash_addr_bytes = 4;
+            return;
+        case 0x02:
+        case 0x20:
+        case 0xD8:
+        case 0xC7:
+            break;
+        default:
+            return;
+    }
+
+    if (!(mock_flash_status & MOCK_FLASH_SR_WEL)) {
+        return;
+    }
+    if (cmd == 0x20) {
+        mock_flash_erase(addr, 4096);
+    } else if (cmd == 0xD8) {
+        mock_flash_erase(addr, 65536);
+    } else if (cmd == 0xC7) {
+        mock_flash_erase(0, MOCK_SPI_FLASH_SIZE);
+    }
+    mock_flash_status = MOCK_FLASH_SR_WIP;
+    mock_flash_busy = MOCK_SPI_FLASH_BUSY_POLLS;
+}
+
+mraa_result_t
+mraa_mock_spi_transfer_segments_replace(mraa_spi_context dev, mraa_spi_segment_t* segments, int count)
+{
+    int i, j;
+    for (i = 0; i < count; i++) {
+        if (segments[i].length <= 0) {
+            syslog(LOG_ERR, "spi: transfer_segments: Length given is equal to or less than zero, cannot proceed");
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    if (!mock_flash_ready) {
+        memset(mock_flash, 0xFF, sizeof(mock_flash));
+        mock_flash_ready = 1;
+    }
+
+    for (i = 0; i < count; i++) {
+        for (j = 0; j < segments[i].length; j++) {
+            uint8_t tx = segments[i].txbuf != NULL ? segments[i].txbuf[j] : 0;
+            uint8_t rx = mock_flash_clock_byte(tx);
+            if (segments[i].rxbuf != NULL) {
+                segments[i].rxbuf[j] = rx;
+            }
+        }
+        if (segments[i].cs_change || i == count - 1) {
+            mock_flash_cs_release();
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
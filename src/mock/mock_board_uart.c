@@ -5,85 +5,584 @@
  * SPDX-License-Identifier: MIT
  */
 
+#define _GNU_SOURCE /* posix_openpt() and friends */
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
 
 #include "common.h"
+#include "mraa_internal.h"
 #include "mock/mock_board_uart.h"
 
+// bytes in flight per direction
+#define MOCK_LINE_QUEUE 4096
+// how far ahead of the wire bytes are taken from the pty
+#define MOCK_LINE_TICK_NS 1000000ULL
+// what tcsendbreak(fd, 0) sends
+#define MOCK_LINE_BREAK_MS 250
+// fate of a byte the line loses, parity errors flip a single bit
+#define MOCK_LINE_DROP 0xff
+
+struct mock_uart_dir {
+    uint8_t data[MOCK_LINE_QUEUE];
+    uint64_t due[MOCK_LINE_QUEUE]; /**< when each byte has fully arrived */
+    uint8_t fate[MOCK_LINE_QUEUE]; /**< MOCK_LINE_DROP, or the bits a parity error flips */
+    size_t head;
+    size_t count;
+    uint64_t line_free_ns; /**< when the last queued character leaves the wire */
+};
+
+// Every context opened on the mock UART gets a pty pair, the application
+// side being the pty slave. A thread moves bytes between the pty master
+// and the far end of the line at the rate the baud rate and framing
+// allow, adding the configured latency, drops and parity errors. The far
+// end is a loopback until a test takes it over with
+// mraa_mock_uart_open_peer().
+struct mock_uart_line {
+    mraa_uart_context dev;
+    int master;
+    int peer;    /**< our end of the peer socket pair, -1 in loopback */
+    int wake[2]; /**< pokes the thread after changes */
+    pthread_t thread;
+    pthread_mutex_t lock;
+    mraa_boolean_t stop;
+    uint64_t char_ns;     /**< time of one character on the wire */
+    mraa_boolean_t parity;
+    mraa_mock_uart_line_config_t config;
+    unsigned int seed;
+    mraa_mock_uart_line_stats_t stats;
+    struct mock_uart_dir tx; /**< application to far end */
+    struct mock_uart_dir rx; /**< far end to application */
+    struct mock_uart_line* next;
+};
+
+static pthread_mutex_t mock_lines_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct mock_uart_line* mock_lines = NULL;
+
+static struct mock_uart_line*
+mock_line_find(mraa_uart_context dev)
+{
+    struct mock_uart_line* line;
+
+    pthread_mutex_lock(&mock_lines_lock);
+    for (line = mock_lines; line != NULL && line->dev != dev; line = line->next)
+        ;
+    pthread_mutex_unlock(&mock_lines_lock);
+    return line;
+}
+
+static void
+mock_line_wake(struct mock_uart_line* line)
+{
+    char c = 0;
+    if (write(line->wake[1], &c, 1) < 0) {
+        // pipe full, a wakeup is pending anyway
+    }
+}
+
+// start + data + parity + stop bits
+static void
+mock_line_set_framing(struct mock_uart_line* line, unsigned int baud, int bytesize, mraa_boolean_t parity, int stopbits)
+{
+    line->parity = parity;
+    line->char_ns = (uint64_t) (1 + bytesize + (parity ? 1 : 0) + stopbits) * 1000000000ULL / baud;
+}
+
+static mraa_boolean_t
+mock_line_chance(struct mock_uart_line* line, unsigned int ppm)
+{
+    return ppm > 0 && (uint64_t) rand_r(&line->seed) * 1000000 / ((uint64_t) RAND_MAX + 1) < ppm;
+}
+
+// Decide once, as a byte is queued, whether the line loses or garbles
+// it, so that retrying a delivery the far side couldn't take yet draws
+// nothing new
+static uint8_t
+mock_line_fate(struct mock_uart_line* line)
+{
+    if (mock_line_chance(line, line->config.drop_ppm)) {
+        return MOCK_LINE_DROP;
+    }
+    if (mock_line_chance(line, line->config.parity_ppm)) {
+        return 1 << (rand_r(&line->seed) % 8);
+    }
+    return 0;
+}
+
+// Take what the wire carries over the next tick from fd and queue it with
+// the time each byte will have arrived. Returns the read() result.
+static ssize_t
+mock_line_pull(struct mock_uart_line* line, struct mock_uart_dir* dir, int fd, uint64_t now)
+{
+    uint8_t buf[256];
+    uint64_t start = dir->line_free_ns > now ? dir->line_free_ns : now;
+    size_t want = (now + MOCK_LINE_TICK_NS - start) / line->char_ns + 1;
+
+    if (want > MOCK_LINE_QUEUE - dir->count) {
+        want = MOCK_LINE_QUEUE - dir->count;
+    }
+    if (want > sizeof(buf)) {
+        want = sizeof(buf);
+    }
+
+    ssize_t n = read(fd, buf, want);
+    for (ssize_t i = 0; i < n; i++) {
+        size_t tail = (dir->head + dir->count++) % MOCK_LINE_QUEUE;
+        start += line->char_ns;
+        dir->data[tail] = buf[i];
+        dir->due[tail] = start + (uint64_t) line->config.latency_us * 1000;
+        dir->fate[tail] = mock_line_fate(line);
+    }
+    if (n > 0) {
+        dir->line_free_ns = start;
+    }
+    return n;
+}
+
+// Turn a byte received with a parity error into what the tty layer of the
+// application side makes of it. PARMRK can't be honoured, the pty line
+// discipline would escape the 0xFF of the mark, so it reads as plain INPCK.
+static size_t
+mock_line_parity_error(struct mock_uart_line* line, uint8_t byte, uint8_t flip, uint8_t* out)
+{
+    struct termios termio;
+
+    if (line->parity && tcgetattr(line->master, &termio) == 0 && (termio.c_iflag & INPCK)) {
+        if (termio.c_iflag & IGNPAR) {
+            return 0;
+        }
+        out[0] = 0x00;
+        return 1;
+    }
+    // nothing checks parity, the byte just arrives garbled
+    out[0] = byte ^ flip;
+    return 1;
+}
+
+// Hand over the bytes that have arrived by now. Returns 0 when fd can't
+// take more right now.
+static int
+mock_line_deliver(struct mock_uart_line* line, struct mock_uart_dir* dir, int fd, mraa_boolean_t to_app, uint64_t now)
+{
+    while (dir->count > 0 && dir->due[dir->head] <= now) {
+        uint8_t out[1];
+        uint8_t fate = dir->fate[dir->head];
+        size_t len = 1;
+
+        out[0] = dir->data[dir->head];
+        if (fate == MOCK_LINE_DROP) {
+            len = 0;
+        } else if (fate != 0) {
+            if (to_app) {
+                len = mock_line_parity_error(line, out[0], fate, out);
+            } else {
+                out[0] ^= fate;
+            }
+        }
+        if (len > 0) {
+            ssize_t n = write(fd, out, len);
+            if (n < 0 && errno == EAGAIN) {
+                return 0;
+            }
+            // a byte the other end never got wasn't delivered
+            if (n > 0 && to_app) {
+                line->stats.rx_bytes++;
+            } else if (n > 0) {
+                line->stats.tx_bytes++;
+            }
+        }
+        // counted only once the byte is consumed
+        if (fate == MOCK_LINE_DROP) {
+            line->stats.dropped++;
+        } else if (fate != 0) {
+            line->stats.parity_errors++;
+        }
+        dir->head = (dir->head + 1) % MOCK_LINE_QUEUE;
+        dir->count--;
+    }
+    return 1;
+}
+
+static void*
+mock_line_thread_main(void* arg)
+{
+    struct mock_uart_line* line = (struct mock_uart_line*) arg;
+
+    pthread_mutex_lock(&line->lock);
+    while (!line->stop) {
+        struct pollfd pfds[3];
+        int nfds = 1, tx_slot = -1, rx_slot = -1;
+        int64_t timeout = -1;
+        uint64_t now = mraa_monotonic_ns();
+
+        // in loopback what goes out on the wire comes straight back
+        int tx_out = line->peer >= 0 ? line->peer : line->master;
+        if (!mock_line_deliver(line, &line->tx, tx_out, line->peer < 0, now) ||
+            !mock_line_deliver(line, &line->rx, line->master, 1, now)) {
+            timeout = 1;
+        }
+
+        pfds[0].fd = line->wake[0];
+        pfds[0].events = POLLIN;
+        struct mock_uart_dir* dirs[2] = { &line->tx, &line->rx };
+        int fds[2] = { line->master, line->peer };
+        for (int i = 0; i < 2; i++) {
+            struct mock_uart_dir* dir = dirs[i];
+            if (dir->count > 0) {
+                int64_t left = (int64_t) (dir->due[dir->head] - now) / 1000000 + 1;
+                if (dir->due[dir->head] <= now) {
+                    left = 1;
+                }
+                if (timeout < 0 || left < timeout) {
+                    timeout = left;
+                }
+            }
+            if (fds[i] < 0 || dir->count == MOCK_LINE_QUEUE) {
+                continue;
+            }
+            if (dir->line_free_ns > now + MOCK_LINE_TICK_NS) {
+                // the wire is busy, come back once it frees up
+                int64_t left = (int64_t) (dir->line_free_ns - now - MOCK_LINE_TICK_NS) / 1000000 + 1;
+                if (timeout < 0 || left < timeout) {
+                    timeout = left;
+                }
+                continue;
+            }
+            pfds[nfds].fd = fds[i];
+            pfds[nfds].events = POLLIN;
+            if (i == 0) {
+                tx_slot = nfds;
+            } else {
+                rx_slot = nfds;
+            }
+            nfds++;
+        }
+
+        pthread_mutex_unlock(&line->lock);
+        int ret = poll(pfds, nfds, (int) timeout);
+        pthread_mutex_lock(&line->lock);
+        if (ret <= 0) {
+            continue;
+        }
+
+        if (pfds[0].revents & POLLIN) {
+            char drain[16];
+            while (read(line->wake[0], drain, sizeof(drain)) > 0)
+                ;
+        }
+        now = mraa_monotonic_ns();
+        if (tx_slot > 0 && (pfds[tx_slot].revents & POLLIN)) {
+            mock_line_pull(line, &line->tx, line->master, now);
+        }
+        if (rx_slot > 0 && (pfds[rx_slot].revents & (POLLIN | POLLHUP)) && line->peer == fds[1]) {
+            if (mock_line_pull(line, &line->rx, line->peer, now) == 0) {
+                // the test closed its end, back to loopback
+                close(line->peer);
+                line->peer = -1;
+            }
+        }
+    }
+    pthread_mutex_unlock(&line->lock);
+
+    return NULL;
+}
+
 mraa_result_t
 mraa_mock_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud)
 {
     // Limits are taken from uart.c::uint2speed(), they don't matter much anyway
-    if ((baud < 0) || (baud > 4000000)) {
+    if ((baud == 0) || (baud > 4000000)) {
         syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %i", dev->index, baud);
         return MRAA_ERROR_INVALID_PARAMETER;
     }
 
+    struct mock_uart_line* line = mock_line_find(dev);
+    if (line != NULL) {
+        pthread_mutex_lock(&line->lock);
+        // keep the framing, only the rate changes
+        line->char_ns = line->char_ns * dev->baudrate / baud;
+        pthread_mutex_unlock(&line->lock);
+    }
+    dev->baudrate = baud;
+
     return MRAA_SUCCESS;
 }
 
 mraa_result_t
 mraa_mock_uart_init_raw_replace(mraa_uart_context dev, const char* path)
 {
-    // The only thing we have to do from the original uart_init_raw()
-    return mraa_uart_set_baudrate(dev, 9600);
-}
+    struct termios termio;
+
+    struct mock_uart_line* line = calloc(1, sizeof(struct mock_uart_line));
+    if (line == NULL) {
+        syslog(LOG_CRIT, "uart: mock: Failed to allocate memory for line");
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    line->dev = dev;
+    line->peer = -1;
+    line->wake[0] = line->wake[1] = -1;
+    line->seed = 1;
+    mock_line_set_framing(line, 9600, 8, 0, 1);
+    dev->baudrate = 9600;
+
+    line->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (line->master < 0 || grantpt(line->master) < 0 || unlockpt(line->master) < 0) {
+        syslog(LOG_ERR, "uart: mock: no pseudo terminal: %s", strerror(errno));
+        goto init_raw_cleanup;
+    }
+    dev->fd = open(ptsname(line->master), O_RDWR | O_NOCTTY);
+    if (dev->fd < 0 || tcgetattr(dev->fd, &termio) < 0) {
+        syslog(LOG_ERR, "uart: mock: opening pty slave failed: %s", strerror(errno));
+        goto init_raw_cleanup;
+    }
+    // the same raw setup mraa_uart_init_raw() does on a real port
+    cfmakeraw(&termio);
+    termio.c_cflag |= CLOCAL | CREAD;
+    termio.c_cc[VMIN] = 1;
+    termio.c_cc[VTIME] = 0;
+    tcsetattr(dev->fd, TCSAFLUSH, &termio);
+
+    if (pipe(line->wake) < 0) {
+        line->wake[0] = line->wake[1] = -1;
+        goto init_raw_cleanup;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(line->wake[i], F_SETFL, O_NONBLOCK);
+        fcntl(line->wake[i], F_SETFD, FD_CLOEXEC);
+    }
+    fcntl(line->master, F_SETFL, O_NONBLOCK);
+    fcntl(line->master, F_SETFD, FD_CLOEXEC);
+
+    pthread_mutex_init(&line->lock, NULL);
+    if (pthread_create(&line->thread, NULL, mock_line_thread_main, line) != 0) {
+        pthread_mutex_destroy(&line->lock);
+        goto init_raw_cleanup;
+    }
+
+    pthread_mutex_lock(&mock_lines_lock);
+    line->next = mock_lines;
+    mock_lines = line;
+    pthread_mutex_unlock(&mock_lines_lock);
 
-mraa_result_t
-mraa_mock_uart_flush_replace(mraa_uart_context dev)
-{
     return MRAA_SUCCESS;
+
+init_raw_cleanup:
+    if (dev->fd >= 0) {
+        close(dev->fd);
+        dev->fd = -1;
+    }
+    if (line->master >= 0) {
+        close(line->master);
+    }
+    if (line->wake[0] >= 0) {
+        close(line->wake[0]);
+        close(line->wake[1]);
+    }
+    free(line);
+    return MRAA_ERROR_INVALID_RESOURCE;
 }
 
 mraa_result_t
-mraa_mock_uart_sendbreak_replace(mraa_uart_context dev, int duration)
+mraa_mock_uart_stop_pre(mraa_uart_context dev)
 {
+    struct mock_uart_line** pp;
+    struct mock_uart_line* line = NULL;
+
+    pthread_mutex_lock(&mock_lines_lock);
+    for (pp = &mock_lines; *pp != NULL; pp = &(*pp)->next) {
+        if ((*pp)->dev == dev) {
+            line = *pp;
+            *pp = line->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&mock_lines_lock);
+    if (line == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    pthread_mutex_lock(&line->lock);
+    line->stop = 1;
+    mock_line_wake(line);
+    pthread_mutex_unlock(&line->lock);
+    pthread_join(line->thread, NULL);
+
+    pthread_mutex_destroy(&line->lock);
+    close(line->master);
+    if (line->peer >= 0) {
+        close(line->peer);
+    }
+    close(line->wake[0]);
+    close(line->wake[1]);
+    free(line);
+
     return MRAA_SUCCESS;
 }
 
 mraa_result_t
-mraa_mock_uart_set_flowcontrol_replace(mraa_uart_context dev, mraa_boolean_t xonxoff, mraa_boolean_t rtscts)
+mraa_mock_uart_flush_replace(mraa_uart_context dev)
 {
+    struct mock_uart_line* line = mock_line_find(dev);
+    if (line == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    // like tcdrain(): wait until everything written has left the wire
+    mraa_boolean_t settled = 0;
+    pthread_mutex_lock(&line->lock);
+    for (;;) {
+        int pending = 0;
+        if (ioctl(line->master, FIONREAD, &pending) < 0) {
+            pending = 0;
+        }
+        if (pending == 0 && line->tx.count == 0) {
+            if (settled) {
+                break;
+            }
+            // the pty hands written data over to the master asynchronously,
+            // give what was just written a moment to show up
+            settled = 1;
+            struct pollfd pfd = { line->master, POLLIN, 0 };
+            pthread_mutex_unlock(&line->lock);
+            poll(&pfd, 1, 1);
+            pthread_mutex_lock(&line->lock);
+            continue;
+        }
+        settled = 0;
+        uint64_t wait_us = line->char_ns / 1000 + 100;
+        pthread_mutex_unlock(&line->lock);
+        usleep(wait_us);
+        pthread_mutex_lock(&line->lock);
+    }
+    pthread_mutex_unlock(&line->lock);
+
     return MRAA_SUCCESS;
 }
 
 mraa_result_t
-mraa_mock_uart_set_mode_replace(mraa_uart_context dev, int bytesize, mraa_uart_parity_t parity, int stopbits)
+mraa_mock_uart_sendbreak_replace(mraa_uart_context dev, int duration)
 {
+    struct mock_uart_line* line = mock_line_find(dev);
+    if (line == NULL) {
+        return MRAA_SUCCESS;
+    }
+    if (duration <= 0) {
+        duration = MOCK_LINE_BREAK_MS;
+    }
+
+    // the line is held low for the duration, a break reads as a NUL
+    pthread_mutex_lock(&line->lock);
+    uint64_t now = mraa_monotonic_ns();
+    uint64_t end = (line->tx.line_free_ns > now ? line->tx.line_free_ns : now) + (uint64_t) duration * 1000000;
+    if (line->tx.count < MOCK_LINE_QUEUE) {
+        size_t tail = (line->tx.head + line->tx.count++) % MOCK_LINE_QUEUE;
+        line->tx.data[tail] = 0;
+        line->tx.fate[tail] = 0;
+        line->tx.due[tail] = end + (uint64_t) line->config.latency_us * 1000;
+    }
+    line->tx.line_free_ns = end;
+    mock_line_wake(line);
+    pthread_mutex_unlock(&line->lock);
+
+    struct timespec ts = { (end - now) / 1000000000ULL, (end - now) % 1000000000ULL };
+    nanosleep(&ts, NULL);
+
     return MRAA_SUCCESS;
 }
 
 mraa_result_t
-mraa_mock_uart_set_non_blocking_replace(mraa_uart_context dev, mraa_boolean_t nonblock)
+mraa_mock_uart_set_flowcontrol_replace(mraa_uart_context dev, mraa_boolean_t xonxoff, mraa_boolean_t rtscts)
 {
     return MRAA_SUCCESS;
 }
 
 mraa_result_t
-mraa_mock_uart_set_timeout_replace(mraa_uart_context dev, int read, int write, int interchar)
+mraa_mock_uart_set_mode_replace(mraa_uart_context dev, int bytesize, mraa_uart_parity_t parity, int stopbits)
 {
+    if (bytesize < 5 || bytesize > 8 || stopbits < 1 || stopbits > 2) {
+        syslog(LOG_ERR, "uart%i: set_mode: invalid mode %d bits, %d stop bits", dev->index, bytesize, stopbits);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    // ptys refuse parity, so only the wire timing follows the mode
+    struct mock_uart_line* line = mock_line_find(dev);
+    if (line != NULL) {
+        pthread_mutex_lock(&line->lock);
+        mock_line_set_framing(line, dev->baudrate, bytesize, parity != MRAA_UART_PARITY_NONE, stopbits);
+        pthread_mutex_unlock(&line->lock);
+    }
+
     return MRAA_SUCCESS;
 }
 
-mraa_boolean_t
-mraa_mock_uart_data_available_replace(mraa_uart_context dev, unsigned int millis)
+mraa_result_t
+mraa_mock_uart_set_line(mraa_uart_context dev, const mraa_mock_uart_line_config_t* config)
 {
-    // Our mock implementation will always have "incoming" data
-    return 1;
+    struct mock_uart_line* line = dev != NULL ? mock_line_find(dev) : NULL;
+    if (line == NULL || config == NULL) {
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (config->drop_ppm > 1000000 || config->parity_ppm > 1000000) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    pthread_mutex_lock(&line->lock);
+    line->config = *config;
+    if (config->seed != 0) {
+        line->seed = config->seed;
+    }
+    mock_line_wake(line);
+    pthread_mutex_unlock(&line->lock);
+
+    return MRAA_SUCCESS;
 }
 
 int
-mraa_mock_uart_write_replace(mraa_uart_context dev, const char* buf, size_t len)
+mraa_mock_uart_open_peer(mraa_uart_context dev)
 {
-    // Our mock implementation always succeeds when sending data
-    return len;
+    int sv[2];
+
+    struct mock_uart_line* line = dev != NULL ? mock_line_find(dev) : NULL;
+    if (line == NULL) {
+        return -1;
+    }
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0) {
+        syslog(LOG_ERR, "uart%i: mock: socketpair() failed: %s", dev->index, strerror(errno));
+        return -1;
+    }
+    fcntl(sv[0], F_SETFL, O_NONBLOCK);
+    fcntl(sv[0], F_SETFD, FD_CLOEXEC);
+
+    pthread_mutex_lock(&line->lock);
+    if (line->peer >= 0) {
+        close(line->peer);
+    }
+    line->peer = sv[0];
+    mock_line_wake(line);
+    pthread_mutex_unlock(&line->lock);
+
+    return sv[1];
 }
 
-int
-mraa_mock_uart_read_replace(mraa_uart_context dev, char* buf, size_t len)
+mraa_result_t
+mraa_mock_uart_get_line_stats(mraa_uart_context dev, mraa_mock_uart_line_stats_t* stats)
 {
-    // We'll return MOCK_UART_DATA_BYTE, len times
-    memset(buf, MOCK_UART_DATA_BYTE, len);
-    return len;
+    struct mock_uart_line* line = dev != NULL ? mock_line_find(dev) : NULL;
+    if (line == NULL || stats == NULL) {
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    pthread_mutex_lock(&line->lock);
+    *stats = line->stats;
+    pthread_mutex_unlock(&line->lock);
+
+    return MRAA_SUCCESS;
 }
@@ -29,6 +29,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <sys/utsname.h>
+#include <time.h>
 #include <unistd.h>
 
 #if defined(IMRAA)
@@ -1482,6 +1483,14 @@ mraa_atoi(char* intStr, int* value)
     return MRAA_SUCCESS;
 }
 
+uint64_t
+mraa_monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
 mraa_result_t
 mraa_init_io_helper(char** str, int* value, const char* delim)
 {
@@ -121,6 +121,7 @@ mraa_pman_uart_set_baudrate_replace(mraa_uart_context dev, unsigned int baud)
     if (AUartDevice_setBaudrate(dev->buart, baud) != 0) {
         return 0;
     }
+    dev->baudrate = baud;
 
     return MRAA_SUCCESS;
 }
@@ -27,11 +27,228 @@
 #include <errno.h>
 
 #include "spi.h"
+#include "spi/spi_soft.h"
 #include "mraa_internal.h"
 
 #define MAX_SIZE 64
 #define SPI_MAX_LENGTH 4096
 
+// Older spidev headers predate dual/quad support
+#ifndef SPI_TX_DUAL
+#define SPI_TX_DUAL 0x100
+#define SPI_TX_QUAD 0x200
+#define SPI_RX_DUAL 0x400
+#define SPI_RX_QUAD 0x800
+#endif
+#define SPI_BUSWIDTH_MASK (SPI_TX_DUAL | SPI_TX_QUAD | SPI_RX_DUAL | SPI_RX_QUAD)
+
+// 256 entry bit reversal table, each entry is its index with the bit order flipped
+#define R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define R4(n) R2(n), R2(n + 2 * 16), R2(n + 1 * 16), R2(n + 3 * 16)
+#define R6(n) R4(n), R4(n + 2 * 4), R4(n + 1 * 4), R4(n + 3 * 4)
+static const uint8_t spi_bit_reverse_table[256] = { R6(0), R6(2), R6(1), R6(3) };
+#undef R2
+#undef R4
+#undef R6
+
+/**
+ * Size in bytes of a single spidev word for a given bits per word setting,
+ * spidev packs 1-8 bits in a byte, 9-16 bits in a u16 and 17-32 bits in a u32
+ */
+static unsigned int
+mraa_spi_word_size(unsigned int bpw)
+{
+    if (bpw > 16) {
+        return 4;
+    }
+    if (bpw > 8) {
+        return 2;
+    }
+    return 1;
+}
+
+/**
+ * Reverse the bit order of every byte of a 64bit lane in parallel (SWAR)
+ */
+static inline uint64_t
+mraa_spi_reverse_bytes64(uint64_t v)
+{
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return v;
+}
+
+/**
+ * Convert a buffer of spidev words between MSB first and LSB first order.
+ * Reversing a whole word is a per byte bit reversal followed by an
+ * endianness swap of the word, words narrower than their container are then
+ * shifted back down. The bulk of the buffer is handled 8 bytes at a time,
+ * the tail falls back to the lookup table. src and dst may alias.
+ *
+ * @param src words to convert
+ * @param dst converted words
+ * @param length buffer length in bytes
+ * @param bpw bits per word in use on the bus
+ */
+static void
+mraa_spi_reverse_bits(const uint8_t* src, uint8_t* dst, int length, unsigned int bpw)
+{
+    unsigned int wsize = mraa_spi_word_size(bpw);
+    unsigned int shift = (wsize * 8) - (bpw == 0 ? 8 : bpw);
+    uint64_t lane_mask;
+    int i = 0;
+
+    switch (wsize) {
+        case 4:
+            lane_mask = ((uint64_t) (0xFFFFFFFFUL >> shift)) * 0x0000000100000001ULL;
+            break;
+        case 2:
+            lane_mask = ((uint64_t) (0xFFFFU >> shift)) * 0x0001000100010001ULL;
+            break;
+        default:
+            lane_mask = ((uint64_t) (0xFFU >> shift)) * 0x0101010101010101ULL;
+            break;
+    }
+
+    for (; i + 8 <= length; i += 8) {
+        uint64_t v;
+        memcpy(&v, src + i, sizeof(v));
+        v = mraa_spi_reverse_bytes64(v);
+        if (wsize >= 2) {
+            v = ((v >> 8) & 0x00FF00FF00FF00FFULL) | ((v & 0x00FF00FF00FF00FFULL) << 8);
+        }
+        if (wsize == 4) {
+            v = ((v >> 16) & 0x0000FFFF0000FFFFULL) | ((v & 0x0000FFFF0000FFFFULL) << 16);
+        }
+        if (shift != 0) {
+            v = (v >> shift) & lane_mask;
+        }
+        memcpy(dst + i, &v, sizeof(v));
+    }
+
+    for (; i + (int) wsize <= length; i += wsize) {
+        if (wsize == 4) {
+            uint32_t w;
+            memcpy(&w, src + i, sizeof(w));
+            w = ((uint32_t) spi_bit_reverse_table[w & 0xFF] << 24) |
+                ((uint32_t) spi_bit_reverse_table[(w >> 8) & 0xFF] << 16) |
+                ((uint32_t) spi_bit_reverse_table[(w >> 16) & 0xFF] << 8) |
+                spi_bit_reverse_table[w >> 24];
+            w >>= shift;
+            memcpy(dst + i, &w, sizeof(w));
+        } else if (wsize == 2) {
+            uint16_t w;
+            memcpy(&w, src + i, sizeof(w));
+            w = (uint16_t) ((spi_bit_reverse_table[w & 0xFF] << 8) | spi_bit_reverse_table[w >> 8]);
+            w >>= shift;
+            memcpy(dst + i, &w, sizeof(w));
+        } else {
+            dst[i] = spi_bit_reverse_table[src[i]] >> shift;
+        }
+    }
+
+    // a trailing partial word is not something spidev would send, keep it as is
+    if (i < length && src != dst) {
+        memcpy(dst + i, src + i, length - i);
+    }
+}
+
+/**
+ * Make sure the context scratch buffer holds at least length bytes
+ */
+static mraa_result_t
+mraa_spi_soft_buf_reserve(mraa_spi_context dev, int length)
+{
+    if (dev->soft_buf_len < length) {
+        uint8_t* buf = realloc(dev->soft_buf, length);
+        if (buf == NULL) {
+            syslog(LOG_ERR, "spi: Failed to allocate lsb conversion buffer");
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        dev->soft_buf = buf;
+        dev->soft_buf_len = length;
+    }
+    return MRAA_SUCCESS;
+}
+
+/**
+ * Prepare a tx buffer for a transfer when lsb mode is emulated. The caller's
+ * buffer is left untouched, the converted words live in the context scratch
+ * buffer which is grown on demand.
+ *
+ * @return buffer to hand to the controller, NULL if allocation failed
+ */
+static uint8_t*
+mraa_spi_soft_lsb_tx(mraa_spi_context dev, const void* data, int length)
+{
+    if (data == NULL || length <= 0) {
+        return (uint8_t*) data;
+    }
+    if (mraa_spi_soft_buf_reserve(dev, length) != MRAA_SUCCESS) {
+        return NULL;
+    }
+    mraa_spi_reverse_bits((const uint8_t*) data, dev->soft_buf, length, dev->bpw);
+    return dev->soft_buf;
+}
+
+/**
+ * Convert received words back to lsb first order in place
+ */
+static void
+mraa_spi_soft_lsb_rx(mraa_spi_context dev, void* rxbuf, int length)
+{
+    if (rxbuf != NULL && length > 0) {
+        mraa_spi_reverse_bits((const uint8_t*) rxbuf, (uint8_t*) rxbuf, length, dev->bpw);
+    }
+}
+
+/**
+ * Fall back to reversing the bit order in software when the controller
+ * cannot shift data out lsb first. The controller stays in msb first mode.
+ */
+static mraa_result_t
+mraa_spi_lsbmode_soft(mraa_spi_context dev)
+{
+    syslog(LOG_NOTICE, "spi: controller lacks lsb first support, reversing bit order in software");
+    dev->lsb = 1;
+    dev->lsb_soft = 1;
+    return MRAA_SUCCESS;
+}
+
+/**
+ * Number of bits a transfer of length bytes puts on each data line
+ */
+static uint64_t
+mraa_spi_stats_bits(mraa_spi_context dev, int length, unsigned int nbits)
+{
+    unsigned int bpw = dev->bpw == 0 ? 8 : dev->bpw;
+    if (length <= 0) {
+        return 0;
+    }
+    return (uint64_t) (length / mraa_spi_word_size(bpw)) * bpw / (nbits > 0 ? nbits : 1);
+}
+
+static void
+mraa_spi_stats_update(mraa_spi_context dev, uint64_t start_ns, int length, uint64_t bits, mraa_boolean_t ok)
+{
+    uint64_t took = mraa_monotonic_ns() - start_ns;
+
+    if (!ok) {
+        dev->stats.errors++;
+        return;
+    }
+    dev->stats.transfers++;
+    dev->stats.bytes += length;
+    dev->stats.busy_ns += took;
+    if (took > dev->stats.max_latency_ns) {
+        dev->stats.max_latency_ns = took;
+    }
+    if (dev->clock > 0) {
+        dev->stats.wire_ns += bits * 1000000000ULL / (unsigned int) dev->clock;
+    }
+}
+
 static mraa_spi_context
 mraa_spi_init_internal(mraa_adv_func_t* func_table)
 {
@@ -40,6 +257,7 @@ mraa_spi_init_internal(mraa_adv_func_t* func_table)
         return NULL;
     }
     dev->advance_func = func_table;
+    dev->stats_since_ns = mraa_monotonic_ns();
 
     return dev;
 }
@@ -72,6 +290,11 @@ mraa_spi_init(int bus)
         }
     }
 
+    if (plat->spi_bus[bus].soft) {
+        // bit-banged bus, the pins are set up as plain gpios
+        return mraa_spi_soft_init(&plat->spi_bus[bus]);
+    }
+
     if (!plat->no_bus_mux) {
         int pos = plat->spi_bus[bus].sclk;
         if (pos >= 0 && plat->pins[pos].spi.mux_total > 0) {
@@ -215,6 +438,18 @@ mraa_spi_mode(mraa_spi_context dev, mraa_spi_mode_t mode)
             break;
     }
 
+    // keep any dual/quad bits requested through mraa_spi_buswidth()
+    uint32_t wide_mode = dev->mode & SPI_BUSWIDTH_MASK;
+    if (wide_mode != 0) {
+        wide_mode |= spi_mode;
+        if (ioctl(dev->devfd, SPI_IOC_WR_MODE32, &wide_mode) < 0) {
+            syslog(LOG_ERR, "spi: Failed to set spi mode");
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        dev->mode = wide_mode;
+        return MRAA_SUCCESS;
+    }
+
     if (ioctl(dev->devfd, SPI_IOC_WR_MODE, &spi_mode) < 0) {
         syslog(LOG_ERR, "spi: Failed to set spi mode");
         return MRAA_ERROR_INVALID_RESOURCE;
@@ -224,6 +459,114 @@ mraa_spi_mode(mraa_spi_context dev, mraa_spi_mode_t mode)
     return MRAA_SUCCESS;
 }
 
+static uint32_t
+mraa_spi_buswidth_to_mode(mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx)
+{
+    uint32_t mode = 0;
+
+    if (tx == MRAA_SPI_BUSWIDTH_QUAD) {
+        mode |= SPI_TX_QUAD;
+    } else if (tx == MRAA_SPI_BUSWIDTH_DUAL) {
+        mode |= SPI_TX_DUAL;
+    }
+    if (rx == MRAA_SPI_BUSWIDTH_QUAD) {
+        mode |= SPI_RX_QUAD;
+    } else if (rx == MRAA_SPI_BUSWIDTH_DUAL) {
+        mode |= SPI_RX_DUAL;
+    }
+    return mode;
+}
+
+static mraa_boolean_t
+mraa_spi_buswidth_valid(mraa_spi_buswidth_t width)
+{
+    return width == MRAA_SPI_BUSWIDTH_SINGLE || width == MRAA_SPI_BUSWIDTH_DUAL ||
+           width == MRAA_SPI_BUSWIDTH_QUAD;
+}
+
+mraa_result_t
+mraa_spi_buswidth(mraa_spi_context dev, mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: buswidth: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (!mraa_spi_buswidth_valid(tx) || !mraa_spi_buswidth_valid(rx)) {
+        syslog(LOG_ERR, "spi: buswidth: invalid bus width tx %d rx %d", tx, rx);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    if (IS_FUNC_DEFINED(dev, spi_buswidth_replace)) {
+        return dev->advance_func->spi_buswidth_replace(dev, tx, rx);
+    }
+
+    mraa_spi_buswidth_t want_tx = tx;
+    mraa_spi_buswidth_t want_rx = rx;
+    uint32_t base = dev->mode & ~SPI_BUSWIDTH_MASK;
+    for (;;) {
+        uint32_t mode = base | mraa_spi_buswidth_to_mode(tx, rx);
+        if (ioctl(dev->devfd, SPI_IOC_WR_MODE32, &mode) == 0) {
+            // the core may silently drop bits the controller can't do
+            if (ioctl(dev->devfd, SPI_IOC_RD_MODE32, &mode) < 0) {
+                mode = base | mraa_spi_buswidth_to_mode(tx, rx);
+            }
+            dev->mode = mode;
+            dev->tx_nbits = (mode & SPI_TX_QUAD) ? 4 : ((mode & SPI_TX_DUAL) ? 2 : 1);
+            dev->rx_nbits = (mode & SPI_RX_QUAD) ? 4 : ((mode & SPI_RX_DUAL) ? 2 : 1);
+            if (dev->tx_nbits < want_tx || dev->rx_nbits < want_rx) {
+                syslog(LOG_NOTICE, "spi: buswidth: tx %d rx %d requested, controller granted tx %d rx %d",
+                       want_tx, want_rx, dev->tx_nbits, dev->rx_nbits);
+            }
+            return MRAA_SUCCESS;
+        }
+        if (tx == MRAA_SPI_BUSWIDTH_SINGLE && rx == MRAA_SPI_BUSWIDTH_SINGLE) {
+            syslog(LOG_ERR, "spi: buswidth: Failed to set spi mode. Error %d %s", errno, strerror(errno));
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        // step down quad -> dual -> single and try again
+        if (tx > MRAA_SPI_BUSWIDTH_SINGLE) {
+            tx = (mraa_spi_buswidth_t) (tx / 2);
+        }
+        if (rx > MRAA_SPI_BUSWIDTH_SINGLE) {
+            rx = (mraa_spi_buswidth_t) (rx / 2);
+        }
+    }
+}
+
+mraa_result_t
+mraa_spi_get_buswidth(mraa_spi_context dev, mraa_spi_buswidth_t* tx, mraa_spi_buswidth_t* rx)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: get_buswidth: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (tx != NULL) {
+        *tx = dev->tx_nbits > 1 ? (mraa_spi_buswidth_t) dev->tx_nbits : MRAA_SPI_BUSWIDTH_SINGLE;
+    }
+    if (rx != NULL) {
+        *rx = dev->rx_nbits > 1 ? (mraa_spi_buswidth_t) dev->rx_nbits : MRAA_SPI_BUSWIDTH_SINGLE;
+    }
+    return MRAA_SUCCESS;
+}
+
+/**
+ * Narrow a segment bus width to what the controller granted
+ */
+static uint8_t
+mraa_spi_segment_nbits(mraa_spi_buswidth_t want, uint8_t granted)
+{
+    uint8_t nbits = want > 1 ? (uint8_t) want : 1;
+    if (granted < 1) {
+        granted = 1;
+    }
+    while (nbits > granted) {
+        nbits /= 2;
+    }
+    return nbits;
+}
+
 mraa_result_t
 mraa_spi_frequency(mraa_spi_context dev, int hz)
 {
@@ -253,6 +596,47 @@ mraa_spi_frequency(mraa_spi_context dev, int hz)
     return MRAA_SUCCESS;
 }
 
+mraa_result_t
+mraa_spi_get_stats(mraa_spi_context dev, mraa_spi_stats_t* stats)
+{
+    if (dev == NULL || stats == NULL) {
+        syslog(LOG_ERR, "spi: get_stats: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    *stats = dev->stats;
+    stats->elapsed_ns = mraa_monotonic_ns() - dev->stats_since_ns;
+    stats->utilisation = stats->elapsed_ns > 0 ? (float) stats->wire_ns / stats->elapsed_ns : 0;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_reset_stats(mraa_spi_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: reset_stats: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    memset(&dev->stats, 0, sizeof(dev->stats));
+    dev->stats_since_ns = mraa_monotonic_ns();
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_spi_get_frequency(mraa_spi_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: get_frequency: context is invalid");
+        return -1;
+    }
+
+    if (dev->clock_achieved > 0) {
+        return dev->clock_achieved;
+    }
+    return dev->clock;
+}
+
 mraa_result_t
 mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb)
 {
@@ -262,11 +646,21 @@ mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb)
     }
 
     if (IS_FUNC_DEFINED(dev, spi_lsbmode_replace)) {
-        return dev->advance_func->spi_lsbmode_replace(dev, lsb);
+        mraa_result_t ret = dev->advance_func->spi_lsbmode_replace(dev, lsb);
+        if (ret == MRAA_ERROR_FEATURE_NOT_SUPPORTED && lsb) {
+            return mraa_spi_lsbmode_soft(dev);
+        }
+        if (ret == MRAA_SUCCESS) {
+            dev->lsb_soft = 0;
+        }
+        return ret;
     }
 
     uint8_t lsb_mode = (uint8_t) lsb;
     if (ioctl(dev->devfd, SPI_IOC_WR_LSB_FIRST, &lsb_mode) < 0) {
+        if (lsb) {
+            return mraa_spi_lsbmode_soft(dev);
+        }
         syslog(LOG_ERR, "spi: Failed to set bit order");
         return MRAA_ERROR_INVALID_RESOURCE;
     }
@@ -275,6 +669,7 @@ mraa_spi_lsbmode(mraa_spi_context dev, mraa_boolean_t lsb)
         return MRAA_ERROR_INVALID_RESOURCE;
     }
     dev->lsb = lsb;
+    dev->lsb_soft = 0;
     return MRAA_SUCCESS;
 }
 
@@ -306,8 +701,20 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
         return -1;
     }
 
+    if (dev->lsb_soft) {
+        mraa_spi_reverse_bits(&data, &data, sizeof(data), dev->bpw);
+    }
+
+    uint64_t start = mraa_monotonic_ns();
     if (IS_FUNC_DEFINED(dev, spi_write_replace)) {
-        return dev->advance_func->spi_write_replace(dev, data);
+        int ret = dev->advance_func->spi_write_replace(dev, data);
+        mraa_spi_stats_update(dev, start, sizeof(data), mraa_spi_stats_bits(dev, sizeof(data), 1), ret >= 0);
+        if (dev->lsb_soft && ret >= 0) {
+            uint8_t rx = (uint8_t) ret;
+            mraa_spi_soft_lsb_rx(dev, &rx, sizeof(rx));
+            ret = rx;
+        }
+        return ret;
     }
 
     struct spi_ioc_transfer msg;
@@ -315,7 +722,7 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
 
     uint16_t length = 1;
 
-    unsigned long recv = 0;
+    uint8_t recv = 0;
     msg.tx_buf = (unsigned long) &data;
     msg.rx_buf = (unsigned long) &recv;
     msg.speed_hz = dev->clock;
@@ -323,9 +730,14 @@ mraa_spi_write(mraa_spi_context dev, uint8_t data)
     msg.delay_usecs = 0;
     msg.len = length;
     if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
+        mraa_spi_stats_update(dev, start, length, 0, 0);
         syslog(LOG_ERR, "spi: Failed to perform dev transfer");
         return -1;
     }
+    mraa_spi_stats_update(dev, start, length, mraa_spi_stats_bits(dev, length, 1), 1);
+    if (dev->lsb_soft) {
+        mraa_spi_soft_lsb_rx(dev, &recv, sizeof(recv));
+    }
     return (int) recv;
 }
 
@@ -337,8 +749,20 @@ mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
         return -1;
     }
 
+    if (dev->lsb_soft) {
+        mraa_spi_reverse_bits((uint8_t*) &data, (uint8_t*) &data, sizeof(data), dev->bpw);
+    }
+
+    uint64_t start = mraa_monotonic_ns();
     if (IS_FUNC_DEFINED(dev, spi_write_word_replace)) {
-        return dev->advance_func->spi_write_word_replace(dev, data);
+        int ret = dev->advance_func->spi_write_word_replace(dev, data);
+        mraa_spi_stats_update(dev, start, sizeof(data), mraa_spi_stats_bits(dev, sizeof(data), 1), ret >= 0);
+        if (dev->lsb_soft && ret >= 0) {
+            uint16_t rx = (uint16_t) ret;
+            mraa_spi_soft_lsb_rx(dev, &rx, sizeof(rx));
+            ret = rx;
+        }
+        return ret;
     }
 
     struct spi_ioc_transfer msg;
@@ -354,9 +778,14 @@ mraa_spi_write_word(mraa_spi_context dev, uint16_t data)
     msg.delay_usecs = 0;
     msg.len = length;
     if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
+        mraa_spi_stats_update(dev, start, length, 0, 0);
         syslog(LOG_ERR, "spi: Failed to perform dev transfer");
         return -1;
     }
+    mraa_spi_stats_update(dev, start, length, mraa_spi_stats_bits(dev, length, 1), 1);
+    if (dev->lsb_soft) {
+        mraa_spi_soft_lsb_rx(dev, &recv, sizeof(recv));
+    }
     return (int) recv;
 }
 
@@ -368,24 +797,39 @@ mraa_spi_transfer_buf(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int l
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    if (IS_FUNC_DEFINED(dev, spi_transfer_buf_replace)) {
-        return dev->advance_func->spi_transfer_buf_replace(dev, data, rxbuf, length);
+    mraa_result_t ret = MRAA_SUCCESS;
+    uint8_t* tx = data;
+    if (dev->lsb_soft) {
+        tx = mraa_spi_soft_lsb_tx(dev, data, length);
+        if (tx == NULL && data != NULL) {
+            return MRAA_ERROR_NO_RESOURCES;
+        }
     }
 
-    struct spi_ioc_transfer msg;
-    memset(&msg, 0, sizeof(msg));
+    uint64_t start = mraa_monotonic_ns();
+    if (IS_FUNC_DEFINED(dev, spi_transfer_buf_replace)) {
+        ret = dev->advance_func->spi_transfer_buf_replace(dev, tx, rxbuf, length);
+    } else {
+        struct spi_ioc_transfer msg;
+        memset(&msg, 0, sizeof(msg));
+
+        msg.tx_buf = (unsigned long) tx;
+        msg.rx_buf = (unsigned long) rxbuf;
+        msg.speed_hz = dev->clock;
+        msg.bits_per_word = dev->bpw;
+        msg.delay_usecs = 0;
+        msg.len = length;
+        if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
+            syslog(LOG_ERR, "spi: Failed to perform dev transfer");
+            ret = MRAA_ERROR_INVALID_RESOURCE;
+        }
+    }
+    mraa_spi_stats_update(dev, start, length, mraa_spi_stats_bits(dev, length, 1), ret == MRAA_SUCCESS);
 
-    msg.tx_buf = (unsigned long) data;
-    msg.rx_buf = (unsigned long) rxbuf;
-    msg.speed_hz = dev->clock;
-    msg.bits_per_word = dev->bpw;
-    msg.delay_usecs = 0;
-    msg.len = length;
-    if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
-        syslog(LOG_ERR, "spi: Failed to perform dev transfer");
-        return MRAA_ERROR_INVALID_RESOURCE;
+    if (ret == MRAA_SUCCESS && dev->lsb_soft) {
+        mraa_spi_soft_lsb_rx(dev, rxbuf, length);
     }
-    return MRAA_SUCCESS;
+    return ret;
 }
 
 mraa_result_t
@@ -396,24 +840,177 @@ mraa_spi_transfer_buf_word(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    mraa_result_t ret = MRAA_SUCCESS;
+    uint16_t* tx = data;
+    if (dev->lsb_soft) {
+        tx = (uint16_t*) mraa_spi_soft_lsb_tx(dev, data, length);
+        if (tx == NULL && data != NULL) {
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+
+    uint64_t start = mraa_monotonic_ns();
     if (IS_FUNC_DEFINED(dev, spi_transfer_buf_word_replace)) {
-        return dev->advance_func->spi_transfer_buf_word_replace(dev, data, rxbuf, length);
+        ret = dev->advance_func->spi_transfer_buf_word_replace(dev, tx, rxbuf, length);
+    } else {
+        struct spi_ioc_transfer msg;
+        memset(&msg, 0, sizeof(msg));
+
+        msg.tx_buf = (unsigned long) tx;
+        msg.rx_buf = (unsigned long) rxbuf;
+        msg.speed_hz = dev->clock;
+        msg.bits_per_word = dev->bpw;
+        msg.delay_usecs = 0;
+        msg.len = length;
+        if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
+            syslog(LOG_ERR, "spi: Failed to perform dev transfer");
+            ret = MRAA_ERROR_INVALID_RESOURCE;
+        }
     }
+    mraa_spi_stats_update(dev, start, length, mraa_spi_stats_bits(dev, length, 1), ret == MRAA_SUCCESS);
 
-    struct spi_ioc_transfer msg;
-    memset(&msg, 0, sizeof(msg));
+    if (ret == MRAA_SUCCESS && dev->lsb_soft) {
+        mraa_spi_soft_lsb_rx(dev, rxbuf, length);
+    }
+    return ret;
+}
 
-    msg.tx_buf = (unsigned long) data;
-    msg.rx_buf = (unsigned long) rxbuf;
-    msg.speed_hz = dev->clock;
-    msg.bits_per_word = dev->bpw;
-    msg.delay_usecs = 0;
-    msg.len = length;
-    if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
-        syslog(LOG_ERR, "spi: Failed to perform dev transfer");
-        return MRAA_ERROR_INVALID_RESOURCE;
+mraa_result_t
+mraa_spi_transfer_buf_word32(mraa_spi_context dev, uint32_t* data, uint32_t* rxbuf, int length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: transfer_buf_word32: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
     }
-    return MRAA_SUCCESS;
+
+    mraa_result_t ret = MRAA_SUCCESS;
+    uint32_t* tx = data;
+    if (dev->lsb_soft) {
+        tx = (uint32_t*) mraa_spi_soft_lsb_tx(dev, data, length);
+        if (tx == NULL && data != NULL) {
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+
+    uint64_t start = mraa_monotonic_ns();
+    if (IS_FUNC_DEFINED(dev, spi_transfer_buf_word32_replace)) {
+        ret = dev->advance_func->spi_transfer_buf_word32_replace(dev, tx, rxbuf, length);
+    } else {
+        struct spi_ioc_transfer msg;
+        memset(&msg, 0, sizeof(msg));
+
+        msg.tx_buf = (unsigned long) tx;
+        msg.rx_buf = (unsigned long) rxbuf;
+        msg.speed_hz = dev->clock;
+        msg.bits_per_word = dev->bpw;
+        msg.delay_usecs = 0;
+        msg.len = length;
+        if (ioctl(dev->devfd, SPI_IOC_MESSAGE(1), &msg) < 0) {
+            syslog(LOG_ERR, "spi: Failed to perform dev transfer");
+            ret = MRAA_ERROR_INVALID_RESOURCE;
+        }
+    }
+    mraa_spi_stats_update(dev, start, length, mraa_spi_stats_bits(dev, length, 1), ret == MRAA_SUCCESS);
+
+    if (ret == MRAA_SUCCESS && dev->lsb_soft) {
+        mraa_spi_soft_lsb_rx(dev, rxbuf, length);
+    }
+    return ret;
+}
+
+mraa_result_t
+mraa_spi_transfer_segments(mraa_spi_context dev, mraa_spi_segment_t* segments, int count)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi: transfer_segments: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (segments == NULL || count <= 0) {
+        syslog(LOG_ERR, "spi: transfer_segments: no segments given");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_result_t ret = MRAA_SUCCESS;
+    mraa_spi_segment_t* segs = segments;
+    mraa_spi_segment_t* soft_segs = NULL;
+    int i;
+
+    if (dev->lsb_soft) {
+        int total = 0;
+        for (i = 0; i < count; i++) {
+            if (segments[i].txbuf != NULL && segments[i].length > 0) {
+                total += segments[i].length;
+            }
+        }
+        soft_segs = malloc(sizeof(mraa_spi_segment_t) * count);
+        if (soft_segs == NULL || mraa_spi_soft_buf_reserve(dev, total) != MRAA_SUCCESS) {
+            free(soft_segs);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        int offset = 0;
+        for (i = 0; i < count; i++) {
+            soft_segs[i] = segments[i];
+            if (segments[i].txbuf != NULL && segments[i].length > 0) {
+                soft_segs[i].txbuf = dev->soft_buf + offset;
+                mraa_spi_reverse_bits(segments[i].txbuf, soft_segs[i].txbuf, segments[i].length, dev->bpw);
+                offset += segments[i].length;
+            }
+        }
+        segs = soft_segs;
+    }
+
+    uint64_t start = mraa_monotonic_ns();
+    if (IS_FUNC_DEFINED(dev, spi_transfer_segments_replace)) {
+        ret = dev->advance_func->spi_transfer_segments_replace(dev, segs, count);
+    } else {
+        struct spi_ioc_transfer* msgs = calloc(count, sizeof(struct spi_ioc_transfer));
+        if (msgs == NULL) {
+            free(soft_segs);
+            syslog(LOG_ERR, "spi: transfer_segments: Failed to allocate messages");
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        for (i = 0; i < count; i++) {
+            msgs[i].tx_buf = (unsigned long) segs[i].txbuf;
+            msgs[i].rx_buf = (unsigned long) segs[i].rxbuf;
+            msgs[i].len = segs[i].length;
+            msgs[i].speed_hz = dev->clock;
+            msgs[i].bits_per_word = dev->bpw;
+            msgs[i].cs_change = segs[i].cs_change ? 1 : 0;
+            msgs[i].tx_nbits = mraa_spi_segment_nbits(segs[i].tx_width, dev->tx_nbits);
+            msgs[i].rx_nbits = mraa_spi_segment_nbits(segs[i].rx_width, dev->rx_nbits);
+        }
+        if (ioctl(dev->devfd, SPI_IOC_MESSAGE(count), msgs) < 0) {
+            syslog(LOG_ERR, "spi: Failed to perform dev transfer. Error %d %s", errno, strerror(errno));
+            ret = MRAA_ERROR_INVALID_RESOURCE;
+        }
+        free(msgs);
+    }
+    if (ret == MRAA_SUCCESS) {
+        int bytes = 0;
+        uint64_t bits = 0;
+        for (i = 0; i < count; i++) {
+            // a segment only drives its data phase in one direction when wider than single
+            uint8_t nbits = mraa_spi_segment_nbits(segs[i].tx_width, dev->tx_nbits);
+            uint8_t rx_nbits = mraa_spi_segment_nbits(segs[i].rx_width, dev->rx_nbits);
+            if (segs[i].txbuf == NULL || (segs[i].rxbuf != NULL && rx_nbits > nbits)) {
+                nbits = rx_nbits;
+            }
+            bytes += segs[i].length;
+            bits += mraa_spi_stats_bits(dev, segs[i].length, nbits);
+        }
+        mraa_spi_stats_update(dev, start, bytes, bits, 1);
+    } else {
+        mraa_spi_stats_update(dev, start, 0, 0, 0);
+    }
+
+    if (ret == MRAA_SUCCESS && dev->lsb_soft) {
+        for (i = 0; i < count; i++) {
+            mraa_spi_soft_lsb_rx(dev, segments[i].rxbuf, segments[i].length);
+        }
+    }
+    free(soft_segs);
+    return ret;
 }
 
 uint8_t*
@@ -458,6 +1055,10 @@ mraa_spi_stop(mraa_spi_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    free(dev->soft_buf);
+    dev->soft_buf = NULL;
+    dev->soft_buf_len = 0;
+
     if (IS_FUNC_DEFINED(dev, spi_stop_replace)) {
         return dev->advance_func->spi_stop_replace(dev);
     }
@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "spi_flash.h"
+#include "mraa_internal.h"
+
+#define SPIDEV_BUFSIZ_PATH "/sys/module/spidev/parameters/bufsiz"
+#define SPIDEV_DEFAULT_BUFSIZ 4096
+
+#define SPI_FLASH_SR_WIP 0x01
+#define SPI_FLASH_SFDP_SIGNATURE 0x50444653
+#define SPI_FLASH_SFDP_BFPT_ID 0xff00
+#define SPI_FLASH_DEFAULT_PAGE_SIZE 256
+#define SPI_FLASH_DEFAULT_ERASE_SIZE 4096
+#define SPI_FLASH_PROGRAM_TIMEOUT_MS 100
+#define SPI_FLASH_ERASE_TIMEOUT_MS 5000
+#define SPI_FLASH_CHIP_ERASE_TIMEOUT_MS 600000
+#define SPI_FLASH_POLL_INTERVAL_US 50
+#define SPI_FLASH_MAX_CMD_LEN 6
+
+static uint32_t
+mraa_spi_flash_le32(const uint8_t* buf)
+{
+    return (uint32_t) buf[0] | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+/**
+ * Build an opcode followed by a 3 or 4 byte big endian address
+ *
+ * @return number of bytes in cmd
+ */
+static int
+mraa_spi_flash_cmd_addr(uint8_t* cmd, uint8_t opcode, uint32_t addr, uint8_t addr_bytes)
+{
+    int len = 0;
+    cmd[len++] = opcode;
+    if (addr_bytes == 4) {
+        cmd[len++] = (uint8_t) (addr >> 24);
+    }
+    cmd[len++] = (uint8_t) (addr >> 16);
+    cmd[len++] = (uint8_t) (addr >> 8);
+    cmd[len++] = (uint8_t) addr;
+    return len;
+}
+
+/**
+ * Send a command with an optional single width data phase
+ */
+static mraa_result_t
+mraa_spi_flash_cmd(mraa_spi_flash_context dev, uint8_t* cmd, int cmd_len, uint8_t* txbuf, uint8_t* rxbuf, int length)
+{
+    mraa_spi_segment_t segs[2];
+    memset(segs, 0, sizeof(segs));
+
+    segs[0].txbuf = cmd;
+    segs[0].length = cmd_len;
+    segs[1].txbuf = txbuf;
+    segs[1].rxbuf = rxbuf;
+    segs[1].length = length;
+
+    return mraa_spi_transfer_segments(dev->spi, segs, length > 0 ? 2 : 1);
+}
+
+static unsigned int
+mraa_spi_flash_spidev_bufsiz()
+{
+    unsigned int bufsiz = SPIDEV_DEFAULT_BUFSIZ;
+    FILE* fh = fopen(SPIDEV_BUFSIZ_PATH, "r");
+    if (fh != NULL) {
+        if (fscanf(fh, "%u", &bufsiz) != 1 || bufsiz == 0) {
+            bufsiz = SPIDEV_DEFAULT_BUFSIZ;
+        }
+        fclose(fh);
+    }
+    return bufsiz;
+}
+
+/**
+ * Pick the fastest 1-1-x read mode the flash advertises and the controller
+ * granted. Dummy cycles must fill whole bytes since they are clocked out as
+ * a single width segment.
+ */
+static void
+mraa_spi_flash_parse_read_modes(mraa_spi_flash_context dev, const uint8_t* bfpt, int dwords)
+{
+    mraa_spi_buswidth_t tx_width, rx_width;
+    uint32_t dw1 = mraa_spi_flash_le32(bfpt);
+
+    mraa_spi_get_buswidth(dev->spi, &tx_width, &rx_width);
+
+    if (dwords >= 4) {
+        uint32_t dw3 = mraa_spi_flash_le32(bfpt + 8);
+        uint32_t dw4 = mraa_spi_flash_le32(bfpt + 12);
+        // 1-1-4: dword 1 bit 22, opcode and cycles in the top half of dword 3
+        unsigned int quad_clocks = ((dw3 >> 16) & 0x1f) + ((dw3 >> 21) & 0x7);
+        // 1-1-2: dword 1 bit 16, opcode and cycles in the bottom half of dword 4
+        unsigned int dual_clocks = (dw4 & 0x1f) + ((dw4 >> 5) & 0x7);
+
+        if ((dw1 & (1 << 22)) && rx_width >= MRAA_SPI_BUSWIDTH_QUAD && (quad_clocks % 8) == 0) {
+            dev->read_opcode = (uint8_t) (dw3 >> 24);
+            dev->read_dummy = quad_clocks / 8;
+            dev->read_width = MRAA_SPI_BUSWIDTH_QUAD;
+            return;
+        }
+        if ((dw1 & (1 << 16)) && rx_width >= MRAA_SPI_BUSWIDTH_DUAL && (dual_clocks % 8) == 0) {
+            dev->read_opcode = (uint8_t) (dw4 >> 8);
+            dev->read_dummy = dual_clocks / 8;
+            dev->read_width = MRAA_SPI_BUSWIDTH_DUAL;
+            return;
+        }
+    }
+}
+
+/**
+ * Without 4KiB erase in dword 1, take the smallest of the four erase types
+ * of dwords 8 and 9, each a size exponent byte followed by its opcode.
+ * A size of 0 means the device can't erase anything but the whole chip.
+ */
+static void
+mraa_spi_flash_parse_erase_types(mraa_spi_flash_context dev, const uint8_t* bfpt, int dwords)
+{
+    int i;
+
+    dev->erase_size = 0;
+    for (i = 0; dwords >= 9 && i < 4; i++) {
+        uint8_t exp = bfpt[28 + i * 2];
+        if (exp == 0 || exp > 31) {
+            continue;
+        }
+        if (dev->erase_size == 0 || (1u << exp) < dev->erase_size) {
+            dev->erase_size = 1u << exp;
+            dev->erase_opcode = bfpt[28 + i * 2 + 1];
+        }
+    }
+}
+
+/**
+ * Parse the JEDEC Basic Flash Parameter Table
+ */
+static mraa_result_t
+mraa_spi_flash_parse_sfdp(mraa_spi_flash_context dev)
+{
+    uint8_t header[16];
+    uint8_t bfpt[64];
+
+    if (mraa_spi_flash_read_sfdp(dev, 0, header, sizeof(header)) != MRAA_SUCCESS ||
+        mraa_spi_flash_le32(header) != SPI_FLASH_SFDP_SIGNATURE) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    // first parameter header always describes the basic flash parameter table
+    uint16_t id = (uint16_t) ((header[15] << 8) | header[8]);
+    int dwords = header[11];
+    uint32_t ptp = (uint32_t) header[12] | ((uint32_t) header[13] << 8) | ((uint32_t) header[14] << 16);
+    if (id != SPI_FLASH_SFDP_BFPT_ID || dwords < 2) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    if (dwords > (int) (sizeof(bfpt) / 4)) {
+        dwords = sizeof(bfpt) / 4;
+    }
+    if (mraa_spi_flash_read_sfdp(dev, ptp, bfpt, dwords * 4) != MRAA_SUCCESS) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    uint32_t dw1 = mraa_spi_flash_le32(bfpt);
+    uint32_t dw2 = mraa_spi_flash_le32(bfpt + 4);
+
+    // density is in bits, either N-1 or 2^N
+    if (dw2 & 0x80000000) {
+        unsigned int exp = dw2 & 0x7fffffff;
+        if (exp < 3 || exp > 35) {
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        dev->size = exp >= 35 ? 0xffffffff : (uint32_t) (1ULL << (exp - 3));
+    } else {
+        dev->size = (uint32_t) (((uint64_t) dw2 + 1) / 8);
+    }
+
+    if ((dw1 & 0x3) == 0x1) {
+        dev->erase_size = 4096;
+        dev->erase_opcode = (uint8_t) (dw1 >> 8);
+    } else {
+        mraa_spi_flash_parse_erase_types(dev, bfpt, dwords);
+    }
+    if (((dw1 >> 17) & 0x3) == 0x2) {
+        dev->addr_bytes = 4;
+    }
+
+    mraa_spi_flash_parse_read_modes(dev, bfpt, dwords);
+
+    if (dwords >= 11) {
+        uint32_t dw11 = mraa_spi_flash_le32(bfpt + 40);
+        unsigned int unit = (dw11 & (1 << 13)) ? 64 : 8;
+        dev->page_size = 1 << ((dw11 >> 4) & 0xf);
+        dev->program_time_us = (((dw11 >> 8) & 0x1f) + 1) * unit;
+    }
+
+    dev->sfdp = 1;
+    return MRAA_SUCCESS;
+}
+
+static mraa_spi_flash_context
+mraa_spi_flash_init_internal(mraa_spi_context spi)
+{
+    if (spi == NULL) {
+        return NULL;
+    }
+
+    mraa_spi_flash_context dev = calloc(1, sizeof(struct _mraa_spi_flash));
+    if (dev == NULL) {
+        syslog(LOG_CRIT, "spi_flash: Failed to allocate memory for context");
+        mraa_spi_stop(spi);
+        return NULL;
+    }
+    dev->spi = spi;
+
+    // any width the controller grants is fine, reads narrow it down further
+    mraa_spi_buswidth(spi, MRAA_SPI_BUSWIDTH_SINGLE, MRAA_SPI_BUSWIDTH_QUAD);
+
+    if (mraa_spi_flash_read_id(dev, dev->jedec_id) != MRAA_SUCCESS) {
+        goto init_fail;
+    }
+    if ((dev->jedec_id[0] == 0x00 && dev->jedec_id[1] == 0x00) ||
+        (dev->jedec_id[0] == 0xff && dev->jedec_id[1] == 0xff)) {
+        syslog(LOG_ERR, "spi_flash: No flash device responded to READ ID");
+        goto init_fail;
+    }
+
+    // conservative defaults, refined by SFDP where available
+    dev->page_size = SPI_FLASH_DEFAULT_PAGE_SIZE;
+    dev->erase_size = SPI_FLASH_DEFAULT_ERASE_SIZE;
+    dev->erase_opcode = MRAA_SPI_FLASH_CMD_SECTOR_ERASE;
+    dev->read_opcode = MRAA_SPI_FLASH_CMD_FAST_READ;
+    dev->read_dummy = 1;
+    dev->read_width = MRAA_SPI_BUSWIDTH_SINGLE;
+    dev->addr_bytes = 3;
+    // most vendors encode log2 of the size in bytes in the last id byte
+    if (dev->jedec_id[2] >= 0x10 && dev->jedec_id[2] < 0x20) {
+        dev->size = 1u << dev->jedec_id[2];
+    }
+
+    if (mraa_spi_flash_parse_sfdp(dev) != MRAA_SUCCESS) {
+        syslog(LOG_NOTICE, "spi_flash: No usable SFDP table, using defaults");
+    }
+    if (dev->size == 0) {
+        syslog(LOG_ERR, "spi_flash: Unable to determine flash size");
+        goto init_fail;
+    }
+
+    if (dev->size > 0x1000000 && dev->addr_bytes == 3) {
+        uint8_t cmd = MRAA_SPI_FLASH_CMD_ENTER_4BYTE;
+        if (mraa_spi_flash_cmd(dev, &cmd, 1, NULL, NULL, 0) != MRAA_SUCCESS) {
+            goto init_fail;
+        }
+        dev->addr_bytes = 4;
+    }
+
+    dev->max_transfer = mraa_spi_flash_spidev_bufsiz();
+
+    return dev;
+
+init_fail:
+    mraa_spi_stop(spi);
+    free(dev);
+    return NULL;
+}
+
+mraa_spi_flash_context
+mraa_spi_flash_init(int bus)
+{
+    return mraa_spi_flash_init_internal(mraa_spi_init(bus));
+}
+
+mraa_spi_flash_context
+mraa_spi_flash_init_raw(unsigned int bus, unsigned int cs)
+{
+    return mraa_spi_flash_init_internal(mraa_spi_init_raw(bus, cs));
+}
+
+mraa_result_t
+mraa_spi_flash_stop(mraa_spi_flash_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi_flash: stop: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_spi_stop(dev->spi);
+    free(dev);
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_flash_read_id(mraa_spi_flash_context dev, uint8_t* id)
+{
+    if (dev == NULL || id == NULL) {
+        syslog(LOG_ERR, "spi_flash: read_id: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    uint8_t cmd = MRAA_SPI_FLASH_CMD_READ_ID;
+    return mraa_spi_flash_cmd(dev, &cmd, 1, NULL, id, MRAA_SPI_FLASH_JEDEC_ID_SIZE);
+}
+
+mraa_result_t
+mraa_spi_flash_read_sfdp(mraa_spi_flash_context dev, uint32_t addr, uint8_t* data, int length)
+{
+    if (dev == NULL || data == NULL) {
+        syslog(LOG_ERR, "spi_flash: read_sfdp: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    // SFDP always uses 3 address bytes and 8 dummy cycles
+    uint8_t cmd[SPI_FLASH_MAX_CMD_LEN];
+    int len = mraa_spi_flash_cmd_addr(cmd, MRAA_SPI_FLASH_CMD_READ_SFDP, addr, 3);
+    cmd[len++] = 0;
+    return mraa_spi_flash_cmd(dev, cmd, len, NULL, data, length);
+}
+
+int
+mraa_spi_flash_read_status(mraa_spi_flash_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi_flash: read_status: context is invalid");
+        return -1;
+    }
+
+    uint8_t cmd = MRAA_SPI_FLASH_CMD_READ_STATUS;
+    uint8_t status = 0;
+    if (mraa_spi_flash_cmd(dev, &cmd, 1, NULL, &status, 1) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return status;
+}
+
+mraa_result_t
+mraa_spi_flash_wait_ready(mraa_spi_flash_context dev, unsigned int timeout_ms)
+{
+    struct timespec start, now;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (;;) {
+        int status = mraa_spi_flash_read_status(dev);
+        if (status < 0) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        if (!(status & SPI_FLASH_SR_WIP)) {
+            return MRAA_SUCCESS;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long elapsed_ms = (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+        if (elapsed_ms >= (long) timeout_ms) {
+            syslog(LOG_ERR, "spi_flash: Timed out waiting for device, status %02x", status);
+            return MRAA_ERROR_UNSPECIFIED;
+        }
+        usleep(SPI_FLASH_POLL_INTERVAL_US);
+    }
+}
+
+mraa_result_t
+mraa_spi_flash_read(mraa_spi_flash_context dev, uint32_t addr, uint8_t* data, uint32_t length)
+{
+    if (dev == NULL || data == NULL) {
+        syslog(LOG_ERR, "spi_flash: read: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (addr > dev->size || length > dev->size - addr) {
+        syslog(LOG_ERR, "spi_flash: read: range outside of device");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t cmd[SPI_FLASH_MAX_CMD_LEN + 8];
+    int cmd_len = mraa_spi_flash_cmd_addr(cmd, dev->read_opcode, addr, dev->addr_bytes);
+    uint32_t chunk_max = dev->max_transfer - cmd_len - dev->read_dummy;
+    mraa_spi_segment_t segs[2];
+
+    while (length > 0) {
+        uint32_t chunk = length < chunk_max ? length : chunk_max;
+
+        cmd_len = mraa_spi_flash_cmd_addr(cmd, dev->read_opcode, addr, dev->addr_bytes);
+        memset(cmd + cmd_len, 0, dev->read_dummy);
+        cmd_len += dev->read_dummy;
+
+        memset(segs, 0, sizeof(segs));
+        segs[0].txbuf = cmd;
+        segs[0].length = cmd_len;
+        segs[1].rxbuf = data;
+        segs[1].length = chunk;
+        segs[1].rx_width = dev->read_width;
+        if (mraa_spi_transfer_segments(dev->spi, segs, 2) != MRAA_SUCCESS) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+
+        addr += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_flash_write(mraa_spi_flash_context dev, uint32_t addr, const uint8_t* data, uint32_t length)
+{
+    if (dev == NULL || data == NULL) {
+        syslog(LOG_ERR, "spi_flash: write: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (addr > dev->size || length > dev->size - addr) {
+        syslog(LOG_ERR, "spi_flash: write: range outside of device");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t wren = MRAA_SPI_FLASH_CMD_WRITE_ENABLE;
+    uint8_t cmd[SPI_FLASH_MAX_CMD_LEN];
+    mraa_spi_segment_t segs[3];
+
+    while (length > 0) {
+        uint32_t room = dev->page_size - (addr % dev->page_size);
+        uint32_t chunk = length < room ? length : room;
+        if (chunk > dev->max_transfer - SPI_FLASH_MAX_CMD_LEN) {
+            chunk = dev->max_transfer - SPI_FLASH_MAX_CMD_LEN;
+        }
+
+        // write enable and page program go out as one message, chip select
+        // is only toggled in between to latch the write enable
+        memset(segs, 0, sizeof(segs));
+        segs[0].txbuf = &wren;
+        segs[0].length = 1;
+        segs[0].cs_change = 1;
+        segs[1].txbuf = cmd;
+        segs[1].length = mraa_spi_flash_cmd_addr(cmd, MRAA_SPI_FLASH_CMD_PAGE_PROGRAM, addr, dev->addr_bytes);
+        segs[2].txbuf = (uint8_t*) data;
+        segs[2].length = chunk;
+        if (mraa_spi_transfer_segments(dev->spi, segs, 3) != MRAA_SUCCESS) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+
+        // don't poll before the program can possibly have finished
+        if (dev->program_time_us > SPI_FLASH_POLL_INTERVAL_US) {
+            usleep(dev->program_time_us);
+        }
+        mraa_result_t ret = mraa_spi_flash_wait_ready(dev, SPI_FLASH_PROGRAM_TIMEOUT_MS);
+        if (ret != MRAA_SUCCESS) {
+            return ret;
+        }
+
+        addr += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_flash_erase(mraa_spi_flash_context dev, uint32_t addr, uint32_t length)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi_flash: erase: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (dev->erase_size == 0) {
+        syslog(LOG_ERR, "spi_flash: erase: device has no sector erase");
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    if ((addr % dev->erase_size) != 0 || (length % dev->erase_size) != 0) {
+        syslog(LOG_ERR, "spi_flash: erase: range not aligned to %u bytes", dev->erase_size);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    if (addr > dev->size || length > dev->size - addr) {
+        syslog(LOG_ERR, "spi_flash: erase: range outside of device");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    uint8_t wren = MRAA_SPI_FLASH_CMD_WRITE_ENABLE;
+    uint8_t cmd[SPI_FLASH_MAX_CMD_LEN];
+    mraa_spi_segment_t segs[2];
+
+    for (; length > 0; addr += dev->erase_size, length -= dev->erase_size) {
+        memset(segs, 0, sizeof(segs));
+        segs[0].txbuf = &wren;
+        segs[0].length = 1;
+        segs[0].cs_change = 1;
+        segs[1].txbuf = cmd;
+        segs[1].length = mraa_spi_flash_cmd_addr(cmd, dev->erase_opcode, addr, dev->addr_bytes);
+        if (mraa_spi_transfer_segments(dev->spi, segs, 2) != MRAA_SUCCESS) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        mraa_result_t ret = mraa_spi_flash_wait_ready(dev, SPI_FLASH_ERASE_TIMEOUT_MS);
+        if (ret != MRAA_SUCCESS) {
+            return ret;
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_spi_flash_chip_erase(mraa_spi_flash_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "spi_flash: chip_erase: context is invalid");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    uint8_t wren = MRAA_SPI_FLASH_CMD_WRITE_ENABLE;
+    uint8_t cmd = MRAA_SPI_FLASH_CMD_CHIP_ERASE;
+    mraa_spi_segment_t segs[2];
+
+    memset(segs, 0, sizeof(segs));
+    segs[0].txbuf = &wren;
+    segs[0].length = 1;
+    segs[0].cs_change = 1;
+    segs[1].txbuf = &cmd;
+    segs[1].length = 1;
+    if (mraa_spi_transfer_segments(dev->spi, segs, 2) != MRAA_SUCCESS) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return mraa_spi_flash_wait_ready(dev, SPI_FLASH_CHIP_ERASE_TIMEOUT_MS);
+}
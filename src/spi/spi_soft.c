@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "spi/spi_soft.h"
+#include "mraa_internal.h"
+
+#define SOFT_SPI_SCLK 0
+#define SOFT_SPI_MOSI 1
+#define SOFT_SPI_CS 2
+
+#define SOFT_SPI_CPHA 0x01
+#define SOFT_SPI_CPOL 0x02
+
+#define SOFT_SPI_DEFAULT_FREQ 1000000
+
+/**
+ * Wait for the next clock edge. When the gpio accesses alone already take
+ * longer than half a period the deadline is moved up to now, so that later
+ * edges don't speed up past the requested clock to catch up.
+ */
+static void
+mraa_spi_soft_delay(mraa_spi_context dev, int64_t* deadline)
+{
+    if (dev->half_period_ns <= 0) {
+        return;
+    }
+    *deadline += dev->half_period_ns;
+    int64_t now = mraa_monotonic_ns();
+    if (now >= *deadline) {
+        *deadline = now;
+        return;
+    }
+    while ((int64_t) mraa_monotonic_ns() < *deadline)
+        ;
+}
+
+/**
+ * Drive the output pins, only the pins that change are written. A chardev
+ * multi context sets all lines with a single ioctl, otherwise each pin is a
+ * sysfs write or, where the platform provides it, a register write through
+ * the gpio mmap hooks.
+ */
+static mraa_result_t
+mraa_spi_soft_drive(mraa_spi_context dev, const int* levels)
+{
+    int num_out = dev->gpio_out->num_pins;
+
+    if (memcmp(levels, dev->gpio_levels, num_out * sizeof(int)) == 0) {
+        return MRAA_SUCCESS;
+    }
+
+    if (plat->chardev_capable) {
+        memcpy(dev->gpio_levels, levels, num_out * sizeof(int));
+        return mraa_gpio_write_multi(dev->gpio_out, dev->gpio_levels);
+    }
+
+    mraa_gpio_context it = dev->gpio_out;
+    int i;
+    for (i = 0; i < num_out && it != NULL; i++, it = it->next) {
+        if (levels[i] != dev->gpio_levels[i]) {
+            mraa_result_t ret = mraa_gpio_write(it, levels[i]);
+            if (ret != MRAA_SUCCESS) {
+                return ret;
+            }
+            dev->gpio_levels[i] = levels[i];
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+/**
+ * Assert or release chip select, with the clock at its idle level
+ */
+static mraa_result_t
+mraa_spi_soft_select(mraa_spi_context dev, mraa_boolean_t select, int64_t* deadline)
+{
+    int levels[3];
+
+    memcpy(levels, dev->gpio_levels, sizeof(levels));
+    levels[SOFT_SPI_SCLK] = (dev->mode & SOFT_SPI_CPOL) ? 1 : 0;
+    if (dev->gpio_out->num_pins > SOFT_SPI_CS) {
+        levels[SOFT_SPI_CS] = select ? 0 : 1;
+    }
+    mraa_result_t ret = mraa_spi_soft_drive(dev, levels);
+    mraa_spi_soft_delay(dev, deadline);
+    return ret;
+}
+
+/**
+ * Clock one word out on mosi while sampling miso
+ */
+static mraa_result_t
+mraa_spi_soft_shift(mraa_spi_context dev, uint32_t tx, uint32_t* rx, unsigned int bits, int64_t* deadline)
+{
+    int idle = (dev->mode & SOFT_SPI_CPOL) ? 1 : 0;
+    // with CPHA=0 data is set up while the clock idles, sampled on the leading
+    // edge. With CPHA=1 the leading edge shifts and the trailing one samples
+    int setup_level = (dev->mode & SOFT_SPI_CPHA) ? !idle : idle;
+    int levels[3];
+    unsigned int i;
+    uint32_t in = 0;
+
+    memcpy(levels, dev->gpio_levels, sizeof(levels));
+    for (i = 0; i < bits; i++) {
+        unsigned int shift = dev->lsb ? i : bits - 1 - i;
+
+        levels[SOFT_SPI_SCLK] = setup_level;
+        levels[SOFT_SPI_MOSI] = (tx >> shift) & 1;
+        if (mraa_spi_soft_drive(dev, levels) != MRAA_SUCCESS) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        mraa_spi_soft_delay(dev, deadline);
+
+        levels[SOFT_SPI_SCLK] = !setup_level;
+        if (mraa_spi_soft_drive(dev, levels) != MRAA_SUCCESS) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        if (dev->gpio_miso != NULL) {
+            int value = mraa_gpio_read(dev->gpio_miso);
+            if (value < 0) {
+                return MRAA_ERROR_INVALID_RESOURCE;
+            }
+            in |= (uint32_t) (value & 1) << shift;
+        }
+        mraa_spi_soft_delay(dev, deadline);
+    }
+
+    *rx = in;
+    return MRAA_SUCCESS;
+}
+
+/**
+ * Shift a buffer of words, laid out in 1, 2 or 4 byte containers like spidev
+ */
+static mraa_result_t
+mraa_spi_soft_shift_buf(mraa_spi_context dev, const uint8_t* txbuf, uint8_t* rxbuf, int length, int64_t* deadline)
+{
+    unsigned int bits = dev->bpw == 0 ? 8 : dev->bpw;
+    int size = bits <= 8 ? 1 : (bits <= 16 ? 2 : 4);
+    int i;
+
+    if (length % size != 0) {
+        syslog(LOG_ERR, "spi: soft: length %d is not a multiple of the %d byte word size", length, size);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    for (i = 0; i < length; i += size) {
+        uint32_t tx = 0, rx = 0;
+        if (txbuf != NULL) {
+            if (size == 1) {
+                tx = txbuf[i];
+            } else if (size == 2) {
+                uint16_t word;
+                memcpy(&word, txbuf + i, sizeof(word));
+                tx = word;
+            } else {
+                memcpy(&tx, txbuf + i, sizeof(tx));
+            }
+        }
+        if (mraa_spi_soft_shift(dev, tx, &rx, bits, deadline) != MRAA_SUCCESS) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        if (rxbuf != NULL) {
+            if (size == 1) {
+                rxbuf[i] = (uint8_t) rx;
+            } else if (size == 2) {
+                uint16_t word = (uint16_t) rx;
+                memcpy(rxbuf + i, &word, sizeof(word));
+            } else {
+                memcpy(rxbuf + i, &rx, sizeof(rx));
+            }
+        }
+    }
+    return MRAA_SUCCESS;
+}
+
+static void
+mraa_spi_soft_account(mraa_spi_context dev, int64_t start, int64_t bits)
+{
+    int64_t elapsed = (int64_t) mraa_monotonic_ns() - start;
+    if (elapsed > 0 && bits > 0) {
+        dev->clock_achieved = (int) (bits * 1000000000 / elapsed);
+    }
+}
+
+static int64_t
+mraa_spi_soft_bits(mraa_spi_context dev, int length)
+{
+    unsigned int bits = dev->bpw == 0 ? 8 : dev->bpw;
+    int size = bits <= 8 ? 1 : (bits <= 16 ? 2 : 4);
+    return (int64_t) (length / size) * bits;
+}
+
+static mraa_result_t
+mraa_spi_soft_transfer(mraa_spi_context dev, const uint8_t* txbuf, uint8_t* rxbuf, int length)
+{
+    int64_t start = mraa_monotonic_ns();
+    int64_t deadline = start;
+
+    if (length <= 0) {
+        syslog(LOG_ERR, "spi: soft: Length given is equal to or less than zero, cannot proceed");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_result_t ret = mraa_spi_soft_select(dev, 1, &deadline);
+    if (ret == MRAA_SUCCESS) {
+        ret = mraa_spi_soft_shift_buf(dev, txbuf, rxbuf, length, &deadline);
+    }
+    // always try to release the slave, even after a failed transfer
+    if (mraa_spi_soft_select(dev, 0, &deadline) != MRAA_SUCCESS && ret == MRAA_SUCCESS) {
+        ret = MRAA_ERROR_INVALID_RESOURCE;
+    }
+    if (ret == MRAA_SUCCESS) {
+        mraa_spi_soft_account(dev, start, mraa_spi_soft_bits(dev, length));
+    }
+    return ret;
+}
+
+static mraa_result_t
+mraa_spi_soft_mode_replace(mraa_spi_context dev, mraa_spi_mode_t mode)
+{
+    int64_t deadline = 0;
+
+    if (mode < MRAA_SPI_MODE0 || mode > MRAA_SPI_MODE3) {
+        syslog(LOG_ERR, "spi: soft: invalid mode %d", mode);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    dev->mode = mode;
+    // move the clock to its new idle level before anything is selected
+    return mraa_spi_soft_select(dev, 0, &deadline);
+}
+
+static mraa_result_t
+mraa_spi_soft_frequency_replace(mraa_spi_context dev, int hz)
+{
+    if (hz <= 0) {
+        syslog(LOG_ERR, "spi: soft: invalid frequency %d", hz);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    dev->clock = hz;
+    dev->half_period_ns = 500000000L / hz;
+    dev->clock_achieved = 0;
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_spi_soft_lsbmode_replace(mraa_spi_context dev, mraa_boolean_t lsb)
+{
+    // bit order is free when bit-banging, no software reversal needed
+    dev->lsb = lsb;
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_spi_soft_bit_per_word_replace(mraa_spi_context dev, unsigned int bits)
+{
+    if (bits < 1 || bits > 32) {
+        syslog(LOG_ERR, "spi: soft: invalid bits per word %u", bits);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    dev->bpw = bits;
+    return MRAA_SUCCESS;
+}
+
+static mraa_result_t
+mraa_spi_soft_buswidth_replace(mraa_spi_context dev, mraa_spi_buswidth_t tx, mraa_spi_buswidth_t rx)
+{
+    if (tx != MRAA_SPI_BUSWIDTH_SINGLE || rx != MRAA_SPI_BUSWIDTH_SINGLE) {
+        syslog(LOG_NOTICE, "spi: soft: only single bus width is available");
+    }
+    dev->tx_nbits = 1;
+    dev->rx_nbits = 1;
+    return MRAA_SUCCESS;
+}
+
+static int
+mraa_spi_soft_write_replace(mraa_spi_context dev, uint8_t data)
+{
+    uint8_t rx = 0;
+    if (mraa_spi_soft_transfer(dev, &data, &rx, sizeof(data)) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return rx;
+}
+
+static int
+mraa_spi_soft_write_word_replace(mraa_spi_context dev, uint16_t data)
+{
+    uint16_t rx = 0;
+    if (mraa_spi_soft_transfer(dev, (uint8_t*) &data, (uint8_t*) &rx, sizeof(data)) != MRAA_SUCCESS) {
+        return -1;
+    }
+    return rx;
+}
+
+static mraa_result_t
+mraa_spi_soft_transfer_buf_replace(mraa_spi_context dev, uint8_t* data, uint8_t* rxbuf, int length)
+{
+    return mraa_spi_soft_transfer(dev, data, rxbuf, length);
+}
+
+static mraa_result_t
+mraa_spi_soft_transfer_buf_word_replace(mraa_spi_context dev, uint16_t* data, uint16_t* rxbuf, int length)
+{
+    return mraa_spi_soft_transfer(dev, (uint8_t*) data, (uint8_t*) rxbuf, length);
+}
+
+static mraa_result_t
+mraa_spi_soft_transfer_buf_word32_replace(mraa_spi_context dev, uint32_t* data, uint32_t* rxbuf, int length)
+{
+    return mraa_spi_soft_transfer(dev, (uint8_t*) data, (uint8_t*) rxbuf, length);
+}
+
+static mraa_result_t
+mraa_spi_soft_transfer_segments_replace(mraa_spi_context dev, mraa_spi_segment_t* segments, int count)
+{
+    int64_t start = mraa_monotonic_ns();
+    int64_t deadline = start;
+    int64_t bits = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        if (segments[i].length <= 0) {
+            syslog(LOG_ERR, "spi: soft: Length given is equal to or less than zero, cannot proceed");
+            return MRAA_ERROR_INVALID_PARAMETER;
+        }
+    }
+
+    mraa_result_t ret = mraa_spi_soft_select(dev, 1, &deadline);
+    for (i = 0; i < count && ret == MRAA_SUCCESS; i++) {
+        ret = mraa_spi_soft_shift_buf(dev, segments[i].txbuf, segments[i].rxbuf, segments[i].length, &deadline);
+        bits += mraa_spi_soft_bits(dev, segments[i].length);
+        if (ret == MRAA_SUCCESS && segments[i].cs_change && i < count - 1) {
+            ret = mraa_spi_soft_select(dev, 0, &deadline);
+            if (ret == MRAA_SUCCESS) {
+                ret = mraa_spi_soft_select(dev, 1, &deadline);
+            }
+        }
+    }
+    if (mraa_spi_soft_select(dev, 0, &deadline) != MRAA_SUCCESS && ret == MRAA_SUCCESS) {
+        ret = MRAA_ERROR_INVALID_RESOURCE;
+    }
+    if (ret == MRAA_SUCCESS) {
+        mraa_spi_soft_account(dev, start, bits);
+    }
+    return ret;
+}
+
+static mraa_result_t
+mraa_spi_soft_stop_replace(mraa_spi_context dev)
+{
+    if (dev->gpio_out != NULL) {
+        mraa_gpio_close(dev->gpio_out);
+    }
+    if (dev->gpio_miso != NULL) {
+        mraa_gpio_close(dev->gpio_miso);
+    }
+    free(dev);
+    return MRAA_SUCCESS;
+}
+
+static mraa_adv_func_t mraa_spi_soft_func_table = {
+    .spi_lsbmode_replace = &mraa_spi_soft_lsbmode_replace,
+    .spi_mode_replace = &mraa_spi_soft_mode_replace,
+    .spi_bit_per_word_replace = &mraa_spi_soft_bit_per_word_replace,
+    .spi_frequency_replace = &mraa_spi_soft_frequency_replace,
+    .spi_transfer_buf_replace = &mraa_spi_soft_transfer_buf_replace,
+    .spi_transfer_buf_word_replace = &mraa_spi_soft_transfer_buf_word_replace,
+    .spi_transfer_buf_word32_replace = &mraa_spi_soft_transfer_buf_word32_replace,
+    .spi_buswidth_replace = &mraa_spi_soft_buswidth_replace,
+    .spi_transfer_segments_replace = &mraa_spi_soft_transfer_segments_replace,
+    .spi_write_replace = &mraa_spi_soft_write_replace,
+    .spi_write_word_replace = &mraa_spi_soft_write_word_replace,
+    .spi_stop_replace = &mraa_spi_soft_stop_replace,
+};
+
+/**
+ * Prefer memory mapped register access for a pin where the platform has it
+ */
+static void
+mraa_spi_soft_use_mmap(mraa_gpio_context gpio)
+{
+    if (!plat->chardev_capable && IS_FUNC_DEFINED(gpio, gpio_mmap_setup)) {
+        if (gpio->advance_func->gpio_mmap_setup(gpio, 1) != MRAA_SUCCESS) {
+            syslog(LOG_NOTICE, "spi: soft: no mmap access for gpio %d, using sysfs", gpio->pin);
+        }
+    }
+}
+
+mraa_spi_context
+mraa_spi_soft_init(mraa_spi_bus_t* bus)
+{
+    int pins[3] = { bus->sclk, bus->mosi, bus->cs };
+    int num_out = bus->cs >= 0 ? 3 : 2;
+
+    if (bus->sclk < 0 || bus->mosi < 0) {
+        syslog(LOG_ERR, "spi: soft: bus needs at least clock and mosi pins");
+        return NULL;
+    }
+
+    mraa_spi_context dev = (mraa_spi_context) calloc(1, sizeof(struct _spi));
+    if (dev == NULL) {
+        syslog(LOG_CRIT, "spi: soft: Failed to allocate memory for context");
+        return NULL;
+    }
+    dev->advance_func = &mraa_spi_soft_func_table;
+    dev->devfd = -1;
+    mraa_spi_reset_stats(dev);
+
+    dev->gpio_out = mraa_gpio_init_multi(pins, num_out);
+    if (dev->gpio_out == NULL) {
+        syslog(LOG_ERR, "spi: soft: Failed to initialise output gpios");
+        goto init_fail;
+    }
+    if (!plat->chardev_capable) {
+        // the sysfs fallback skips pins it fails to open
+        int count = 0;
+        mraa_gpio_context it;
+        for (it = dev->gpio_out; it != NULL; it = it->next) {
+            count++;
+        }
+        if (count != num_out) {
+            syslog(LOG_ERR, "spi: soft: Failed to initialise output gpios");
+            goto init_fail;
+        }
+    }
+
+    // set direction per pin, platform replace hooks only handle single pins
+    mraa_gpio_context it = dev->gpio_out;
+    while (it != NULL) {
+        if (mraa_gpio_dir(it, MRAA_GPIO_OUT) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "spi: soft: Failed to set output direction");
+            goto init_fail;
+        }
+        mraa_spi_soft_use_mmap(it);
+        it = plat->chardev_capable ? NULL : it->next;
+    }
+
+    if (bus->miso >= 0) {
+        dev->gpio_miso = mraa_gpio_init(bus->miso);
+        if (dev->gpio_miso == NULL || mraa_gpio_dir(dev->gpio_miso, MRAA_GPIO_IN) != MRAA_SUCCESS) {
+            syslog(LOG_ERR, "spi: soft: Failed to initialise miso gpio");
+            goto init_fail;
+        }
+        mraa_spi_soft_use_mmap(dev->gpio_miso);
+    }
+
+    // force every pin to be written once, chip select starts released
+    dev->gpio_levels[SOFT_SPI_SCLK] = -1;
+    dev->gpio_levels[SOFT_SPI_MOSI] = -1;
+    dev->gpio_levels[SOFT_SPI_CS] = -1;
+    int levels[3] = { 0, 0, 1 };
+    if (mraa_spi_soft_drive(dev, levels) != MRAA_SUCCESS ||
+        mraa_spi_mode(dev, MRAA_SPI_MODE0) != MRAA_SUCCESS ||
+        mraa_spi_lsbmode(dev, 0) != MRAA_SUCCESS ||
+        mraa_spi_bit_per_word(dev, 8) != MRAA_SUCCESS ||
+        mraa_spi_frequency(dev, SOFT_SPI_DEFAULT_FREQ) != MRAA_SUCCESS) {
+        goto init_fail;
+    }
+
+    return dev;
+
+init_fail:
+    mraa_spi_soft_stop_replace(dev);
+    return NULL;
+}
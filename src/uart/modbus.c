@@ -0,0 +1,656 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "modbus.h"
+#include "mraa_internal.h"
+#include "uart/modbus_crc.h"
+
+#define MODBUS_DEFAULT_TIMEOUT_MS 100
+#define MODBUS_EXCEPTION 0x80
+
+// CRC16 with the reflected polynomial 0xA001, one table lookup per byte
+const uint16_t mraa_modbus_crc_table[256] = {
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+uint16_t
+mraa_modbus_crc16(const uint8_t* data, size_t length)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (length--) {
+        crc = (crc >> 8) ^ mraa_modbus_crc_table[(crc ^ *data++) & 0xFF];
+    }
+    return crc;
+}
+
+// keep the line quiet for the 3.5 character interval since the last frame
+static void
+modbus_wait_gap(mraa_modbus_context dev)
+{
+    uint64_t now = mraa_monotonic_ns() / 1000;
+    uint64_t ready = dev->idle_since_us + dev->gap_us;
+
+    if (ready > now) {
+        struct timespec ts = { (ready - now) / 1000000, ((ready - now) % 1000000) * 1000 };
+        nanosleep(&ts, NULL);
+    }
+}
+
+// throw away whatever a late or chatty slave left in the receive buffer
+static void
+modbus_drain(mraa_modbus_context dev)
+{
+    char junk[64];
+
+    while (mraa_uart_data_available(dev->uart, 0)) {
+        if (mraa_uart_read(dev->uart, junk, sizeof(junk)) <= 0) {
+            break;
+        }
+    }
+}
+
+// Length of a response frame once its first three bytes are in, 0 if the
+// function code doesn't tell and the end has to be found by silence
+static size_t
+modbus_response_length(const uint8_t* frame)
+{
+    if (frame[1] & MODBUS_EXCEPTION) {
+        return 5;
+    }
+    switch (frame[1]) {
+        case 0x01:
+        case 0x02:
+        case 0x03:
+        case 0x04:
+        case 0x17:
+            return 3 + frame[2] + 2;
+        case 0x05:
+        case 0x06:
+        case 0x0F:
+        case 0x10:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+static mraa_result_t
+modbus_receive(mraa_modbus_context dev, uint64_t sent_us, uint8_t* frame, size_t* length)
+{
+    uint64_t deadline = sent_us + (uint64_t) dev->timeout_ms * 1000;
+    unsigned int gap_ms = (dev->gap_us + 999) / 1000 + 1;
+    size_t got = 0, need = 0;
+    mraa_boolean_t by_silence = 0;
+
+    while (need == 0 || got < need) {
+        uint64_t now = mraa_monotonic_ns() / 1000;
+        unsigned int wait = now < deadline ? (deadline - now + 999) / 1000 : 0;
+        if (by_silence && wait > gap_ms) {
+            wait = gap_ms;
+        }
+        if (!mraa_uart_data_available(dev->uart, wait)) {
+            if (by_silence) {
+                break;
+            }
+            return MRAA_ERROR_NO_DATA_AVAILABLE;
+        }
+        size_t room = (need > 0 ? need : MRAA_MODBUS_MAX_FRAME) - got;
+        int n = mraa_uart_read(dev->uart, (char*) frame + got, room);
+        if (n <= 0) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        got += n;
+        if (need == 0 && !by_silence && got >= 3) {
+            need = modbus_response_length(frame);
+            by_silence = need == 0;
+            // a byte count no frame can have
+            if (need > MRAA_MODBUS_MAX_FRAME) {
+                return MRAA_ERROR_UNSPECIFIED;
+            }
+        }
+        if (by_silence && got == MRAA_MODBUS_MAX_FRAME) {
+            break;
+        }
+    }
+    *length = got;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_request(mraa_modbus_context dev,
+                    uint8_t slave,
+                    const uint8_t* pdu,
+                    size_t pdu_length,
+                    uint8_t* response,
+                    size_t* response_length)
+{
+    uint8_t frame[MRAA_MODBUS_MAX_FRAME];
+    size_t length;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: request: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (slave >= MRAA_MODBUS_MAX_SLAVES || pdu == NULL || pdu_length == 0 ||
+        pdu_length > MRAA_MODBUS_MAX_FRAME - 3) {
+        syslog(LOG_ERR, "modbus: request: invalid slave %d or pdu", slave);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_modbus_slave_stats_t* stats = &dev->stats[slave];
+    frame[0] = slave;
+    memcpy(frame + 1, pdu, pdu_length);
+    uint16_t crc = mraa_modbus_crc16(frame, pdu_length + 1);
+    frame[pdu_length + 1] = crc & 0xFF;
+    frame[pdu_length + 2] = crc >> 8;
+    length = pdu_length + 3;
+
+    modbus_wait_gap(dev);
+    modbus_drain(dev);
+    stats->requests++;
+
+    uint64_t start = mraa_monotonic_ns() / 1000;
+    if (mraa_uart_write(dev->uart, (char*) frame, length) != (int) length) {
+        syslog(LOG_ERR, "modbus: request: uart write failed");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    // write() returns once the driver has the data, the frame ends later
+    uint64_t sent = start + length * dev->char_us;
+    uint64_t now = mraa_monotonic_ns() / 1000;
+    if (now > sent) {
+        sent = now;
+    }
+
+    if (slave == 0) {
+        // nobody answers a broadcast
+        dev->idle_since_us = sent;
+        if (response_length != NULL) {
+            *response_length = 0;
+        }
+        return MRAA_SUCCESS;
+    }
+
+    mraa_result_t ret = modbus_receive(dev, sent, frame, &length);
+    dev->idle_since_us = mraa_monotonic_ns() / 1000;
+    if (ret == MRAA_ERROR_NO_DATA_AVAILABLE) {
+        stats->timeouts++;
+        return ret;
+    }
+    if (ret == MRAA_ERROR_INVALID_RESOURCE) {
+        stats->io_errors++;
+        modbus_drain(dev);
+        return ret;
+    }
+    if (ret != MRAA_SUCCESS || length < 4) {
+        stats->frame_errors++;
+        modbus_drain(dev);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    // a CRC over the data and its own CRC comes out as zero
+    if (mraa_modbus_crc16(frame, length) != 0) {
+        stats->crc_errors++;
+        modbus_drain(dev);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    if (frame[0] != slave || (frame[1] & ~MODBUS_EXCEPTION) != pdu[0]) {
+        stats->frame_errors++;
+        modbus_drain(dev);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    uint64_t latency = dev->idle_since_us - sent;
+    stats->responses++;
+    stats->latency_total_us += latency;
+    if (stats->latency_min_us == 0 || latency < stats->latency_min_us) {
+        stats->latency_min_us = latency;
+    }
+    if (latency > stats->latency_max_us) {
+        stats->latency_max_us = latency;
+    }
+
+    if (response != NULL) {
+        memcpy(response, frame + 1, length - 3);
+    }
+    if (response_length != NULL) {
+        *response_length = length - 3;
+    }
+    if (frame[1] & MODBUS_EXCEPTION) {
+        stats->exceptions++;
+        stats->last_exception = frame[2];
+        return MRAA_ERROR_UNSPECIFIED;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_read_registers(mraa_modbus_context dev,
+                           uint8_t slave,
+                           mraa_modbus_function_t function,
+                           uint16_t addr,
+                           uint16_t count,
+                           uint16_t* dest)
+{
+    uint8_t pdu[5] = { function, addr >> 8, addr & 0xFF, count >> 8, count & 0xFF };
+    uint8_t response[MRAA_MODBUS_MAX_FRAME];
+    size_t length;
+    int i;
+
+    if (dest == NULL || count == 0 || count > MRAA_MODBUS_MAX_READ_REGISTERS ||
+        (function != MRAA_MODBUS_READ_HOLDING_REGISTERS && function != MRAA_MODBUS_READ_INPUT_REGISTERS)) {
+        syslog(LOG_ERR, "modbus: read_registers: invalid function or count");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    mraa_result_t ret = mraa_modbus_request(dev, slave, pdu, sizeof(pdu), response, &length);
+    if (ret != MRAA_SUCCESS) {
+        return ret;
+    }
+    if (length != 2 + (size_t) count * 2 || response[1] != count * 2) {
+        syslog(LOG_ERR, "modbus: read_registers: slave %d sent %d bytes for %d registers", slave,
+               (int) length, count);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    for (i = 0; i < count; i++) {
+        dest[i] = (response[2 + i * 2] << 8) | response[3 + i * 2];
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_write_register(mraa_modbus_context dev, uint8_t slave, uint16_t addr, uint16_t value)
+{
+    uint8_t pdu[5] = { MRAA_MODBUS_WRITE_SINGLE_REGISTER, addr >> 8, addr & 0xFF, value >> 8, value & 0xFF };
+    uint8_t response[MRAA_MODBUS_MAX_FRAME];
+    size_t length;
+
+    mraa_result_t ret = mraa_modbus_request(dev, slave, pdu, sizeof(pdu), response, &length);
+    if (ret != MRAA_SUCCESS || slave == 0) {
+        return ret;
+    }
+    // the slave echoes the request
+    if (length != sizeof(pdu) || memcmp(pdu, response, sizeof(pdu)) != 0) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_write_registers(mraa_modbus_context dev,
+                            uint8_t slave,
+                            uint16_t addr,
+                            uint16_t count,
+                            const uint16_t* values)
+{
+    uint8_t pdu[6 + MRAA_MODBUS_MAX_WRITE_REGISTERS * 2];
+    uint8_t response[MRAA_MODBUS_MAX_FRAME];
+    size_t length;
+    int i;
+
+    if (values == NULL || count == 0 || count > MRAA_MODBUS_MAX_WRITE_REGISTERS) {
+        syslog(LOG_ERR, "modbus: write_registers: invalid count %d", count);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    pdu[0] = MRAA_MODBUS_WRITE_MULTIPLE_REGISTERS;
+    pdu[1] = addr >> 8;
+    pdu[2] = addr & 0xFF;
+    pdu[3] = count >> 8;
+    pdu[4] = count & 0xFF;
+    pdu[5] = count * 2;
+    for (i = 0; i < count; i++) {
+        pdu[6 + i * 2] = values[i] >> 8;
+        pdu[7 + i * 2] = values[i] & 0xFF;
+    }
+
+    mraa_result_t ret = mraa_modbus_request(dev, slave, pdu, 6 + count * 2, response, &length);
+    if (ret != MRAA_SUCCESS || slave == 0) {
+        return ret;
+    }
+    if (length != 5 || memcmp(pdu, response, 5) != 0) {
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+static int
+modbus_poll_compare(const void* a, const void* b)
+{
+    const mraa_modbus_poll_t* pa = *(const mraa_modbus_poll_t* const*) a;
+    const mraa_modbus_poll_t* pb = *(const mraa_modbus_poll_t* const*) b;
+
+    if (pa->slave != pb->slave) {
+        return pa->slave - pb->slave;
+    }
+    if (pa->function != pb->function) {
+        return pa->function - pb->function;
+    }
+    return pa->addr - pb->addr;
+}
+
+// Read the registers covering polls[0..count) in one request and hand
+// every poll its part
+static void
+modbus_poll_merged(mraa_modbus_context dev, mraa_modbus_poll_t** polls, int count, uint16_t first,
+                   uint16_t span, uint64_t now_ms)
+{
+    uint16_t values[MRAA_MODBUS_MAX_READ_REGISTERS];
+    int i;
+
+    mraa_result_t ret = mraa_modbus_read_registers(dev, polls[0]->slave, polls[0]->function, first, span, values);
+    for (i = 0; i < count; i++) {
+        mraa_modbus_poll_t* p = polls[i];
+        if (ret == MRAA_SUCCESS) {
+            memcpy(p->dest, values + (p->addr - first), p->count * sizeof(uint16_t));
+        }
+        p->last_result = ret;
+        // keep the phase unless we fell a whole period behind
+        p->next_due_ms += p->period_ms;
+        if (p->next_due_ms <= now_ms) {
+            p->next_due_ms = now_ms + p->period_ms;
+        }
+    }
+}
+
+int
+mraa_modbus_poll(mraa_modbus_context dev)
+{
+    int i, due = 0, sent = 0;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: poll: context is NULL");
+        return -1;
+    }
+    if (dev->poll_capacity == 0) {
+        return 0;
+    }
+
+    mraa_modbus_poll_t** order = malloc(dev->poll_capacity * sizeof(mraa_modbus_poll_t*));
+    if (order == NULL) {
+        syslog(LOG_CRIT, "modbus: poll: Failed to allocate memory");
+        return -1;
+    }
+
+    uint64_t now_ms = mraa_monotonic_ns() / 1000000;
+    for (i = 0; i < dev->poll_capacity; i++) {
+        if (dev->polls[i].active && dev->polls[i].next_due_ms <= now_ms) {
+            order[due++] = &dev->polls[i];
+        }
+    }
+    qsort(order, due, sizeof(mraa_modbus_poll_t*), modbus_poll_compare);
+
+    // walk runs of the same slave and function, extending a request for as
+    // long as the next read touches or overlaps it and the total fits
+    i = 0;
+    while (i < due) {
+        int first = i;
+        uint16_t start = order[i]->addr;
+        uint32_t end = (uint32_t) start + order[i]->count;
+        for (i++; i < due; i++) {
+            mraa_modbus_poll_t* p = order[i];
+            uint32_t p_end = (uint32_t) p->addr + p->count;
+            if (p->slave != order[first]->slave || p->function != order[first]->function ||
+                p->addr > end || (p_end > end ? p_end : end) - start > MRAA_MODBUS_MAX_READ_REGISTERS) {
+                break;
+            }
+            if (p_end > end) {
+                end = p_end;
+            }
+        }
+        modbus_poll_merged(dev, order + first, i - first, start, end - start, now_ms);
+        sent++;
+    }
+
+    free(order);
+    return sent;
+}
+
+int
+mraa_modbus_poll_add(mraa_modbus_context dev,
+                     uint8_t slave,
+                     mraa_modbus_function_t function,
+                     uint16_t addr,
+                     uint16_t count,
+                     uint16_t* dest,
+                     unsigned int period_ms)
+{
+    int i;
+
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: poll_add: context is NULL");
+        return -1;
+    }
+    if (slave == 0 || slave >= MRAA_MODBUS_MAX_SLAVES || dest == NULL || count == 0 ||
+        count > MRAA_MODBUS_MAX_READ_REGISTERS || (uint32_t) addr + count > 0x10000 ||
+        (function != MRAA_MODBUS_READ_HOLDING_REGISTERS && function != MRAA_MODBUS_READ_INPUT_REGISTERS)) {
+        syslog(LOG_ERR, "modbus: poll_add: invalid slave, function or range");
+        return -1;
+    }
+
+    for (i = 0; i < dev->poll_capacity; i++) {
+        if (!dev->polls[i].active) {
+            break;
+        }
+    }
+    if (i == dev->poll_capacity) {
+        int capacity = dev->poll_capacity > 0 ? dev->poll_capacity * 2 : 8;
+        mraa_modbus_poll_t* polls = realloc(dev->polls, capacity * sizeof(mraa_modbus_poll_t));
+        if (polls == NULL) {
+            syslog(LOG_CRIT, "modbus: poll_add: Failed to allocate memory");
+            return -1;
+        }
+        memset(polls + dev->poll_capacity, 0, (capacity - dev->poll_capacity) * sizeof(mraa_modbus_poll_t));
+        dev->polls = polls;
+        dev->poll_capacity = capacity;
+    }
+
+    mraa_modbus_poll_t* p = &dev->polls[i];
+    p->slave = slave;
+    p->function = function;
+    p->addr = addr;
+    p->count = count;
+    p->dest = dest;
+    p->period_ms = period_ms;
+    p->next_due_ms = mraa_monotonic_ns() / 1000000;
+    p->last_result = MRAA_ERROR_NO_DATA_AVAILABLE;
+    p->active = 1;
+
+    return i;
+}
+
+mraa_result_t
+mraa_modbus_poll_remove(mraa_modbus_context dev, int id)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: poll_remove: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (id < 0 || id >= dev->poll_capacity || !dev->polls[id].active) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    dev->polls[id].active = 0;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_poll_result(mraa_modbus_context dev, int id)
+{
+    if (dev == NULL) {
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (id < 0 || id >= dev->poll_capacity || !dev->polls[id].active) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    return dev->polls[id].last_result;
+}
+
+int
+mraa_modbus_poll_next_ms(mraa_modbus_context dev)
+{
+    int64_t next = -1;
+    int i;
+
+    if (dev == NULL) {
+        return -1;
+    }
+
+    int64_t now_ms = mraa_monotonic_ns() / 1000000;
+    for (i = 0; i < dev->poll_capacity; i++) {
+        if (dev->polls[i].active) {
+            int64_t left = (int64_t) dev->polls[i].next_due_ms - now_ms;
+            if (left < 0) {
+                left = 0;
+            }
+            if (next < 0 || left < next) {
+                next = left;
+            }
+        }
+    }
+    return (int) next;
+}
+
+mraa_result_t
+mraa_modbus_get_stats(mraa_modbus_context dev, uint8_t slave, mraa_modbus_slave_stats_t* stats)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: get_stats: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (slave >= MRAA_MODBUS_MAX_SLAVES || stats == NULL) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    *stats = dev->stats[slave];
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_reset_stats(mraa_modbus_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: reset_stats: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    memset(dev->stats, 0, sizeof(dev->stats));
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_modbus_set_timeout(mraa_modbus_context dev, unsigned int timeout_ms)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: set_timeout: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    dev->timeout_ms = timeout_ms;
+    return MRAA_SUCCESS;
+}
+
+static mraa_modbus_context
+modbus_init_internal(mraa_uart_context uart, unsigned int baud, mraa_uart_parity_t parity)
+{
+    if (uart == NULL) {
+        return NULL;
+    }
+
+    // RTU is always 11 bits a character, a missing parity bit becomes a
+    // second stop bit. Flow control is left alone, the port is raw already
+    // and mraa_uart_set_flowcontrol() would put a STOP character on the bus.
+    if (mraa_uart_set_baudrate(uart, baud) != MRAA_SUCCESS ||
+        mraa_uart_set_mode(uart, 8, parity, parity == MRAA_UART_PARITY_NONE ? 2 : 1) != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "modbus: init: failed to set up uart");
+        mraa_uart_stop(uart);
+        return NULL;
+    }
+
+    mraa_modbus_context dev = calloc(1, sizeof(struct _mraa_modbus));
+    if (dev == NULL) {
+        syslog(LOG_CRIT, "modbus: init: Failed to allocate memory for context");
+        mraa_uart_stop(uart);
+        return NULL;
+    }
+    dev->uart = uart;
+    dev->baud = baud;
+    dev->char_us = 11000000 / baud;
+    // above 19200 baud the specification fixes the interval instead
+    dev->gap_us = baud > 19200 ? 1750 : 38500000 / baud;
+    dev->timeout_ms = MODBUS_DEFAULT_TIMEOUT_MS;
+    dev->idle_since_us = mraa_monotonic_ns() / 1000;
+
+    return dev;
+}
+
+mraa_modbus_context
+mraa_modbus_init(int uart, unsigned int baud, mraa_uart_parity_t parity)
+{
+    if (baud == 0) {
+        syslog(LOG_ERR, "modbus: init: invalid baudrate");
+        return NULL;
+    }
+    return modbus_init_internal(mraa_uart_init(uart), baud, parity);
+}
+
+mraa_modbus_context
+mraa_modbus_init_raw(const char* path, unsigned int baud, mraa_uart_parity_t parity)
+{
+    if (baud == 0) {
+        syslog(LOG_ERR, "modbus: init: invalid baudrate");
+        return NULL;
+    }
+    return modbus_init_internal(mraa_uart_init_raw(path), baud, parity);
+}
+
+mraa_result_t
+mraa_modbus_stop(mraa_modbus_context dev)
+{
+    if (dev == NULL) {
+        syslog(LOG_ERR, "modbus: stop: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_uart_stop(dev->uart);
+    free(dev->polls);
+    free(dev);
+    return MRAA_SUCCESS;
+}
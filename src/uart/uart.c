@@ -8,134 +8,92 @@
  * SPDX-License-Identifier: MIT
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <string.h>
 #include <termios.h>
-#include <sys/select.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <linux/serial.h>
+#include <limits.h>
 #include <errno.h>
 #include <string.h>
 
 #include "uart.h"
+#include "uart_group.h"
 #include "mraa_internal.h"
+#include "uart/uart_termios2.h"
+#include "uart/uart_rs485.h"
+#include "uart/uart_coalesce.h"
 
 #ifndef CMSPAR
 #define CMSPAR   010000000000
 #endif
 
+struct baud_table {
+    speed_t speedt;
+    unsigned int baudrate;
+};
+
+static const struct baud_table bauds[] = {
+    { B50, 50 },
+    { B75, 75 },
+    { B110, 110 },
+    { B134, 134 },
+    { B150, 150 },
+    { B200, 200 },
+    { B300, 300 },
+    { B600, 600 },
+    { B1200, 1200 },
+    { B1800, 1800 },
+    { B2400, 2400 },
+    { B4800, 4800 },
+    { B9600, 9600 },
+    { B19200, 19200 },
+    { B38400, 38400 },
+    { B57600, 57600 },
+    { B115200, 115200 },
+    { B230400, 230400 },
+    { B460800, 460800 },
+    { B500000, 500000 },
+    { B576000, 576000 },
+    { B921600, 921600 },
+    { B1000000, 1000000 },
+    { B1152000, 1152000 },
+    { B1500000, 1500000 },
+    { B2000000, 2000000 },
+    { B2500000, 2500000 },
+    { B3000000, 3000000 },
+#if !defined(MSYS)
+    { B3500000, 3500000 },
+    { B4000000, 4000000 },
+#endif
+    { B0, 0} /* Must be last in this table */
+};
+
 // This function takes an unsigned int and converts it to a B* speed_t
-// that can be used with linux/posix termios
+// that can be used with linux/posix termios, B0 if there is none
 static speed_t
 uint2speed(unsigned int speed)
 {
-    switch (speed) {
-        case 0:
-            return B0; // hangup, not too useful otherwise
-        case 50:
-            return B50;
-        case 75:
-            return B75;
-        case 110:
-            return B110;
-        case 150:
-            return B150;
-        case 200:
-            return B200;
-        case 300:
-            return B300;
-        case 600:
-            return B600;
-        case 1200:
-            return B1200;
-        case 1800:
-            return B1800;
-        case 2400:
-            return B2400;
-        case 4800:
-            return B4800;
-        case 9600:
-            return B9600;
-        case 19200:
-            return B19200;
-        case 38400:
-            return B38400;
-        case 57600:
-            return B57600;
-        case 115200:
-            return B115200;
-        case 230400:
-            return B230400;
-        case 460800:
-            return B460800;
-        case 500000:
-            return B500000;
-        case 576000:
-            return B576000;
-        case 921600:
-            return B921600;
-        case 1000000:
-            return B1000000;
-        case 1152000:
-            return B1152000;
-        case 1500000:
-            return B1500000;
-        case 2000000:
-            return B2000000;
-        case 2500000:
-            return B2500000;
-        case 3000000:
-            return B3000000;
-#if !defined(MSYS)
-        case 3500000:
-            return B3500000;
-        case 4000000:
-            return B4000000;
-#endif
-        default:
-            // if we are here, then an unsupported baudrate was selected.
-            return B0;
+    int i = 0;
+
+    while (bauds[i].baudrate > 0) {
+        if (speed == bauds[i].baudrate) {
+            return bauds[i].speedt;
+        }
+        i++;
     }
+    // if we are here, then an unsupported baudrate was selected.
+    return B0;
 }
 
 static unsigned int speed_to_uint(speed_t speedt) {
-    struct baud_table {
-        speed_t speedt;
-        unsigned int baudrate;
-    };
-    static const struct baud_table bauds[] = {
-        { B50, 50 },
-        { B75, 75 },
-        { B110, 110 },
-        { B150, 150 },
-        { B200, 200 },
-        { B300, 300 },
-        { B600, 600 },
-        { B1200, 1200 },
-        { B1800, 1800 },
-        { B2400, 2400 },
-        { B9600, 9600 },
-        { B19200, 19200 },
-        { B38400, 38400 },
-        { B57600, 57600 },
-        { B115200, 115200 },
-        { B230400, 230400 },
-        { B460800, 460800 },
-        { B500000, 500000 },
-        { B576000, 576000 },
-        { B921600, 921600 },
-        { B1000000, 1000000 },
-        { B1152000, 1152000 },
-        { B1500000, 1500000 },
-        { B2000000, 2000000 },
-        { B2500000, 2500000 },
-        { B3000000, 3000000 },
-#if !defined(MSYS)
-        { B3500000, 3500000 },
-        { B4000000, 4000000 },
-#endif
-        { B0, 0} /* Must be last in this table */
-    };
     int i = 0;
 
     while (bauds[i].baudrate > 0) {
@@ -147,6 +105,138 @@ static unsigned int speed_to_uint(speed_t speedt) {
     return 0;
 }
 
+// read() with the millisecond timeouts of mraa_uart_set_timeout(): wait
+// up to the read timeout for the first byte, then keep collecting while
+// bytes come in closer together than the interchar gap
+static int
+mraa_uart_read_timed(mraa_uart_context dev, char* buf, size_t len)
+{
+    int64_t deadline = (int64_t) (mraa_monotonic_ns() / 1000000) + dev->read_timeout_ms;
+    size_t got = 0;
+
+    while (got < len) {
+        int64_t wait = -1;
+        if (got > 0) {
+            if (dev->interchar_ms <= 0) {
+                break;
+            }
+            wait = dev->interchar_ms;
+        }
+        // the read timeout only bounds the wait for the first byte
+        if (dev->read_timeout_ms > 0 && got == 0) {
+            int64_t left = deadline - (int64_t) (mraa_monotonic_ns() / 1000000);
+            wait = left > 0 ? left : 0;
+        }
+
+        struct pollfd pfd = { dev->fd, POLLIN, 0 };
+        int ret = poll(&pfd, 1, (int) wait);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+
+        ssize_t n = read(dev->fd, buf + got, len - got);
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+        if (n <= 0) {
+            return got > 0 ? (int) got : (int) n;
+        }
+        got += n;
+    }
+    return got;
+}
+
+// Step an iovec array past n written bytes
+static void
+mraa_uart_iov_advance(struct iovec** iov, int* count, size_t n)
+{
+    while (*count > 0 && n >= (*iov)->iov_len) {
+        n -= (*iov)->iov_len;
+        (*iov)++;
+        (*count)--;
+    }
+    if (*count > 0) {
+        (*iov)->iov_base = (char*) (*iov)->iov_base + n;
+        (*iov)->iov_len -= n;
+    }
+}
+
+// writev() with the write timeout of mraa_uart_set_timeout(): hand the data
+// to the driver and wait for the output queue to drain like tcdrain(), but
+// give up at the deadline. Returns the bytes the driver took, which it
+// sends even when they are still queued at the deadline, and sets errno to
+// ETIMEDOUT then. The iovec array is used up on the way.
+static int
+mraa_uart_write_timed(mraa_uart_context dev, struct iovec* iov, int count)
+{
+    int64_t now = mraa_monotonic_ns() / 1000000;
+    int64_t deadline = now + dev->write_timeout_ms;
+    size_t sent = 0, len = 0;
+    int queued = 0;
+    int i;
+
+    for (i = 0; i < count; i++) {
+        len += iov[i].iov_len;
+    }
+
+    // a blocking write could outlast the deadline
+    int flags = fcntl(dev->fd, F_GETFL);
+    if (flags >= 0 && !(flags & O_NONBLOCK)) {
+        fcntl(dev->fd, F_SETFL, flags | O_NONBLOCK);
+    }
+
+    while (sent < len && now < deadline) {
+        struct pollfd pfd = { dev->fd, POLLOUT, 0 };
+        int ret = poll(&pfd, 1, (int) (deadline - now));
+        now = mraa_monotonic_ns() / 1000000;
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        ssize_t n = writev(dev->fd, iov, count);
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+        if (n < 0) {
+            syslog(LOG_ERR, "uart%i: write: %s", dev->index, strerror(errno));
+            sent = 0;
+            break;
+        }
+        sent += n;
+        mraa_uart_iov_advance(&iov, &count, n);
+    }
+
+    if (flags >= 0 && !(flags & O_NONBLOCK)) {
+        fcntl(dev->fd, F_SETFL, flags);
+    }
+    if (sent == 0 && len > 0 && now < deadline) {
+        return -1;
+    }
+
+    while (ioctl(dev->fd, TIOCOUTQ, &queued) == 0 && queued > 0) {
+        now = mraa_monotonic_ns() / 1000000;
+        if (now >= deadline) {
+            break;
+        }
+        // sleep for about the time the queue takes at 10 bits per char
+        int64_t us = dev->baudrate > 0 ? (int64_t) queued * 10000000 / dev->baudrate : 1000;
+        if (us > (deadline - now) * 1000) {
+            us = (deadline - now) * 1000;
+        }
+        usleep(us > 100 ? us : 100);
+    }
+    if (queued > 0) {
+        errno = ETIMEDOUT;
+    }
+
+    return sent;
+}
+
 static mraa_uart_context
 mraa_uart_init_internal(mraa_adv_func_t* func_table)
 {
@@ -157,6 +247,9 @@ mraa_uart_init_internal(mraa_adv_func_t* func_table)
     }
     dev->index = -1;
     dev->fd = -1;
+    dev->de_pin = -1;
+    dev->low_latency_saved = -1;
+    dev->rx_trig_saved = -1;
     dev->advance_func = func_table;
 
     return dev;
@@ -219,6 +312,9 @@ mraa_uart_init(int index)
         return NULL;
     }
     dev->index = index; //Set the board Index.
+    if (plat->uart_dev[index].has_de) {
+        dev->de_pin = plat->uart_dev[index].de;
+    }
 
     if (IS_FUNC_DEFINED(dev, uart_init_post)) {
         mraa_result_t ret = dev->advance_func->uart_init_post(dev);
@@ -315,6 +411,8 @@ init_raw_cleanup:
     return dev;
 }
 
+static void mraa_uart_low_latency_restore(mraa_uart_context dev);
+
 mraa_result_t
 mraa_uart_stop(mraa_uart_context dev)
 {
@@ -323,6 +421,19 @@ mraa_uart_stop(mraa_uart_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->group != NULL) {
+        mraa_uart_group_remove(dev->group, dev);
+    }
+    mraa_uart_set_rx_callback(dev, NULL, NULL, 0, 0);
+    mraa_uart_set_write_coalescing(dev, 0, 0);
+    mraa_uart_set_rs485(dev, NULL);
+    mraa_uart_set_framing(dev, NULL);
+    mraa_uart_low_latency_restore(dev);
+
+    if (IS_FUNC_DEFINED(dev, uart_stop_pre)) {
+        dev->advance_func->uart_stop_pre(dev);
+    }
+
     // just close the device and reset our fd.
     if (dev->fd >= 0) {
         close(dev->fd);
@@ -411,7 +522,10 @@ mraa_uart_settings(int index, const char **devpath, const char **name, int* baud
        }
 
        if (baudrate != NULL) {
-           *baudrate = speed_to_uint(cfgetospeed(&term));
+           *baudrate = mraa_uart_termios2_get_speed(fd);
+           if (*baudrate == 0) {
+               *baudrate = speed_to_uint(cfgetospeed(&term));
+           }
        }
 
        if (ctsrts != NULL) {
@@ -435,6 +549,13 @@ mraa_uart_flush(mraa_uart_context dev)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
+    if (dev->coalesce != NULL) {
+        mraa_result_t ret = mraa_uart_coalesce_flush(dev);
+        if (ret != MRAA_SUCCESS) {
+            return ret;
+        }
+    }
+
     if (IS_FUNC_DEFINED(dev, uart_flush_replace)) {
         return dev->advance_func->uart_flush_replace(dev);
     }
@@ -481,13 +602,30 @@ mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud)
         return dev->advance_func->uart_set_baudrate_replace(dev, baud);
     }
 
+    if (baud == 0) {
+        syslog(LOG_ERR, "uart%i: set_baudrate: invalid baudrate: %i", dev->index, baud);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    // termios2 takes any rate, the driver picks the closest divisor
+    mraa_result_t ret = mraa_uart_termios2_set_speed(dev->fd, baud);
+    if (ret == MRAA_SUCCESS) {
+        dev->baudrate = mraa_uart_termios2_get_speed(dev->fd);
+        if (dev->baudrate != baud) {
+            syslog(LOG_NOTICE, "uart%i: set_baudrate: requested %u, got %u", dev->index, baud, dev->baudrate);
+        }
+        return MRAA_SUCCESS;
+    } else if (ret != MRAA_ERROR_FEATURE_NOT_SUPPORTED) {
+        return ret;
+    }
+
     struct termios termio;
     if (tcgetattr(dev->fd, &termio)) {
         syslog(LOG_ERR, "uart%i: set_baudrate: tcgetattr() failed: %s", dev->index, strerror(errno));
         return MRAA_ERROR_INVALID_RESOURCE;
     }
 
-    // set our baud rates
+    // no termios2, set our baud rates from the B* table
     speed_t speed = uint2speed(baud);
     if (speed == B0)
     {
@@ -502,9 +640,21 @@ mraa_uart_set_baudrate(mraa_uart_context dev, unsigned int baud)
         syslog(LOG_ERR, "uart%i: set_baudrate: tcsetattr() failed: %s", dev->index, strerror(errno));
         return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
     }
+    dev->baudrate = baud;
     return MRAA_SUCCESS;
 }
 
+unsigned int
+mraa_uart_get_baudrate(mraa_uart_context dev)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: get_baudrate: context is NULL");
+        return 0;
+    }
+
+    return dev->baudrate;
+}
+
 mraa_result_t
 mraa_uart_set_mode(mraa_uart_context dev, int bytesize, mraa_uart_parity_t parity, int stopbits)
 {
@@ -666,21 +816,187 @@ mraa_uart_set_timeout(mraa_uart_context dev, int read, int write, int interchar)
         syslog(LOG_ERR, "uart%i: set_timeout: tcgetattr() failed: %s", dev->index, strerror(errno));
         return MRAA_ERROR_INVALID_RESOURCE;
     }
-    if (read > 0) {
-        read = read / 100;
-        if (read == 0)
-            read = 1;
-    }
+    // timeouts are done with poll() in read and write, so let read()
+    // return whatever is there once poll says there is something
     termio.c_lflag &= ~ICANON; /* Set non-canonical mode */
-    termio.c_cc[VTIME] = read; /* Set timeout in tenth seconds */
+    termio.c_cc[VMIN] = 1;
+    termio.c_cc[VTIME] = 0;
     if (tcsetattr(dev->fd, TCSANOW, &termio) < 0) {
         syslog(LOG_ERR, "uart%i: set_timeout: tcsetattr() failed: %s", dev->index, strerror(errno));
         return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
     }
 
+    dev->read_timeout_ms = read > 0 ? read : 0;
+    dev->write_timeout_ms = write > 0 ? write : 0;
+    dev->interchar_ms = interchar > 0 ? interchar : 0;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_set_vmin_vtime(mraa_uart_context dev, unsigned int vmin, unsigned int vtime)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_vmin_vtime: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (vmin > 255 || vtime > 255) {
+        syslog(LOG_ERR, "uart%i: set_vmin_vtime: vmin and vtime must be below 256", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    struct termios termio;
+    if (tcgetattr(dev->fd, &termio)) {
+        syslog(LOG_ERR, "uart%i: set_vmin_vtime: tcgetattr() failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    termio.c_lflag &= ~ICANON;
+    termio.c_cc[VMIN] = vmin;
+    termio.c_cc[VTIME] = vtime;
+    if (tcsetattr(dev->fd, TCSANOW, &termio) < 0) {
+        syslog(LOG_ERR, "uart%i: set_vmin_vtime: tcsetattr() failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    // the driver times reads from now on
+    dev->read_timeout_ms = 0;
+    dev->interchar_ms = 0;
+
+    return MRAA_SUCCESS;
+}
+
+// rx_trig_bytes is an attribute of the tty device, named like the device node
+static int
+mraa_uart_rx_trig_path(mraa_uart_context dev, char* path, size_t size)
+{
+    if (dev->path == NULL) {
+        return -1;
+    }
+    const char* name = strrchr(dev->path, '/');
+    snprintf(path, size, "/sys/class/tty/%s/rx_trig_bytes", name != NULL ? name + 1 : dev->path);
+    return 0;
+}
+
+int
+mraa_uart_get_rx_trigger(mraa_uart_context dev)
+{
+    char path[PATH_MAX];
+    char buf[16];
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: get_rx_trigger: context is NULL");
+        return -1;
+    }
+    if (mraa_uart_rx_trig_path(dev, path, sizeof(path)) < 0) {
+        return -1;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0) {
+        return -1;
+    }
+    buf[n] = '\0';
+    return atoi(buf);
+}
+
+static mraa_result_t
+mraa_uart_set_rx_trigger(mraa_uart_context dev, int bytes)
+{
+    char path[PATH_MAX];
+    char buf[16];
+
+    if (mraa_uart_rx_trig_path(dev, path, sizeof(path)) < 0) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    int fd = open(path, O_WRONLY);
+    if (fd < 0) {
+        syslog(LOG_NOTICE, "uart%i: set_low_latency: no rx_trig_bytes for %s", dev->index, dev->path);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    int len = snprintf(buf, sizeof(buf), "%d", bytes);
+    ssize_t n = write(fd, buf, len);
+    close(fd);
+    if (n != len) {
+        syslog(LOG_ERR, "uart%i: set_low_latency: writing rx_trig_bytes failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_set_low_latency(mraa_uart_context dev, mraa_boolean_t enable, unsigned int rx_trigger)
+{
+    struct serial_struct serial;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_low_latency: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->fd < 0 || ioctl(dev->fd, TIOCGSERIAL, &serial) < 0) {
+        syslog(LOG_NOTICE, "uart%i: set_low_latency: driver doesn't support TIOCGSERIAL", dev->index);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (dev->low_latency_saved < 0) {
+        dev->low_latency_saved = (serial.flags & ASYNC_LOW_LATENCY) != 0;
+    }
+    if (enable) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+    } else {
+        serial.flags &= ~ASYNC_LOW_LATENCY;
+    }
+    if (ioctl(dev->fd, TIOCSSERIAL, &serial) < 0) {
+        syslog(LOG_ERR, "uart%i: set_low_latency: TIOCSSERIAL failed: %s", dev->index, strerror(errno));
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (enable && rx_trigger > 0) {
+        int old = mraa_uart_get_rx_trigger(dev);
+        if (old < 0) {
+            syslog(LOG_NOTICE, "uart%i: set_low_latency: no rx_trig_bytes for %s", dev->index, dev->path);
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        if (dev->rx_trig_saved < 0) {
+            dev->rx_trig_saved = old;
+        }
+        return mraa_uart_set_rx_trigger(dev, rx_trigger);
+    }
+    if (!enable && dev->rx_trig_saved >= 0) {
+        mraa_result_t ret = mraa_uart_set_rx_trigger(dev, dev->rx_trig_saved);
+        dev->rx_trig_saved = -1;
+        return ret;
+    }
+
     return MRAA_SUCCESS;
 }
 
+static void
+mraa_uart_low_latency_restore(mraa_uart_context dev)
+{
+    struct serial_struct serial;
+
+    if (dev->rx_trig_saved >= 0) {
+        mraa_uart_set_rx_trigger(dev, dev->rx_trig_saved);
+        dev->rx_trig_saved = -1;
+    }
+    if (dev->low_latency_saved >= 0 && dev->fd >= 0 && ioctl(dev->fd, TIOCGSERIAL, &serial) == 0) {
+        if (dev->low_latency_saved) {
+            serial.flags |= ASYNC_LOW_LATENCY;
+        } else {
+            serial.flags &= ~ASYNC_LOW_LATENCY;
+        }
+        ioctl(dev->fd, TIOCSSERIAL, &serial);
+    }
+    dev->low_latency_saved = -1;
+}
+
 mraa_result_t
 mraa_uart_set_non_blocking(mraa_uart_context dev, mraa_boolean_t nonblock)
 {
@@ -742,27 +1058,111 @@ mraa_uart_read(mraa_uart_context dev, char* buf, size_t len)
         return MRAA_ERROR_INVALID_RESOURCE;
     }
 
+    if (dev->read_timeout_ms > 0 || dev->interchar_ms > 0) {
+        return mraa_uart_read_timed(dev, buf, len);
+    }
+
     return read(dev->fd, buf, len);
 }
 
+static int
+mraa_uart_write_port(mraa_uart_context dev, const struct iovec* iov, int count)
+{
+    struct iovec local[UART_IOV_LOCAL];
+    int i, sent = 0;
+
+    if (IS_FUNC_DEFINED(dev, uart_write_replace)) {
+        // replacements only know single buffers
+        for (i = 0; i < count; i++) {
+            int n = dev->advance_func->uart_write_replace(dev, iov[i].iov_base, iov[i].iov_len);
+            if (n < 0) {
+                return sent > 0 ? sent : n;
+            }
+            sent += n;
+            if ((size_t) n < iov[i].iov_len) {
+                break;
+            }
+        }
+        return sent;
+    }
+
+    if (dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: write: port is not open", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    if (dev->write_timeout_ms > 0) {
+        // the timed write steps through the array, give it a copy
+        struct iovec* copy = count <= UART_IOV_LOCAL ? local : malloc(count * sizeof(struct iovec));
+        if (copy == NULL) {
+            syslog(LOG_CRIT, "uart%i: write: Failed to allocate memory", dev->index);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+        memcpy(copy, iov, count * sizeof(struct iovec));
+        sent = mraa_uart_write_timed(dev, copy, count);
+        if (copy != local) {
+            free(copy);
+        }
+        return sent;
+    }
+
+    if (count == 1) {
+        return write(dev->fd, iov[0].iov_base, iov[0].iov_len);
+    }
+    return writev(dev->fd, iov, count);
+}
+
+int
+mraa_uart_write_direct(mraa_uart_context dev, const struct iovec* iov, int count)
+{
+    if (dev->rs485_mode == MRAA_UART_RS485_GPIO) {
+        mraa_uart_rs485_begin(dev);
+        int sent = mraa_uart_write_port(dev, iov, count);
+        mraa_uart_rs485_end(dev, sent);
+        return sent;
+    }
+
+    return mraa_uart_write_port(dev, iov, count);
+}
+
 int
 mraa_uart_write(mraa_uart_context dev, const char* buf, size_t len)
 {
+    struct iovec iov = { (void*) buf, len };
+
     if (!dev) {
         syslog(LOG_ERR, "uart: write: context is NULL");
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    if (IS_FUNC_DEFINED(dev, uart_write_replace)) {
-        return dev->advance_func->uart_write_replace(dev, buf, len);
+    if (dev->coalesce != NULL) {
+        return mraa_uart_coalesce_write(dev, &iov, 1);
     }
 
-    if (dev->fd < 0) {
-        syslog(LOG_ERR, "uart%i: write: port is not open", dev->index);
-        return MRAA_ERROR_INVALID_RESOURCE;
+    return mraa_uart_write_direct(dev, &iov, 1);
+}
+
+int
+mraa_uart_writev(mraa_uart_context dev, const struct iovec* iov, int iovcnt)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: writev: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    return write(dev->fd, buf, len);
+    if ((iov == NULL && iovcnt != 0) || iovcnt < 0 || iovcnt > UART_IOV_MAX) {
+        syslog(LOG_ERR, "uart%i: writev: invalid buffer count %d", dev->index, iovcnt);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    if (iovcnt == 0) {
+        return 0;
+    }
+
+    if (dev->coalesce != NULL) {
+        return mraa_uart_coalesce_write(dev, iov, iovcnt);
+    }
+
+    return mraa_uart_write_direct(dev, iov, iovcnt);
 }
 
 mraa_boolean_t
@@ -782,25 +1182,25 @@ mraa_uart_data_available(mraa_uart_context dev, unsigned int millis)
         return 0;
     }
 
-    struct timeval timeout;
+    struct pollfd pfd = { dev->fd, POLLIN, 0 };
+    int64_t deadline = (int64_t) (mraa_monotonic_ns() / 1000000) + millis;
+    int64_t wait = millis;
+    int ret;
 
-    if (millis == 0) {
-        // no waiting
-        timeout.tv_sec = 0;
-        timeout.tv_usec = 0;
-    } else {
-        timeout.tv_sec = millis / 1000;
-        timeout.tv_usec = (millis % 1000) * 1000;
+    // poll rather than select, fd numbers past FD_SETSIZE are fine. Signals
+    // don't restart the wait, only what is left of it is waited for again.
+    for (;;) {
+        ret = poll(&pfd, 1, wait > INT_MAX ? INT_MAX : (int) wait);
+        if (ret >= 0 || errno != EINTR) {
+            break;
+        }
+        wait = deadline - (int64_t) (mraa_monotonic_ns() / 1000000);
+        if (wait < 0) {
+            wait = 0;
+        }
     }
 
-    fd_set readfds;
-
-#if !defined(PERIPHERALMAN)
-    FD_ZERO(&readfds);
-    FD_SET(dev->fd, &readfds);
-#endif
-
-    if (select(dev->fd + 1, &readfds, NULL, NULL, &timeout) > 0) {
+    if (ret > 0 && (pfd.revents & POLLIN)) {
         return 1; // data is ready
     } else {
         return 0;
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "uart.h"
+#include "uart/uart_coalesce.h"
+
+// Small writes are copied into buf until the next one would take it to
+// the threshold, that one then goes out in the same writev() as the
+// buffered bytes, straight from the caller's buffers. With a delay set a
+// timer thread sends what has waited that long.
+struct _uart_coalesce {
+    mraa_uart_context dev;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    char* buf;
+    size_t size;              /**< threshold */
+    size_t count;             /**< bytes waiting in buf */
+    unsigned int delay_ms;    /**< longest a byte may wait, 0 for no timer */
+    struct timespec deadline; /**< when the oldest waiting byte is due */
+    mraa_boolean_t stop;
+    pthread_t thread;
+};
+
+// Send the buffered bytes followed by iov, with the lock held. Returns the
+// bytes written in total, buffered ones first, and keeps what of the
+// buffer didn't go out.
+static int
+coalesce_send_locked(struct _uart_coalesce* co, const struct iovec* iov, int count)
+{
+    struct iovec local[UART_IOV_LOCAL + 1];
+    struct iovec* all = local;
+    int total = count, n;
+
+    // a full array leaves no room in front for the buffer, which then
+    // goes out in a write of its own
+    if (co->count > 0 && count >= UART_IOV_MAX) {
+        size_t buffered = co->count;
+        n = coalesce_send_locked(co, NULL, 0);
+        if (n < 0 || (size_t) n < buffered) {
+            return n;
+        }
+        n = coalesce_send_locked(co, iov, count);
+        return n < 0 ? n : n + (int) buffered;
+    }
+
+    if (co->count > 0) {
+        total++;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    if (total > UART_IOV_LOCAL + 1) {
+        all = malloc(total * sizeof(struct iovec));
+        if (all == NULL) {
+            syslog(LOG_CRIT, "uart%i: write: Failed to allocate memory", co->dev->index);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+    if (co->count > 0) {
+        all[0].iov_base = co->buf;
+        all[0].iov_len = co->count;
+    }
+    if (count > 0) {
+        memcpy(all + (total - count), iov, count * sizeof(struct iovec));
+    }
+
+    n = mraa_uart_write_direct(co->dev, all, total);
+    if (all != local) {
+        free(all);
+    }
+
+    if (n >= 0) {
+        if ((size_t) n >= co->count) {
+            co->count = 0;
+        } else {
+            memmove(co->buf, co->buf + n, co->count - n);
+            co->count -= n;
+        }
+    }
+    return n;
+}
+
+// Start the wait of the oldest buffered byte
+static void
+coalesce_arm(struct _uart_coalesce* co)
+{
+    clock_gettime(CLOCK_MONOTONIC, &co->deadline);
+    co->deadline.tv_sec += co->delay_ms / 1000;
+    co->deadline.tv_nsec += (co->delay_ms % 1000) * 1000000L;
+    if (co->deadline.tv_nsec >= 1000000000L) {
+        co->deadline.tv_sec++;
+        co->deadline.tv_nsec -= 1000000000L;
+    }
+}
+
+static void*
+coalesce_thread_main(void* arg)
+{
+    struct _uart_coalesce* co = (struct _uart_coalesce*) arg;
+
+    pthread_mutex_lock(&co->lock);
+    while (!co->stop) {
+        if (co->count == 0) {
+            pthread_cond_wait(&co->cond, &co->lock);
+            continue;
+        }
+        // woken early when the buffer went out and came back with a new deadline
+        if (pthread_cond_timedwait(&co->cond, &co->lock, &co->deadline) == ETIMEDOUT && co->count > 0) {
+            if (coalesce_send_locked(co, NULL, 0) <= 0 || co->count > 0) {
+                // port can't take it all now, try again a delay later
+                coalesce_arm(co);
+            }
+        }
+    }
+    pthread_mutex_unlock(&co->lock);
+
+    return NULL;
+}
+
+int
+mraa_uart_coalesce_write(mraa_uart_context dev, const struct iovec* iov, int count)
+{
+    struct _uart_coalesce* co = dev->coalesce;
+    size_t len = 0;
+    int i, ret;
+
+    for (i = 0; i < count; i++) {
+        len += iov[i].iov_len;
+    }
+
+    pthread_mutex_lock(&co->lock);
+    if (co->count + len < co->size) {
+        if (co->count == 0 && co->delay_ms > 0) {
+            coalesce_arm(co);
+            pthread_cond_signal(&co->cond);
+        }
+        for (i = 0; i < count; i++) {
+            memcpy(co->buf + co->count, iov[i].iov_base, iov[i].iov_len);
+            co->count += iov[i].iov_len;
+        }
+        ret = len;
+    } else {
+        size_t buffered = co->count;
+        ret = coalesce_send_locked(co, iov, count);
+        if (ret >= 0) {
+            ret = (size_t) ret > buffered ? ret - buffered : 0;
+        }
+    }
+    pthread_mutex_unlock(&co->lock);
+
+    return ret;
+}
+
+mraa_result_t
+mraa_uart_coalesce_flush(mraa_uart_context dev)
+{
+    struct _uart_coalesce* co = dev->coalesce;
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    pthread_mutex_lock(&co->lock);
+    while (co->count > 0) {
+        if (coalesce_send_locked(co, NULL, 0) <= 0) {
+            syslog(LOG_ERR, "uart%i: flush: sending coalesced data failed", dev->index);
+            ret = MRAA_ERROR_INVALID_RESOURCE;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&co->lock);
+
+    return ret;
+}
+
+static void
+coalesce_free(struct _uart_coalesce* co)
+{
+    pthread_cond_destroy(&co->cond);
+    pthread_mutex_destroy(&co->lock);
+    free(co->buf);
+    free(co);
+}
+
+mraa_result_t
+mraa_uart_set_write_coalescing(mraa_uart_context dev, size_t threshold, unsigned int max_delay_ms)
+{
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_write_coalescing: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->coalesce != NULL) {
+        struct _uart_coalesce* co = dev->coalesce;
+        ret = mraa_uart_coalesce_flush(dev);
+        if (co->delay_ms > 0) {
+            pthread_mutex_lock(&co->lock);
+            co->stop = 1;
+            pthread_cond_signal(&co->cond);
+            pthread_mutex_unlock(&co->lock);
+            pthread_join(co->thread, NULL);
+        }
+        dev->coalesce = NULL;
+        coalesce_free(co);
+    }
+    if (threshold == 0) {
+        return ret;
+    }
+
+    struct _uart_coalesce* co = calloc(1, sizeof(struct _uart_coalesce));
+    if (co == NULL) {
+        syslog(LOG_CRIT, "uart%i: set_write_coalescing: Failed to allocate memory for context", dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    co->buf = malloc(threshold);
+    if (co->buf == NULL) {
+        syslog(LOG_CRIT, "uart%i: set_write_coalescing: Failed to allocate %zu byte buffer", dev->index, threshold);
+        free(co);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    co->dev = dev;
+    co->size = threshold;
+    co->delay_ms = max_delay_ms;
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&co->cond, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_mutex_init(&co->lock, NULL);
+
+    if (max_delay_ms > 0) {
+        int err = pthread_create(&co->thread, NULL, coalesce_thread_main, co);
+        if (err != 0) {
+            syslog(LOG_ERR, "uart%i: set_write_coalescing: pthread_create() failed: %s", dev->index, strerror(err));
+            coalesce_free(co);
+            return MRAA_ERROR_NO_RESOURCES;
+        }
+    }
+    dev->coalesce = co;
+
+    return ret;
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "uart.h"
+#include "mraa_internal.h"
+
+#define RX_MIN_BUFFER_SIZE 4096
+
+// One registration per context with a callback. Entries are only ever
+// freed by the event thread; removing one marks it so the thread can drop
+// it once it no longer looks at it.
+struct _uart_rx {
+    int fd;
+    int index;
+    void (*fptr)(const char* data, int length, void* args);
+    void* args;
+    unsigned int min_chunk;
+    unsigned int idle_ms;
+    char* buf;
+    size_t size;
+    size_t count;
+    uint64_t last_ms; /**< when data last came in */
+    mraa_boolean_t removed;
+    struct _uart_rx* next;
+};
+
+// The list and everything in it is guarded by rx_lock. The event thread
+// holds it while calling back, so taking it is enough to know no callback
+// is running, and drops it while waiting in poll().
+static pthread_mutex_t rx_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct _uart_rx* rx_list = NULL;
+static unsigned int rx_generation = 0;
+static mraa_boolean_t rx_running = 0;
+static int rx_wake[2] = { -1, -1 };
+static __thread int rx_in_thread = 0;
+
+static void
+rx_deliver(struct _uart_rx* rx)
+{
+    if (rx->count > 0) {
+        rx->fptr(rx->buf, (int) rx->count, rx->args);
+        rx->count = 0;
+    }
+}
+
+static void
+rx_sweep()
+{
+    struct _uart_rx** pp = &rx_list;
+
+    while (*pp != NULL) {
+        struct _uart_rx* rx = *pp;
+        if (rx->removed) {
+            *pp = rx->next;
+            free(rx->buf);
+            free(rx);
+        } else {
+            pp = &rx->next;
+        }
+    }
+}
+
+static void*
+rx_thread_main(void* arg)
+{
+    struct pollfd* pfds = NULL;
+    struct _uart_rx** owners = NULL;
+    size_t capacity = 0;
+
+    rx_in_thread = 1;
+    pthread_mutex_lock(&rx_lock);
+    for (;;) {
+        struct _uart_rx* rx;
+        size_t i, n = 1;
+
+        rx_sweep();
+        if (rx_list == NULL) {
+            rx_running = 0;
+            break;
+        }
+
+        for (rx = rx_list; rx != NULL; rx = rx->next) {
+            n++;
+        }
+        if (n > capacity) {
+            struct pollfd* p = realloc(pfds, n * sizeof(struct pollfd));
+            struct _uart_rx** o = p ? realloc(owners, n * sizeof(struct _uart_rx*)) : NULL;
+            if (p != NULL) {
+                pfds = p;
+            }
+            if (o == NULL) {
+                syslog(LOG_CRIT, "uart: rx thread: Failed to allocate poll set");
+                pthread_mutex_unlock(&rx_lock);
+                usleep(100000);
+                pthread_mutex_lock(&rx_lock);
+                continue;
+            }
+            owners = o;
+            capacity = n;
+        }
+
+        // wait for data, or until the first pending chunk goes idle
+        uint64_t now = mraa_monotonic_ns() / 1000000;
+        int timeout = -1;
+        pfds[0].fd = rx_wake[0];
+        pfds[0].events = POLLIN;
+        for (i = 1, rx = rx_list; rx != NULL; i++, rx = rx->next) {
+            pfds[i].fd = rx->fd;
+            pfds[i].events = POLLIN;
+            pfds[i].revents = 0;
+            owners[i] = rx;
+            if (rx->count > 0 && rx->idle_ms > 0) {
+                uint64_t due = rx->last_ms + rx->idle_ms;
+                int left = due > now ? (int) (due - now) : 0;
+                if (timeout < 0 || left < timeout) {
+                    timeout = left;
+                }
+            }
+        }
+        unsigned int generation = rx_generation;
+
+        pthread_mutex_unlock(&rx_lock);
+        int ret = poll(pfds, n, timeout);
+        pthread_mutex_lock(&rx_lock);
+
+        if (ret > 0 && (pfds[0].revents & POLLIN)) {
+            char drain[16];
+            while (read(rx_wake[0], drain, sizeof(drain)) > 0)
+                ;
+        }
+        if (ret < 0 || generation != rx_generation) {
+            // registrations changed while polling, start over
+            continue;
+        }
+
+        now = mraa_monotonic_ns() / 1000000;
+        for (i = 1; i < n; i++) {
+            rx = owners[i];
+            if (rx->removed) {
+                // removed from within an earlier callback of this round
+                continue;
+            }
+            mraa_boolean_t failed = 0;
+            if (pfds[i].revents & POLLIN) {
+                ssize_t got = read(rx->fd, rx->buf + rx->count, rx->size - rx->count);
+                if (got > 0) {
+                    rx->count += got;
+                    rx->last_ms = now;
+                } else if (got == 0 || (errno != EAGAIN && errno != EINTR)) {
+                    failed = 1;
+                }
+            } else if (pfds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                failed = 1;
+            }
+            if (failed) {
+                // port went away, pass on what is left and stop polling it
+                syslog(LOG_ERR, "uart%i: rx thread: port hung up or failed", rx->index);
+                rx->fd = -1;
+                rx_deliver(rx);
+                continue;
+            }
+            if (rx->count > 0 && (rx->count >= rx->min_chunk || rx->count == rx->size ||
+                                  (rx->idle_ms > 0 && now - rx->last_ms >= rx->idle_ms))) {
+                rx_deliver(rx);
+            }
+        }
+    }
+    pthread_mutex_unlock(&rx_lock);
+
+    free(pfds);
+    free(owners);
+    return NULL;
+}
+
+mraa_result_t
+mraa_uart_set_rx_callback(mraa_uart_context dev,
+                          void (*fptr)(const char* data, int length, void* args),
+                          void* args,
+                          unsigned int min_chunk,
+                          unsigned int idle_ms)
+{
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_rx_callback: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (fptr != NULL && dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: set_rx_callback: port is not open", dev->index);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+
+    if (fptr != NULL && dev->group != NULL) {
+        syslog(LOG_ERR, "uart%i: set_rx_callback: port is in a port group", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    // a callback may change registrations, the event thread already holds the lock
+    if (!rx_in_thread) {
+        pthread_mutex_lock(&rx_lock);
+    }
+
+    if (dev->rx != NULL) {
+        dev->rx->removed = 1;
+        dev->rx = NULL;
+        rx_generation++;
+    }
+
+    if (fptr != NULL) {
+        struct _uart_rx* rx = calloc(1, sizeof(struct _uart_rx));
+        if (rx == NULL) {
+            syslog(LOG_CRIT, "uart%i: set_rx_callback: Failed to allocate memory for context", dev->index);
+            ret = MRAA_ERROR_NO_RESOURCES;
+            goto rx_unlock;
+        }
+        rx->size = min_chunk > RX_MIN_BUFFER_SIZE ? min_chunk : RX_MIN_BUFFER_SIZE;
+        rx->buf = malloc(rx->size);
+        if (rx->buf == NULL) {
+            syslog(LOG_CRIT, "uart%i: set_rx_callback: Failed to allocate memory for buffer", dev->index);
+            free(rx);
+            ret = MRAA_ERROR_NO_RESOURCES;
+            goto rx_unlock;
+        }
+        rx->fd = dev->fd;
+        rx->index = dev->index;
+        rx->fptr = fptr;
+        rx->args = args;
+        rx->min_chunk = min_chunk;
+        rx->idle_ms = idle_ms;
+
+        if (rx_wake[0] < 0) {
+            if (pipe(rx_wake) < 0) {
+                syslog(LOG_ERR, "uart%i: set_rx_callback: pipe() failed: %s", dev->index, strerror(errno));
+                rx_wake[0] = rx_wake[1] = -1;
+                free(rx->buf);
+                free(rx);
+                ret = MRAA_ERROR_NO_RESOURCES;
+                goto rx_unlock;
+            }
+            for (int i = 0; i < 2; i++) {
+                fcntl(rx_wake[i], F_SETFL, O_NONBLOCK);
+                fcntl(rx_wake[i], F_SETFD, FD_CLOEXEC);
+            }
+        }
+
+        if (!rx_running) {
+            pthread_t thread;
+            pthread_attr_t attr;
+            pthread_attr_init(&attr);
+            pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+            int err = pthread_create(&thread, &attr, rx_thread_main, NULL);
+            pthread_attr_destroy(&attr);
+            if (err != 0) {
+                syslog(LOG_ERR, "uart%i: set_rx_callback: pthread_create() failed: %s", dev->index, strerror(err));
+                free(rx->buf);
+                free(rx);
+                ret = MRAA_ERROR_NO_RESOURCES;
+                goto rx_unlock;
+            }
+            rx_running = 1;
+        }
+
+        rx->next = rx_list;
+        rx_list = rx;
+        dev->rx = rx;
+        rx_generation++;
+    }
+
+    if (rx_running && !rx_in_thread) {
+        char c = 0;
+        if (write(rx_wake[1], &c, 1) < 0) {
+            // pipe full, the thread has a wakeup pending anyway
+        }
+    }
+
+rx_unlock:
+    if (!rx_in_thread) {
+        pthread_mutex_unlock(&rx_lock);
+    }
+    return ret;
+}
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "uart.h"
+#include "mraa_internal.h"
+
+#define FRAME_DEFAULT_BUFFER_SIZE (64 * 1024)
+
+#define SLIP_END 0xC0
+#define SLIP_ESC 0xDB
+#define SLIP_ESC_END 0xDC
+#define SLIP_ESC_ESC 0xDD
+
+// Received bytes live in buf[head, tail). Frames are always handed out as
+// one contiguous run, so rather than wrapping around the end the unread
+// remainder is moved back to the start once the buffer end is reached,
+// which copies at most one partial frame per buffer fill.
+struct _uart_frame {
+    mraa_uart_frame_config_t config;
+    uint8_t* buf;
+    size_t size;
+    size_t head;     /**< first byte not handed out yet */
+    size_t tail;     /**< end of received data */
+    size_t scan;     /**< bytes after head already searched for a delimiter */
+    size_t consumed; /**< size of the frame handed out last, released on the next read */
+    mraa_boolean_t resync; /**< drop everything up to the next delimiter */
+    unsigned int errors;
+};
+
+static uint8_t
+frame_delimiter(struct _uart_frame* fr)
+{
+    switch (fr->config.mode) {
+        case MRAA_UART_FRAME_SLIP:
+            return SLIP_END;
+        case MRAA_UART_FRAME_COBS:
+            return 0x00;
+        default:
+            return fr->config.delimiter;
+    }
+}
+
+static int
+slip_decode(uint8_t* data, size_t length)
+{
+    size_t i, out = 0;
+
+    for (i = 0; i < length; i++) {
+        uint8_t c = data[i];
+        if (c == SLIP_ESC) {
+            if (++i == length) {
+                return -1;
+            }
+            if (data[i] == SLIP_ESC_END) {
+                c = SLIP_END;
+            } else if (data[i] == SLIP_ESC_ESC) {
+                c = SLIP_ESC;
+            } else {
+                return -1;
+            }
+        }
+        data[out++] = c;
+    }
+    return out;
+}
+
+static int
+cobs_decode(uint8_t* data, size_t length)
+{
+    size_t i = 0, out = 0;
+
+    while (i < length) {
+        uint8_t code = data[i++];
+        if (code == 0 || i + code - 1 > length) {
+            return -1;
+        }
+        // out trails i by at least one, decoding in place is safe
+        memmove(data + out, data + i, code - 1);
+        out += code - 1;
+        i += code - 1;
+        if (code != 0xFF && i < length) {
+            data[out++] = 0;
+        }
+    }
+    return out;
+}
+
+// Look for a complete frame in the buffered data. Returns 1 and fills
+// frame when one is found, 0 when more data is needed.
+static int
+frame_parse(struct _uart_frame* fr, mraa_uart_frame_t* frame)
+{
+    while (fr->head < fr->tail) {
+        uint8_t* data = fr->buf + fr->head;
+        size_t avail = fr->tail - fr->head;
+        size_t len;
+
+        if (fr->config.mode == MRAA_UART_FRAME_FIXED) {
+            if (avail < fr->config.length) {
+                return 0;
+            }
+            frame->data = data;
+            frame->length = fr->config.length;
+            fr->consumed = fr->config.length;
+            return 1;
+        }
+
+        if (fr->config.mode == MRAA_UART_FRAME_LENGTH_PREFIX) {
+            size_t i, prefix = fr->config.length;
+            if (avail < prefix) {
+                return 0;
+            }
+            len = 0;
+            for (i = 0; i < prefix; i++) {
+                if (fr->config.big_endian) {
+                    len = (len << 8) | data[i];
+                } else {
+                    len |= (size_t) data[i] << (8 * i);
+                }
+            }
+            if (len > fr->size - prefix) {
+                // can never fit, the stream is most likely out of step
+                fr->errors++;
+                fr->head = fr->tail;
+                return 0;
+            }
+            if (avail < prefix + len) {
+                return 0;
+            }
+            frame->data = data + prefix;
+            frame->length = len;
+            fr->consumed = prefix + len;
+            return 1;
+        }
+
+        uint8_t* end = memchr(data + fr->scan, frame_delimiter(fr), avail - fr->scan);
+        if (end == NULL) {
+            fr->scan = avail;
+            return 0;
+        }
+        len = end - data;
+        fr->scan = 0;
+
+        if (fr->resync) {
+            fr->resync = 0;
+            fr->head += len + 1;
+            continue;
+        }
+
+        int decoded = len;
+        if (fr->config.mode == MRAA_UART_FRAME_SLIP) {
+            decoded = slip_decode(data, len);
+        } else if (fr->config.mode == MRAA_UART_FRAME_COBS) {
+            decoded = cobs_decode(data, len);
+        }
+        if (decoded < 0) {
+            fr->errors++;
+            fr->head += len + 1;
+            continue;
+        }
+        if (decoded == 0 && fr->config.mode != MRAA_UART_FRAME_DELIMITER) {
+            // back to back SLIP ENDs or COBS zeros, not a frame
+            fr->head += len + 1;
+            continue;
+        }
+        frame->data = data;
+        frame->length = decoded;
+        fr->consumed = len + 1;
+        return 1;
+    }
+    return 0;
+}
+
+// Make room at the end of the buffer for the next bulk read
+static void
+frame_make_room(struct _uart_frame* fr)
+{
+    if (fr->head == fr->tail) {
+        fr->head = fr->tail = fr->scan = 0;
+        return;
+    }
+    if (fr->tail < fr->size) {
+        return;
+    }
+    if (fr->head == 0) {
+        // full of a single frame that is too large, drop it
+        if (!fr->resync) {
+            fr->errors++;
+        }
+        fr->head = fr->tail = fr->scan = 0;
+        fr->resync = fr->config.mode != MRAA_UART_FRAME_FIXED &&
+                     fr->config.mode != MRAA_UART_FRAME_LENGTH_PREFIX;
+        return;
+    }
+    memmove(fr->buf, fr->buf + fr->head, fr->tail - fr->head);
+    fr->tail -= fr->head;
+    fr->head = 0;
+}
+
+mraa_result_t
+mraa_uart_set_framing(mraa_uart_context dev, const mraa_uart_frame_config_t* config)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_framing: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->frame != NULL) {
+        free(dev->frame->buf);
+        free(dev->frame);
+        dev->frame = NULL;
+    }
+    if (config == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    size_t size = config->buffer_size > 0 ? config->buffer_size : FRAME_DEFAULT_BUFFER_SIZE;
+    switch (config->mode) {
+        case MRAA_UART_FRAME_DELIMITER:
+        case MRAA_UART_FRAME_SLIP:
+        case MRAA_UART_FRAME_COBS:
+            break;
+        case MRAA_UART_FRAME_FIXED:
+            if (config->length == 0 || config->length > size) {
+                syslog(LOG_ERR, "uart%i: set_framing: invalid frame length %zu", dev->index, config->length);
+                return MRAA_ERROR_INVALID_PARAMETER;
+            }
+            break;
+        case MRAA_UART_FRAME_LENGTH_PREFIX:
+            if (config->length != 1 && config->length != 2 && config->length != 4) {
+                syslog(LOG_ERR, "uart%i: set_framing: invalid prefix size %zu", dev->index, config->length);
+                return MRAA_ERROR_INVALID_PARAMETER;
+            }
+            break;
+        default:
+            syslog(LOG_ERR, "uart%i: set_framing: invalid mode %d", dev->index, config->mode);
+            return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    struct _uart_frame* fr = calloc(1, sizeof(struct _uart_frame));
+    if (fr == NULL) {
+        syslog(LOG_CRIT, "uart%i: set_framing: Failed to allocate memory for reader", dev->index);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    fr->buf = malloc(size);
+    if (fr->buf == NULL) {
+        syslog(LOG_CRIT, "uart%i: set_framing: Failed to allocate %zu byte buffer", dev->index, size);
+        free(fr);
+        return MRAA_ERROR_NO_RESOURCES;
+    }
+    fr->config = *config;
+    fr->size = size;
+    dev->frame = fr;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_read_frame(mraa_uart_context dev, mraa_uart_frame_t* frame, unsigned int millis)
+{
+    struct timespec now, deadline;
+
+    if (!dev) {
+        syslog(LOG_ERR, "uart: read_frame: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (dev->frame == NULL || frame == NULL) {
+        syslog(LOG_ERR, "uart%i: read_frame: framing not set up", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    struct _uart_frame* fr = dev->frame;
+    fr->head += fr->consumed;
+    fr->consumed = 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += millis / 1000;
+    deadline.tv_nsec += (millis % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (!frame_parse(fr, frame)) {
+        frame_make_room(fr);
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long wait = (deadline.tv_sec - now.tv_sec) * 1000 + (deadline.tv_nsec - now.tv_nsec) / 1000000;
+        if (!mraa_uart_data_available(dev, wait > 0 ? wait : 0)) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE;
+        }
+
+        int n = mraa_uart_read(dev, (char*) fr->buf + fr->tail, fr->size - fr->tail);
+        if (n <= 0) {
+            syslog(LOG_ERR, "uart%i: read_frame: read failed", dev->index);
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+        fr->tail += n;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+unsigned int
+mraa_uart_get_frame_errors(mraa_uart_context dev)
+{
+    if (!dev || dev->frame == NULL) {
+        return 0;
+    }
+
+    return dev->frame->errors;
+}
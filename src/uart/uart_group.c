@@ -0,0 +1,551 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+#include "uart_group.h"
+#include "mraa_internal.h"
+
+#define GROUP_READ_SIZE 4096
+// reads per port and round, so one busy port can't starve the others
+#define GROUP_READ_BUDGET 16
+#define GROUP_MAX_EVENTS 64
+#define GROUP_WAKE_KEY UINT64_MAX
+
+struct _uart_group_port {
+    mraa_uart_context dev;
+    int fd;
+    int index;
+    void (*fptr)(mraa_uart_context dev, const char* data, int length, void* args);
+    void* args;
+    char* queue; /**< output ring */
+    size_t size;
+    size_t head;
+    size_t count;
+    int saved_flags;       /**< file status flags before joining */
+    int overruns_base;     /**< driver overrun count when added, -1 if unknown */
+    uint32_t generation;   /**< tells stale epoll events from a reused slot */
+    mraa_boolean_t in_use;
+    mraa_boolean_t rx_ready; /**< readable and not drained yet */
+    mraa_boolean_t failed;
+    mraa_uart_group_stats_t stats;
+};
+
+// Ports live in a slot array, epoll events carry slot and generation so
+// the thread can drop events of ports removed while it waited. Everything
+// is guarded by lock, which the thread holds except while in epoll_wait(),
+// so holding it means no callback is running.
+struct _uart_group {
+    pthread_mutex_t lock;
+    pthread_t thread;
+    int epfd;
+    int wake[2];
+    mraa_boolean_t stop;
+    struct _uart_group_port* ports;
+    int capacity;
+    int count;
+    uint32_t generation;
+    char buf[GROUP_READ_SIZE];
+};
+
+static mraa_boolean_t
+group_in_thread(struct _uart_group* group)
+{
+    return pthread_equal(pthread_self(), group->thread);
+}
+
+static void
+group_lock(struct _uart_group* group)
+{
+    // callbacks run with the lock held already
+    if (!group_in_thread(group)) {
+        pthread_mutex_lock(&group->lock);
+    }
+}
+
+static void
+group_unlock(struct _uart_group* group)
+{
+    if (!group_in_thread(group)) {
+        pthread_mutex_unlock(&group->lock);
+    }
+}
+
+static struct _uart_group_port*
+group_find(struct _uart_group* group, mraa_uart_context dev)
+{
+    for (int i = 0; i < group->capacity; i++) {
+        if (group->ports[i].in_use && group->ports[i].dev == dev) {
+            return &group->ports[i];
+        }
+    }
+    return NULL;
+}
+
+static int
+group_overruns(int fd)
+{
+    struct serial_icounter_struct icount;
+
+    if (ioctl(fd, TIOCGICOUNT, &icount) < 0) {
+        return -1;
+    }
+    return icount.overrun + icount.buf_overrun;
+}
+
+static void
+group_fail(struct _uart_group* group, struct _uart_group_port* port)
+{
+    syslog(LOG_ERR, "uart%i: group: port hung up or failed", port->index);
+    epoll_ctl(group->epfd, EPOLL_CTL_DEL, port->fd, NULL);
+    port->failed = 1;
+    port->rx_ready = 0;
+}
+
+// Send queued output until the port stops taking it
+static void
+group_send_queue(struct _uart_group* group, struct _uart_group_port* port)
+{
+    while (port->count > 0) {
+        size_t run = port->size - port->head;
+        if (run > port->count) {
+            run = port->count;
+        }
+        ssize_t n = write(port->fd, port->queue + port->head, run);
+        if (n < 0) {
+            if (errno != EAGAIN && errno != EINTR) {
+                group_fail(group, port);
+            }
+            if (errno != EINTR) {
+                return;
+            }
+            continue;
+        }
+        port->head = (port->head + n) % port->size;
+        port->count -= n;
+        port->stats.tx_bytes += n;
+    }
+    port->head = 0;
+}
+
+// Read what a port has, up to the budget. Returns 1 if it has more.
+static mraa_boolean_t
+group_receive(struct _uart_group* group, int slot)
+{
+    struct _uart_group_port* port = &group->ports[slot];
+    uint32_t generation = port->generation;
+
+    for (int i = 0; i < GROUP_READ_BUDGET; i++) {
+        ssize_t n = read(port->fd, group->buf, sizeof(group->buf));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && errno == EAGAIN) {
+            port->rx_ready = 0;
+            return 0;
+        }
+        if (n <= 0) {
+            group_fail(group, port);
+            return 0;
+        }
+        port->stats.rx_bytes += n;
+        port->fptr(port->dev, group->buf, (int) n, port->args);
+
+        // the callback may have added or removed ports
+        port = &group->ports[slot];
+        if (!port->in_use || port->generation != generation || port->failed) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void*
+group_thread_main(void* arg)
+{
+    struct _uart_group* group = (struct _uart_group*) arg;
+    struct epoll_event events[GROUP_MAX_EVENTS];
+    mraa_boolean_t more = 0;
+
+    pthread_mutex_lock(&group->lock);
+    while (!group->stop) {
+        // a port left with data to read has no edge coming, don't wait then
+        pthread_mutex_unlock(&group->lock);
+        int n = epoll_wait(group->epfd, events, GROUP_MAX_EVENTS, more ? 0 : -1);
+        pthread_mutex_lock(&group->lock);
+
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.u64 == GROUP_WAKE_KEY) {
+                char drain[16];
+                while (read(group->wake[0], drain, sizeof(drain)) > 0)
+                    ;
+                continue;
+            }
+            int slot = (int) (events[i].data.u64 & 0xFFFFFFFF);
+            uint32_t generation = (uint32_t) (events[i].data.u64 >> 32);
+            if (slot >= group->capacity || !group->ports[slot].in_use ||
+                group->ports[slot].generation != generation || group->ports[slot].failed) {
+                continue;
+            }
+            struct _uart_group_port* port = &group->ports[slot];
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                // errors and hangups show up as a failing read
+                port->rx_ready = 1;
+            }
+            if (events[i].events & EPOLLOUT) {
+                group_send_queue(group, port);
+            }
+        }
+
+        more = 0;
+        for (int slot = 0; slot < group->capacity && !group->stop; slot++) {
+            if (group->ports[slot].in_use && group->ports[slot].rx_ready) {
+                more |= group_receive(group, slot);
+            }
+        }
+    }
+    pthread_mutex_unlock(&group->lock);
+
+    return NULL;
+}
+
+mraa_uart_group_context
+mraa_uart_group_init()
+{
+    struct epoll_event ev;
+
+    mraa_uart_group_context group = calloc(1, sizeof(struct _uart_group));
+    if (group == NULL) {
+        syslog(LOG_CRIT, "uart: group: Failed to allocate memory for context");
+        return NULL;
+    }
+    group->wake[0] = group->wake[1] = -1;
+
+    group->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (group->epfd < 0) {
+        syslog(LOG_ERR, "uart: group: epoll_create1() failed: %s", strerror(errno));
+        goto group_init_cleanup;
+    }
+    if (pipe(group->wake) < 0) {
+        syslog(LOG_ERR, "uart: group: pipe() failed: %s", strerror(errno));
+        group->wake[0] = group->wake[1] = -1;
+        goto group_init_cleanup;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(group->wake[i], F_SETFL, O_NONBLOCK);
+        fcntl(group->wake[i], F_SETFD, FD_CLOEXEC);
+    }
+    ev.events = EPOLLIN;
+    ev.data.u64 = GROUP_WAKE_KEY;
+    if (epoll_ctl(group->epfd, EPOLL_CTL_ADD, group->wake[0], &ev) < 0) {
+        syslog(LOG_ERR, "uart: group: epoll_ctl() failed: %s", strerror(errno));
+        goto group_init_cleanup;
+    }
+
+    pthread_mutex_init(&group->lock, NULL);
+    int err = pthread_create(&group->thread, NULL, group_thread_main, group);
+    if (err != 0) {
+        syslog(LOG_ERR, "uart: group: pthread_create() failed: %s", strerror(err));
+        pthread_mutex_destroy(&group->lock);
+        goto group_init_cleanup;
+    }
+
+    return group;
+
+group_init_cleanup:
+    if (group->epfd >= 0) {
+        close(group->epfd);
+    }
+    if (group->wake[0] >= 0) {
+        close(group->wake[0]);
+        close(group->wake[1]);
+    }
+    free(group);
+    return NULL;
+}
+
+static void
+group_remove_port(struct _uart_group* group, struct _uart_group_port* port)
+{
+    if (!port->failed) {
+        epoll_ctl(group->epfd, EPOLL_CTL_DEL, port->fd, NULL);
+    }
+    fcntl(port->fd, F_SETFL, port->saved_flags);
+    port->dev->group = NULL;
+    free(port->queue);
+    memset(port, 0, sizeof(struct _uart_group_port));
+    group->count--;
+}
+
+mraa_result_t
+mraa_uart_group_stop(mraa_uart_group_context group)
+{
+    if (group == NULL) {
+        syslog(LOG_ERR, "uart: group: stop: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (group_in_thread(group)) {
+        syslog(LOG_ERR, "uart: group: stop: can't stop a group from its callbacks");
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    pthread_mutex_lock(&group->lock);
+    for (int i = 0; i < group->capacity; i++) {
+        if (group->ports[i].in_use) {
+            group_remove_port(group, &group->ports[i]);
+        }
+    }
+    group->stop = 1;
+    char c = 0;
+    if (write(group->wake[1], &c, 1) < 0) {
+        // pipe full, the thread has a wakeup pending anyway
+    }
+    pthread_mutex_unlock(&group->lock);
+    pthread_join(group->thread, NULL);
+
+    pthread_mutex_destroy(&group->lock);
+    close(group->epfd);
+    close(group->wake[0]);
+    close(group->wake[1]);
+    free(group->ports);
+    free(group);
+
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_group_add(mraa_uart_group_context group,
+                    mraa_uart_context dev,
+                    void (*fptr)(mraa_uart_context dev, const char* data, int length, void* args),
+                    void* args,
+                    size_t queue_size)
+{
+    struct epoll_event ev;
+    struct _uart_group_port* port = NULL;
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (group == NULL || dev == NULL) {
+        syslog(LOG_ERR, "uart: group: add: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (fptr == NULL) {
+        syslog(LOG_ERR, "uart%i: group: add: no callback", dev->index);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+    if (dev->fd < 0) {
+        syslog(LOG_ERR, "uart%i: group: add: port is not open", dev->index);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    if (dev->rx != NULL || dev->coalesce != NULL || dev->rs485_mode == MRAA_UART_RS485_GPIO) {
+        syslog(LOG_ERR, "uart%i: group: add: port has an rx callback, write coalescing or gpio rs485", dev->index);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+
+    group_lock(group);
+    if (dev->group != NULL) {
+        syslog(LOG_ERR, "uart%i: group: add: port is in a group already", dev->index);
+        ret = MRAA_ERROR_INVALID_RESOURCE;
+        goto group_add_unlock;
+    }
+
+    for (int i = 0; i < group->capacity; i++) {
+        if (!group->ports[i].in_use) {
+            port = &group->ports[i];
+            break;
+        }
+    }
+    if (port == NULL) {
+        int capacity = group->capacity > 0 ? group->capacity * 2 : 8;
+        struct _uart_group_port* ports = realloc(group->ports, capacity * sizeof(struct _uart_group_port));
+        if (ports == NULL) {
+            syslog(LOG_CRIT, "uart%i: group: add: Failed to allocate port slots", dev->index);
+            ret = MRAA_ERROR_NO_RESOURCES;
+            goto group_add_unlock;
+        }
+        memset(ports + group->capacity, 0, (capacity - group->capacity) * sizeof(struct _uart_group_port));
+        port = &ports[group->capacity];
+        group->ports = ports;
+        group->capacity = capacity;
+    }
+
+    port->size = queue_size > 0 ? queue_size : MRAA_UART_GROUP_DEFAULT_QUEUE;
+    port->queue = malloc(port->size);
+    if (port->queue == NULL) {
+        syslog(LOG_CRIT, "uart%i: group: add: Failed to allocate %zu byte queue", dev->index, port->size);
+        ret = MRAA_ERROR_NO_RESOURCES;
+        goto group_add_unlock;
+    }
+    port->saved_flags = fcntl(dev->fd, F_GETFL);
+    if (port->saved_flags < 0 || fcntl(dev->fd, F_SETFL, port->saved_flags | O_NONBLOCK) < 0) {
+        syslog(LOG_ERR, "uart%i: group: add: failed to make port non-blocking: %s", dev->index, strerror(errno));
+        free(port->queue);
+        port->queue = NULL;
+        ret = MRAA_ERROR_UNSPECIFIED;
+        goto group_add_unlock;
+    }
+
+    port->generation = ++group->generation;
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLET;
+    ev.data.u64 = ((uint64_t) port->generation << 32) | (uint64_t) (port - group->ports);
+    if (epoll_ctl(group->epfd, EPOLL_CTL_ADD, dev->fd, &ev) < 0) {
+        syslog(LOG_ERR, "uart%i: group: add: epoll_ctl() failed: %s", dev->index, strerror(errno));
+        fcntl(dev->fd, F_SETFL, port->saved_flags);
+        free(port->queue);
+        port->queue = NULL;
+        ret = MRAA_ERROR_UNSPECIFIED;
+        goto group_add_unlock;
+    }
+
+    port->dev = dev;
+    port->fd = dev->fd;
+    port->index = dev->index;
+    port->fptr = fptr;
+    port->args = args;
+    port->head = port->count = 0;
+    port->overruns_base = group_overruns(dev->fd);
+    port->rx_ready = 0;
+    port->failed = 0;
+    memset(&port->stats, 0, sizeof(port->stats));
+    port->in_use = 1;
+    dev->group = group;
+    group->count++;
+
+group_add_unlock:
+    group_unlock(group);
+    return ret;
+}
+
+mraa_result_t
+mraa_uart_group_remove(mraa_uart_group_context group, mraa_uart_context dev)
+{
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (group == NULL || dev == NULL) {
+        syslog(LOG_ERR, "uart: group: remove: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    group_lock(group);
+    struct _uart_group_port* port = group_find(group, dev);
+    if (port == NULL) {
+        syslog(LOG_ERR, "uart%i: group: remove: port is not in the group", dev->index);
+        ret = MRAA_ERROR_INVALID_PARAMETER;
+    } else {
+        group_remove_port(group, port);
+    }
+    group_unlock(group);
+
+    return ret;
+}
+
+int
+mraa_uart_group_write(mraa_uart_group_context group, mraa_uart_context dev, const char* buf, size_t length)
+{
+    size_t sent = 0;
+    int ret = -1;
+
+    if (group == NULL || dev == NULL || buf == NULL) {
+        syslog(LOG_ERR, "uart: group: write: context is NULL");
+        return -1;
+    }
+
+    group_lock(group);
+    struct _uart_group_port* port = group_find(group, dev);
+    if (port == NULL || port->failed) {
+        syslog(LOG_ERR, "uart%i: group: write: port is not in the group or failed", dev->index);
+        goto group_write_unlock;
+    }
+
+    // nothing queued, hand it to the port right away
+    while (port->count == 0 && sent < length) {
+        ssize_t n = write(port->fd, buf + sent, length - sent);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN) {
+                group_fail(group, port);
+                goto group_write_unlock;
+            }
+            break;
+        }
+        sent += n;
+        port->stats.tx_bytes += n;
+    }
+
+    // queue what is left, EPOLLOUT will tell when the port takes more
+    size_t left = length - sent;
+    size_t room = port->size - port->count;
+    if (left > room) {
+        port->stats.tx_overflows += left - room;
+        left = room;
+    }
+    while (left > 0) {
+        size_t tail = (port->head + port->count) % port->size;
+        size_t run = port->size - tail;
+        if (run > left) {
+            run = left;
+        }
+        memcpy(port->queue + tail, buf + sent, run);
+        port->count += run;
+        sent += run;
+        left -= run;
+    }
+    ret = (int) sent;
+
+group_write_unlock:
+    group_unlock(group);
+    return ret;
+}
+
+mraa_result_t
+mraa_uart_group_get_stats(mraa_uart_group_context group, mraa_uart_context dev, mraa_uart_group_stats_t* stats)
+{
+    mraa_result_t ret = MRAA_SUCCESS;
+
+    if (group == NULL || dev == NULL || stats == NULL) {
+        syslog(LOG_ERR, "uart: group: get_stats: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    group_lock(group);
+    struct _uart_group_port* port = group_find(group, dev);
+    if (port == NULL) {
+        ret = MRAA_ERROR_INVALID_PARAMETER;
+    } else {
+        int overruns = port->overruns_base >= 0 ? group_overruns(port->fd) : -1;
+        if (overruns >= port->overruns_base && port->overruns_base >= 0) {
+            port->stats.rx_overruns = overruns - port->overruns_base;
+        }
+        port->stats.tx_queued = port->count;
+        *stats = port->stats;
+    }
+    group_unlock(group);
+
+    return ret;
+}
+
+int
+mraa_uart_group_get_count(mraa_uart_group_context group)
+{
+    if (group == NULL) {
+        return -1;
+    }
+
+    group_lock(group);
+    int count = group->count;
+    group_unlock(group);
+
+    return count;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+#include "uart.h"
+#include "gpio.h"
+#include "uart/uart_rs485.h"
+
+// longest a transmission may take beyond its estimate before DE is
+// released anyway, e.g. when the other end holds off with flow control
+#define RS485_DRAIN_SLACK_NS 100000000LL
+
+static void
+rs485_sleep_ns(int64_t ns)
+{
+    if (ns > 0) {
+        struct timespec ts = { ns / 1000000000LL, ns % 1000000000LL };
+        nanosleep(&ts, NULL);
+    }
+}
+
+static void
+rs485_wait_sent(mraa_uart_context dev, int sent)
+{
+    int64_t char_ns = dev->baudrate > 0 ? 10000000000LL / dev->baudrate : 1000000;
+    int64_t start = mraa_monotonic_ns();
+    unsigned int lsr = 0;
+
+    if (dev->fd < 0) {
+        return;
+    }
+    if (ioctl(dev->fd, TIOCSERGETLSR, &lsr) < 0) {
+        // no line status from this driver, tcdrain is the best there is
+        tcdrain(dev->fd);
+        return;
+    }
+
+    // sleep through most of the frame, it can't be out sooner than at 9 bits
+    // per char, then watch the shift register empty a fraction of a char
+    // time at a time
+    if (sent > 1 && !(lsr & TIOCSER_TEMT)) {
+        rs485_sleep_ns((sent - 1) * char_ns * 9 / 10);
+    }
+    int64_t deadline = start + sent * char_ns + RS485_DRAIN_SLACK_NS;
+    while (ioctl(dev->fd, TIOCSERGETLSR, &lsr) == 0 && !(lsr & TIOCSER_TEMT)) {
+        if ((int64_t) mraa_monotonic_ns() > deadline) {
+            syslog(LOG_WARNING, "uart%i: rs485: transmitter not empty in time", dev->index);
+            break;
+        }
+        rs485_sleep_ns(char_ns / 4);
+    }
+}
+
+void
+mraa_uart_rs485_begin(mraa_uart_context dev)
+{
+    mraa_gpio_write(dev->rs485_de, dev->rs485.de_active_low ? 0 : 1);
+    rs485_sleep_ns((int64_t) dev->rs485.delay_before_us * 1000);
+}
+
+void
+mraa_uart_rs485_end(mraa_uart_context dev, int sent)
+{
+    if (sent > 0) {
+        rs485_wait_sent(dev, sent);
+    }
+    rs485_sleep_ns((int64_t) dev->rs485.delay_after_us * 1000);
+    mraa_gpio_write(dev->rs485_de, dev->rs485.de_active_low ? 1 : 0);
+}
+
+mraa_result_t
+mraa_uart_set_rs485(mraa_uart_context dev, const mraa_uart_rs485_config_t* config)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart: set_rs485: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (dev->rs485_de != NULL) {
+        mraa_gpio_close(dev->rs485_de);
+        dev->rs485_de = NULL;
+    }
+    if (dev->rs485_mode == MRAA_UART_RS485_KERNEL) {
+        struct serial_rs485 off;
+        memset(&off, 0, sizeof(off));
+        if (ioctl(dev->fd, TIOCSRS485, &off) < 0) {
+            syslog(LOG_ERR, "uart%i: set_rs485: TIOCSRS485 failed: %s", dev->index, strerror(errno));
+        }
+    }
+    dev->rs485_mode = MRAA_UART_RS485_OFF;
+
+    if (config == NULL) {
+        return MRAA_SUCCESS;
+    }
+
+    if (dev->fd >= 0) {
+        struct serial_rs485 conf;
+        memset(&conf, 0, sizeof(conf));
+        conf.flags = SER_RS485_ENABLED;
+        conf.flags |= config->de_active_low ? SER_RS485_RTS_AFTER_SEND : SER_RS485_RTS_ON_SEND;
+        if (config->rx_during_tx) {
+            conf.flags |= SER_RS485_RX_DURING_TX;
+        }
+        conf.delay_rts_before_send = (config->delay_before_us + 999) / 1000;
+        conf.delay_rts_after_send = (config->delay_after_us + 999) / 1000;
+        if (ioctl(dev->fd, TIOCSRS485, &conf) == 0 && ioctl(dev->fd, TIOCGRS485, &conf) == 0 &&
+            (conf.flags & SER_RS485_ENABLED)) {
+            dev->rs485 = *config;
+            dev->rs485_mode = MRAA_UART_RS485_KERNEL;
+            return MRAA_SUCCESS;
+        }
+    }
+
+    int pin = config->de_pin >= 0 ? config->de_pin : dev->de_pin;
+    if (pin < 0) {
+        syslog(LOG_ERR, "uart%i: set_rs485: driver has no rs485 support and there is no DE pin", dev->index);
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    dev->rs485_de = mraa_gpio_init(pin);
+    if (dev->rs485_de == NULL) {
+        syslog(LOG_ERR, "uart%i: set_rs485: failed to init DE pin %d", dev->index, pin);
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    // receive until there is something to send
+    if (mraa_gpio_dir(dev->rs485_de, config->de_active_low ? MRAA_GPIO_OUT_HIGH : MRAA_GPIO_OUT_LOW) != MRAA_SUCCESS) {
+        syslog(LOG_ERR, "uart%i: set_rs485: failed to set DE pin %d to output", dev->index, pin);
+        mraa_gpio_close(dev->rs485_de);
+        dev->rs485_de = NULL;
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    dev->rs485 = *config;
+    dev->rs485_mode = MRAA_UART_RS485_GPIO;
+
+    return MRAA_SUCCESS;
+}
+
+mraa_uart_rs485_mode_t
+mraa_uart_get_rs485_mode(mraa_uart_context dev)
+{
+    if (!dev) {
+        return MRAA_UART_RS485_OFF;
+    }
+
+    return dev->rs485_mode;
+}
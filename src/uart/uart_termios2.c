@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <sys/ioctl.h>
+#include <asm/termbits.h>
+#include <errno.h>
+#include <string.h>
+
+#include "uart/uart_termios2.h"
+#include "mraa_internal.h"
+
+mraa_result_t
+mraa_uart_termios2_set_speed(int fd, unsigned int baud)
+{
+#if defined(TCGETS2) && defined(TCSETSF2) && defined(BOTHER)
+    struct termios2 tio;
+
+    if (ioctl(fd, TCGETS2, &tio) < 0) {
+        return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+    }
+    tio.c_cflag &= ~CBAUD;
+    tio.c_cflag |= BOTHER;
+    tio.c_ospeed = baud;
+#if defined(IBSHIFT)
+    // input speed follows the output speed
+    tio.c_cflag &= ~(CBAUD << IBSHIFT);
+#endif
+    tio.c_ispeed = baud;
+
+    if (ioctl(fd, TCSETSF2, &tio) < 0) {
+        if (errno == ENOTTY || errno == EINVAL) {
+            return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+        }
+        syslog(LOG_ERR, "uart: TCSETSF2 failed: %s", strerror(errno));
+        return MRAA_ERROR_INVALID_RESOURCE;
+    }
+    return MRAA_SUCCESS;
+#else
+    return MRAA_ERROR_FEATURE_NOT_SUPPORTED;
+#endif
+}
+
+unsigned int
+mraa_uart_termios2_get_speed(int fd)
+{
+#if defined(TCGETS2)
+    struct termios2 tio;
+
+    if (ioctl(fd, TCGETS2, &tio) < 0) {
+        return 0;
+    }
+    return tio.c_ospeed;
+#else
+    return 0;
+#endif
+}
@@ -19,42 +19,181 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <time.h>
+#include <poll.h>
+#include <pthread.h>
 #include "uart.h"
 #include "uart_ow.h"
 #include "mraa_internal.h"
+#include "uart/modbus_crc.h"
+
+// Most bit slots sent in one write. Enough for a match rom command, the
+// rom code, a read scratchpad command and the 9 byte scratchpad (19
+// bytes) in one go.
+#define OW_MAX_SLOTS 160
+
+// a search rom command and the three slots of each of the 64 rom bits,
+// what a verify sends in one go
+#define OW_VERIFY_SLOTS (8 + 64 * 3)
+
+// scratchpad of the DS18B20 family, the last byte is the CRC
+#define OW_SCRATCHPAD_SIZE 9
+// longest conversion, 12 bit resolution
+#define OW_CONVERSION_MAX_MS 750
+// how often the busy bit is looked at during a conversion
+#define OW_BUSY_POLL_MS 10
+
+// slack on top of the time the echoes need on the wire, covers scheduling
+// and usb serial adapter latency
+#define OW_TIMEOUT_SLACK_MS 50
+
+// When count characters should have been moved at the current rate, or
+// the timeout set on the context
+static int64_t
+_ow_deadline(mraa_uart_ow_context dev, size_t count)
+{
+    unsigned int baud = dev->uart->baudrate > 0 ? dev->uart->baudrate : 9600;
+    int64_t timeout = dev->timeout_ms;
+    if (timeout == 0) {
+        // 10 bits a character
+        timeout = (int64_t) count * 10 * 1000 / baud + OW_TIMEOUT_SLACK_MS;
+    }
+    return (int64_t) (mraa_monotonic_ns() / 1000000) + timeout;
+}
 
-// low-level read byte
+// low-level read: collect count bytes of echoes from the uart, waiting in
+// poll() until the context timeout, or the time count characters take at
+// the current bit rate plus some slack
 static mraa_result_t
-_ow_read_byte(mraa_uart_ow_context dev, uint8_t *ch)
+_ow_read_bytes(mraa_uart_ow_context dev, uint8_t* buf, size_t count)
 {
-    time_t thetime = time(NULL);
-    // add 5 seconds -- our crude timeout
-    thetime += 5;
+    int64_t deadline = _ow_deadline(dev, count);
+
+    size_t got = 0;
+    while (got < count) {
+        int rv = mraa_uart_read(dev->uart, (char*) buf + got, count - got);
+        if (rv > 0) {
+            got += rv;
+            continue;
+        }
+        if (rv < 0 && errno != EAGAIN && errno != EINTR) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+
+        int64_t left = deadline - (int64_t) (mraa_monotonic_ns() / 1000000);
+        if (left <= 0) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE; // we timed out
+        }
+        struct pollfd pfd = { dev->uart->fd, POLLIN, 0 };
+        if (poll(&pfd, 1, (int) left) < 0 && errno != EINTR) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
+    }
+
+    return MRAA_SUCCESS;
+}
 
-    int rv;
-    do {
-        rv = mraa_uart_read(dev->uart, (char*) ch, 1);
-    } while (rv == 0 && (time(NULL) < thetime));
+// low-level write: the fd is non-blocking, wait for room in poll() until
+// all is out or the same deadline a read of count bytes gets has passed
+static mraa_result_t
+_ow_write_bytes(mraa_uart_ow_context dev, const uint8_t* buf, size_t count)
+{
+    int64_t deadline = _ow_deadline(dev, count);
+
+    size_t sent = 0;
+    while (sent < count) {
+        errno = 0;
+        int rv = mraa_uart_write(dev->uart, (const char*) buf + sent, count - sent);
+        if (rv > 0) {
+            sent += rv;
+            continue;
+        }
+        if (rv == 0 || (errno != EAGAIN && errno != EINTR)) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
 
-    if (rv == 0) {
-        return MRAA_ERROR_NO_DATA_AVAILABLE; // we timed out
+        int64_t left = deadline - (int64_t) (mraa_monotonic_ns() / 1000000);
+        if (left <= 0) {
+            return MRAA_ERROR_NO_DATA_AVAILABLE;
+        }
+        struct pollfd pfd = { dev->uart->fd, POLLOUT, 0 };
+        if (poll(&pfd, 1, (int) left) < 0 && errno != EINTR) {
+            return MRAA_ERROR_INVALID_RESOURCE;
+        }
     }
-    else {
-        return MRAA_SUCCESS;
+
+    return MRAA_SUCCESS;
+}
+
+// Run count bit slots, one uart byte each, with a single write and
+// collect all their echoes with a bulk read.  0xff writes a 1 (or
+// reads), 0x00 writes a 0.
+static mraa_result_t
+_ow_slots(mraa_uart_ow_context dev, const uint8_t* out, uint8_t* in, size_t count)
+{
+    mraa_result_t rv = _ow_write_bytes(dev, out, count);
+    if (rv != MRAA_SUCCESS) {
+        return rv;
     }
+    return _ow_read_bytes(dev, in, count);
 }
 
-// low-level write byte
-static int
-_ow_write_byte(mraa_uart_ow_context dev, const char ch)
+// Send bytes LSB first and replace each with the byte read back during
+// its time slots, up to OW_MAX_SLOTS / 8 bytes per round trip
+static mraa_result_t
+_ow_transfer(mraa_uart_ow_context dev, uint8_t* buf, size_t length)
 {
-    return mraa_uart_write(dev->uart, &ch, 1);
+    uint8_t out[OW_MAX_SLOTS], in[OW_MAX_SLOTS];
+
+    while (length > 0) {
+        size_t bytes = length < OW_MAX_SLOTS / 8 ? length : OW_MAX_SLOTS / 8;
+        size_t i;
+        int bit;
+
+        for (i = 0; i < bytes; i++) {
+            for (bit = 0; bit < 8; bit++) {
+                out[i * 8 + bit] = (buf[i] & (1 << bit)) ? 0xff : 0x00;
+            }
+        }
+
+        mraa_result_t rv = _ow_slots(dev, out, in, bytes * 8);
+        if (rv != MRAA_SUCCESS) {
+            return rv;
+        }
+
+        /* return the bits present on the bus (0xff is a '1', anything
+         * else (typically 0xfc or 0x00) is a 0
+         */
+        for (i = 0; i < bytes; i++) {
+            buf[i] = 0;
+            for (bit = 0; bit < 8; bit++) {
+                if (in[i * 8 + bit] == 0xff) {
+                    buf[i] |= 1 << bit;
+                }
+            }
+        }
+
+        buf += bytes;
+        length -= bytes;
+    }
+
+    return MRAA_SUCCESS;
 }
 
+// uart rates for the reset pulse and the bit slots at each bus speed.
+// A 0xf0 holds the line low for 5 bit times, 520 us at 9600 bd and
+// 75 us at 66667 bd.  At 1 Mbd a slot is 10 us, a 1 pulls the line low
+// for 1 us and a 0 for 9 us, which is in overdrive spec.
+static const unsigned int _ow_rates[2][2] = {
+    { 9600, 115200 },  // standard: reset, data
+    { 66667, 1000000 } // overdrive: reset, data
+};
+
 // Here we setup a very simple termios with the minimum required
 // settings.  We use this to also change speed from high to low.  We
-// use the low speed (9600 bd) for emitting the reset pulse, and
-// high speed (115200 bd) for actual data communications.
+// use the low speed for emitting the reset pulse, and high speed for
+// actual data communications, both according to the bus speed of the
+// context.  Rates termios has no constant for go through
+// mraa_uart_set_baudrate(), which can set any rate.
 //
 static mraa_result_t
 _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
@@ -65,16 +204,25 @@ _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
         return MRAA_ERROR_INVALID_HANDLE;
     }
 
-    static speed_t baud;
-    if (speed) {
-        baud = B115200;
-    }
-    else {
-        baud = B9600;
+    unsigned int rate = _ow_rates[dev->speed == MRAA_UART_OW_SPEED_OVERDRIVE][speed ? 1 : 0];
+    speed_t baud;
+    switch (rate) {
+        case 9600:
+            baud = B9600;
+            break;
+        case 115200:
+            baud = B115200;
+            break;
+        case 1000000:
+            baud = B1000000;
+            break;
+        default:
+            baud = B0;
+            break;
     }
 
     struct termios termio = {
-        .c_cflag = baud | CS8 | CLOCAL | CREAD, .c_iflag = 0, .c_oflag = 0, .c_lflag = NOFLSH, .c_cc = { 0 },
+        .c_cflag = (baud == B0 ? B38400 : baud) | CS8 | CLOCAL | CREAD, .c_iflag = 0, .c_oflag = 0, .c_lflag = NOFLSH, .c_cc = { 0 },
     };
 
     tcflush(dev->uart->fd, TCIFLUSH);
@@ -85,6 +233,13 @@ _ow_set_speed(mraa_uart_ow_context dev, mraa_boolean_t speed)
         return MRAA_ERROR_INVALID_RESOURCE;
     }
 
+    // the read deadline follows the bit rate, and a replaced uart (the
+    // mock one) is told about the new rate
+    if (baud == B0 || IS_FUNC_DEFINED(dev->uart, uart_set_baudrate_replace)) {
+        return mraa_uart_set_baudrate(dev->uart, rate);
+    }
+    dev->uart->baudrate = rate;
+
     return MRAA_SUCCESS;
 }
 
@@ -120,13 +275,28 @@ _ow_search(mraa_uart_ow_context dev)
         }
 
         // issue the search command
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_SEARCH_ROM);
+        uint8_t cmd = MRAA_UART_OW_CMD_SEARCH_ROM;
+        if (_ow_transfer(dev, &cmd, 1) != MRAA_SUCCESS) {
+            dev->LastDiscrepancy = 0;
+            dev->LastDeviceFlag = 0;
+            dev->LastFamilyDiscrepancy = 0;
+            return 0;
+        }
+
+        // Every bit takes a slot writing the chosen direction followed by
+        // the two read slots of the next bit.  They don't depend on each
+        // other, so all three go out in one round trip.
+        uint8_t out[3] = { 0xff, 0xff, 0xff }, in[3];
+        size_t slots = 2;
 
         // loop to do the search
         do {
             // read a bit and its complement
-            id_bit = mraa_uart_ow_bit(dev, 1);
-            cmp_id_bit = mraa_uart_ow_bit(dev, 1);
+            if (_ow_slots(dev, out + 3 - slots, in, slots) != MRAA_SUCCESS) {
+                break;
+            }
+            id_bit = (in[slots - 2] == 0xff);
+            cmp_id_bit = (in[slots - 1] == 0xff);
 
             // check for no devices on 1-wire
             if ((id_bit == 1) && (cmp_id_bit == 1))
@@ -159,8 +329,10 @@ _ow_search(mraa_uart_ow_context dev)
                 else
                     dev->ROM_NO[rom_byte_number] &= ~rom_byte_mask;
 
-                // serial number search direction write bit
-                mraa_uart_ow_bit(dev, search_direction);
+                // serial number search direction write bit, goes out
+                // with the next read slots
+                out[0] = search_direction ? 0xff : 0x00;
+                slots = 3;
 
                 // increment the byte counter id_bit_number
                 // and shift the mask rom_byte_mask
@@ -175,6 +347,11 @@ _ow_search(mraa_uart_ow_context dev)
             }
         } while (rom_byte_number < 8);
 
+        // the direction of the last bit has no read slots to go with
+        if (id_bit_number >= 65 && _ow_slots(dev, out, in, 1) != MRAA_SUCCESS) {
+            id_bit_number = 0;
+        }
+
         // loop until through all ROM bytes 0-7
         // if the search was successful then
         if (id_bit_number >= 65) {
@@ -185,8 +362,9 @@ _ow_search(mraa_uart_ow_context dev)
             // check for last device
             if (dev->LastDiscrepancy == 0)
                 dev->LastDeviceFlag = 1;
+
+            search_result = 1;
         }
-        search_result = 1;
     }
 
     // if no device found then reset counters so next 'search' will be
@@ -288,6 +466,78 @@ mraa_uart_ow_stop(mraa_uart_ow_context dev)
     return rv;
 }
 
+mraa_result_t
+mraa_uart_ow_set_timeout(mraa_uart_ow_context dev, unsigned int timeout_ms)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: set_timeout: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    dev->timeout_ms = timeout_ms;
+    return MRAA_SUCCESS;
+}
+
+mraa_result_t
+mraa_uart_ow_set_speed(mraa_uart_ow_context dev, mraa_uart_ow_speed_t speed)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: set_speed: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (speed != MRAA_UART_OW_SPEED_STANDARD && speed != MRAA_UART_OW_SPEED_OVERDRIVE) {
+        syslog(LOG_ERR, "uart_ow: set_speed: invalid speed %d", speed);
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    dev->speed = speed;
+    return _ow_set_speed(dev, 1);
+}
+
+mraa_uart_ow_speed_t
+mraa_uart_ow_get_speed(mraa_uart_ow_context dev)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: get_speed: context is NULL");
+        return MRAA_UART_OW_SPEED_STANDARD;
+    }
+
+    return dev->speed;
+}
+
+mraa_result_t
+mraa_uart_ow_overdrive(mraa_uart_ow_context dev, uint8_t* id)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: overdrive: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    // only a standard speed reset reaches every device
+    dev->speed = MRAA_UART_OW_SPEED_STANDARD;
+    mraa_result_t rv = mraa_uart_ow_reset(dev);
+    if (rv != MRAA_SUCCESS)
+        return rv;
+
+    // the command goes out at standard speed, devices that take it are
+    // in overdrive from the next slot on, where the rom code of a match
+    // already is
+    uint8_t cmd = id ? MRAA_UART_OW_CMD_MATCH_ROM_OVERDRIVE : MRAA_UART_OW_CMD_SKIP_ROM_OVERDRIVE;
+    if ((rv = _ow_transfer(dev, &cmd, 1)) != MRAA_SUCCESS)
+        return rv;
+
+    if ((rv = mraa_uart_ow_set_speed(dev, MRAA_UART_OW_SPEED_OVERDRIVE)) != MRAA_SUCCESS)
+        return rv;
+
+    if (id) {
+        uint8_t rom[MRAA_UART_OW_ROMCODE_SIZE];
+        memcpy(rom, id, MRAA_UART_OW_ROMCODE_SIZE);
+        rv = _ow_transfer(dev, rom, MRAA_UART_OW_ROMCODE_SIZE);
+    }
+
+    return rv;
+}
+
 const char*
 mraa_uart_ow_get_dev_path(mraa_uart_ow_context dev)
 {
@@ -302,21 +552,15 @@ mraa_uart_ow_bit(mraa_uart_ow_context dev, uint8_t bit)
         return -1;
     }
 
-    int ret = 0;
-    uint8_t ch;
-    if (bit) {
-        ret = _ow_write_byte(dev, 0xff); /* write a 1 bit */
-    }
-    else {
-        ret = _ow_write_byte(dev, 0x00); /* write a 0 bit */
+    /* 0xff writes a 1 bit, 0x00 a 0 bit */
+    uint8_t ch = bit ? 0xff : 0x00;
+    if (_ow_slots(dev, &ch, &ch, 1) != MRAA_SUCCESS) {
+         return -1;
     }
 
     /* return the bit present on the bus (0xff is a '1', anything else
      * (typically 0xfc or 0x00) is a 0
      */
-    if (_ow_read_byte(dev, &ch) != MRAA_SUCCESS || ret == -1) {
-         return -1;
-    }
     return (ch == 0xff);
 }
 
@@ -333,24 +577,33 @@ mraa_uart_ow_write_byte(mraa_uart_ow_context dev, uint8_t byte)
      * from the bus and build a byte to return.  This is possible due to
      * the way we wire the UART TX/RX pins together, similar to a
      * loopback connection, except the devices on the 1-wire bus have
-     * the ability to modify the returning bitstream.
+     * the ability to modify the returning bitstream.  All 8 bit slots
+     * go out in a single write.
      */
-
-    uint8_t bit;
-    int i;
-    for (i = 0; i < 8; i++) {
-        bit = mraa_uart_ow_bit(dev, byte & 0x01);
-        /* prep for next bit to send, and clear space for bit read */
-        byte >>= 1;
-        /* store read bit in the msb */
-        if (bit)
-            byte |= 0x80;
+    if (_ow_transfer(dev, &byte, 1) != MRAA_SUCCESS) {
+        return -1;
     }
 
     /* return the new byte read */
     return byte;
 }
 
+mraa_result_t
+mraa_uart_ow_block(mraa_uart_ow_context dev, uint8_t* buf, size_t length)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: block: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    if (!buf && length > 0) {
+        syslog(LOG_ERR, "uart_ow: block: buffer is NULL");
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    return _ow_transfer(dev, buf, length);
+}
+
 int
 mraa_uart_ow_read_byte(mraa_uart_ow_context dev)
 {
@@ -376,8 +629,8 @@ mraa_uart_ow_reset(mraa_uart_ow_context dev)
 
     uint8_t rv;
 
-    /* To emit a proper reset pulse, we set low speed (9600 baud) for
-     * the reset pulse and send 0xf0 to pull the line down for the
+    /* To emit a proper reset pulse, we set low speed (9600 baud, or
+     * 66667 in overdrive) for the reset pulse and send 0xf0 to pull the line down for the
      * minimum amount of time.
      *
      * From the Maxim whitepaper:
@@ -394,9 +647,8 @@ mraa_uart_ow_reset(mraa_uart_ow_context dev)
     }
 
     /* pull the data line low */
-    _ow_write_byte(dev, 0xf0);
-
-    if (_ow_read_byte(dev, &rv) != MRAA_SUCCESS) {
+    rv = 0xf0;
+    if (_ow_slots(dev, &rv, &rv, 1) != MRAA_SUCCESS) {
         return MRAA_ERROR_NO_DATA_AVAILABLE;
     }
 
@@ -450,6 +702,303 @@ mraa_uart_ow_rom_search(mraa_uart_ow_context dev, mraa_boolean_t start, uint8_t*
         return MRAA_ERROR_UART_OW_NO_DEVICES;
 }
 
+mraa_result_t
+mraa_uart_ow_rom_verify(mraa_uart_ow_context dev, uint8_t* id)
+{
+    if (!dev || !id) {
+        syslog(LOG_ERR, "uart_ow: rom_verify: context or id is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    mraa_result_t rv;
+    if ((rv = mraa_uart_ow_reset(dev)) != MRAA_SUCCESS)
+        return rv;
+
+    // A search that knows which way to go at every bit doesn't have to
+    // wait for the bus, so the command and all 64 steps go out at once.
+    // Devices that differ drop out as the search goes on, the one we
+    // look for is there if it answered every bit: a 0 in the id bit slot
+    // for 0 bits, a 0 in the complement slot for 1 bits.
+    uint8_t out[OW_VERIFY_SLOTS], in[OW_VERIFY_SLOTS];
+    int i;
+
+    for (i = 0; i < 8; i++)
+        out[i] = (MRAA_UART_OW_CMD_SEARCH_ROM & (1 << i)) ? 0xff : 0x00;
+    for (i = 0; i < 64; i++) {
+        mraa_boolean_t bit = (id[i / 8] >> (i % 8)) & 0x01;
+        out[8 + i * 3] = 0xff;
+        out[8 + i * 3 + 1] = 0xff;
+        out[8 + i * 3 + 2] = bit ? 0xff : 0x00;
+    }
+
+    if ((rv = _ow_slots(dev, out, in, OW_VERIFY_SLOTS)) != MRAA_SUCCESS)
+        return rv;
+
+    for (i = 0; i < 64; i++) {
+        mraa_boolean_t bit = (id[i / 8] >> (i % 8)) & 0x01;
+        if (in[8 + i * 3 + (bit ? 1 : 0)] == 0xff)
+            return MRAA_ERROR_UART_OW_NO_DEVICES;
+    }
+
+    return MRAA_SUCCESS;
+}
+
+// A bus inventory, the rom codes found so far in the order they were
+// found
+struct _mraa_uart_ow_inventory {
+    mraa_uart_ow_context dev;
+    uint8_t (*ids)[MRAA_UART_OW_ROMCODE_SIZE];
+    int count;
+    int size;
+};
+
+static int
+_ow_inventory_find(mraa_uart_ow_inventory_context inv, const uint8_t* id)
+{
+    int i;
+    for (i = 0; i < inv->count; i++) {
+        if (memcmp(inv->ids[i], id, MRAA_UART_OW_ROMCODE_SIZE) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Record a change, changes that don't fit are counted but not stored
+static void
+_ow_inventory_change(mraa_uart_ow_change_t* changes, int max_changes, int* count, const uint8_t* id, mraa_boolean_t present)
+{
+    if (changes && *count < max_changes) {
+        memcpy(changes[*count].id, id, MRAA_UART_OW_ROMCODE_SIZE);
+        changes[*count].present = present;
+    }
+    (*count)++;
+}
+
+// Drop the entries not marked as seen, reporting each as removed
+static void
+_ow_inventory_sweep(mraa_uart_ow_inventory_context inv, const mraa_boolean_t* seen, mraa_uart_ow_change_t* changes, int max_changes, int* count)
+{
+    int i, kept = 0;
+
+    for (i = 0; i < inv->count; i++) {
+        if (seen[i]) {
+            memmove(inv->ids[kept++], inv->ids[i], MRAA_UART_OW_ROMCODE_SIZE);
+        } else {
+            _ow_inventory_change(changes, max_changes, count, inv->ids[i], 0);
+        }
+    }
+    inv->count = kept;
+}
+
+mraa_uart_ow_inventory_context
+mraa_uart_ow_inventory_init(mraa_uart_ow_context dev)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: inventory_init: context is NULL");
+        return NULL;
+    }
+
+    mraa_uart_ow_inventory_context inv = calloc(1, sizeof(struct _mraa_uart_ow_inventory));
+    if (!inv) {
+        syslog(LOG_ERR, "uart_ow: inventory_init: failed to allocate memory for context");
+        return NULL;
+    }
+    inv->dev = dev;
+
+    return inv;
+}
+
+mraa_result_t
+mraa_uart_ow_inventory_stop(mraa_uart_ow_inventory_context inv)
+{
+    if (!inv) {
+        syslog(LOG_ERR, "uart_ow: inventory_stop: context is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+
+    free(inv->ids);
+    free(inv);
+
+    return MRAA_SUCCESS;
+}
+
+int
+mraa_uart_ow_inventory_search(mraa_uart_ow_inventory_context inv, int family, mraa_uart_ow_change_t* changes, int max_changes)
+{
+    if (!inv) {
+        syslog(LOG_ERR, "uart_ow: inventory_search: context is NULL");
+        return -1;
+    }
+    if (family > 0xff) {
+        syslog(LOG_ERR, "uart_ow: inventory_search: invalid family code %d", family);
+        return -1;
+    }
+
+    mraa_uart_ow_context dev = inv->dev;
+    uint8_t (*found)[MRAA_UART_OW_ROMCODE_SIZE] = NULL;
+    int found_count = 0, found_size = 0;
+    int count = 0, i;
+
+    mraa_result_t rv = mraa_uart_ow_reset(dev);
+    if (rv != MRAA_SUCCESS && rv != MRAA_ERROR_UART_OW_NO_DEVICES)
+        return -1;
+
+    if (rv == MRAA_SUCCESS) {
+        mraa_boolean_t result, complete = 0;
+
+        if (family >= 0) {
+            // jump straight to the family: the search takes the family
+            // code as the path it went last time and goes on from there
+            memset(dev->ROM_NO, 0, MRAA_UART_OW_ROMCODE_SIZE);
+            dev->ROM_NO[0] = family;
+            dev->LastDiscrepancy = 64;
+            dev->LastFamilyDiscrepancy = 0;
+            dev->LastDeviceFlag = 0;
+            result = _ow_next(dev);
+        } else {
+            result = _ow_first(dev);
+        }
+
+        for (; result; result = _ow_next(dev)) {
+            if (family >= 0 && dev->ROM_NO[0] != family) {
+                complete = 1;
+                break;
+            }
+            // a garbled rom code means the bus is noisy, don't let it
+            // change the inventory
+            if (mraa_uart_ow_crc8(dev->ROM_NO, MRAA_UART_OW_ROMCODE_SIZE - 1) != dev->ROM_NO[MRAA_UART_OW_ROMCODE_SIZE - 1]) {
+                syslog(LOG_WARNING, "uart_ow: inventory_search: rom code CRC mismatch");
+                free(found);
+                return -1;
+            }
+            if (found_count == found_size) {
+                int size = found_size ? found_size * 2 : 16;
+                void* grown = realloc(found, size * MRAA_UART_OW_ROMCODE_SIZE);
+                if (!grown) {
+                    syslog(LOG_ERR, "uart_ow: inventory_search: failed to allocate memory");
+                    free(found);
+                    return -1;
+                }
+                found = grown;
+                found_size = size;
+            }
+            memcpy(found[found_count++], dev->ROM_NO, MRAA_UART_OW_ROMCODE_SIZE);
+            if (dev->LastDeviceFlag) {
+                complete = 1;
+                break;
+            }
+        }
+
+        // devices answered the reset, so a search that stops short of the
+        // last one failed on the way rather than found the bus empty,
+        // don't report what it didn't get to as removed
+        if (!complete) {
+            syslog(LOG_WARNING, "uart_ow: inventory_search: search ended before the last device");
+            free(found);
+            return -1;
+        }
+    }
+
+    // room for everything found, and a flag for every entry
+    mraa_boolean_t* seen = calloc(inv->count + found_count + 1, sizeof(mraa_boolean_t));
+    if (seen && inv->count + found_count > inv->size) {
+        void* grown = realloc(inv->ids, (inv->count + found_count) * MRAA_UART_OW_ROMCODE_SIZE);
+        if (grown) {
+            inv->ids = grown;
+            inv->size = inv->count + found_count;
+        } else {
+            free(seen);
+            seen = NULL;
+        }
+    }
+    if (!seen) {
+        syslog(LOG_ERR, "uart_ow: inventory_search: failed to allocate memory");
+        free(found);
+        return -1;
+    }
+
+    // devices of other families weren't looked for, they stay
+    for (i = 0; i < inv->count; i++) {
+        seen[i] = family >= 0 && inv->ids[i][0] != family;
+    }
+
+    for (i = 0; i < found_count; i++) {
+        int at = _ow_inventory_find(inv, found[i]);
+        if (at >= 0) {
+            seen[at] = 1;
+            continue;
+        }
+        memcpy(inv->ids[inv->count], found[i], MRAA_UART_OW_ROMCODE_SIZE);
+        seen[inv->count++] = 1;
+        _ow_inventory_change(changes, max_changes, &count, found[i], 1);
+    }
+
+    _ow_inventory_sweep(inv, seen, changes, max_changes, &count);
+    free(found);
+    free(seen);
+
+    return count;
+}
+
+int
+mraa_uart_ow_inventory_verify(mraa_uart_ow_inventory_context inv, mraa_uart_ow_change_t* changes, int max_changes)
+{
+    if (!inv) {
+        syslog(LOG_ERR, "uart_ow: inventory_verify: context is NULL");
+        return -1;
+    }
+
+    mraa_boolean_t* seen = calloc(inv->count + 1, sizeof(mraa_boolean_t));
+    int count = 0, i;
+
+    if (!seen) {
+        syslog(LOG_ERR, "uart_ow: inventory_verify: failed to allocate memory");
+        return -1;
+    }
+
+    for (i = 0; i < inv->count; i++) {
+        mraa_result_t rv = mraa_uart_ow_rom_verify(inv->dev, inv->ids[i]);
+        if (rv == MRAA_SUCCESS) {
+            seen[i] = 1;
+        } else if (rv != MRAA_ERROR_UART_OW_NO_DEVICES) {
+            free(seen);
+            return -1;
+        }
+    }
+
+    _ow_inventory_sweep(inv, seen, changes, max_changes, &count);
+    free(seen);
+
+    return count;
+}
+
+int
+mraa_uart_ow_inventory_get_count(mraa_uart_ow_inventory_context inv)
+{
+    if (!inv) {
+        syslog(LOG_ERR, "uart_ow: inventory_get_count: context is NULL");
+        return -1;
+    }
+
+    return inv->count;
+}
+
+mraa_result_t
+mraa_uart_ow_inventory_get_id(mraa_uart_ow_inventory_context inv, int index, uint8_t* id)
+{
+    if (!inv || !id) {
+        syslog(LOG_ERR, "uart_ow: inventory_get_id: context or id is NULL");
+        return MRAA_ERROR_INVALID_HANDLE;
+    }
+    if (index < 0 || index >= inv->count) {
+        return MRAA_ERROR_INVALID_PARAMETER;
+    }
+
+    memcpy(id, inv->ids[index], MRAA_UART_OW_ROMCODE_SIZE);
+
+    return MRAA_SUCCESS;
+}
+
 mraa_result_t
 mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id)
 {
@@ -464,52 +1013,205 @@ mraa_uart_ow_command(mraa_uart_ow_context dev, uint8_t command, uint8_t* id)
     if (rv != MRAA_SUCCESS)
         return rv;
 
-    if (id) {
-        /* send the match rom command */
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_MATCH_ROM);
+    /* the rom command, rom code and command go out as one block */
+    uint8_t buf[MRAA_UART_OW_ROMCODE_SIZE + 2];
+    size_t length = 0;
 
+    if (id) {
         /* sending to a specific device, so send out the full romcode */
-        int i;
-        for (i = 0; i < MRAA_UART_OW_ROMCODE_SIZE; i++)
-            mraa_uart_ow_write_byte(dev, id[i]);
+        buf[length++] = MRAA_UART_OW_CMD_MATCH_ROM;
+        memcpy(buf + length, id, MRAA_UART_OW_ROMCODE_SIZE);
+        length += MRAA_UART_OW_ROMCODE_SIZE;
     } else {
         /* send to all devices (or a single device if it's the only one
          * on the bus)
          */
-        mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_SKIP_ROM);
+        buf[length++] = MRAA_UART_OW_CMD_SKIP_ROM;
     }
+    buf[length++] = command;
 
-    mraa_uart_ow_write_byte(dev, command);
+    return _ow_transfer(dev, buf, length);
+}
 
-    return MRAA_SUCCESS;
+int
+mraa_uart_ow_read_temperatures(mraa_uart_ow_context dev,
+                               mraa_uart_ow_temperature_t* readings,
+                               int count,
+                               unsigned int conversion_ms)
+{
+    if (!dev) {
+        syslog(LOG_ERR, "uart_ow: read_temperatures: context is NULL");
+        return -1;
+    }
+
+    if (!readings || count < 0) {
+        syslog(LOG_ERR, "uart_ow: read_temperatures: invalid readings");
+        return -1;
+    }
+
+    int i;
+    for (i = 0; i < count; i++) {
+        readings[i].ok = 0;
+    }
+
+    /* start the conversion on every device at once */
+    if (mraa_uart_ow_command(dev, MRAA_UART_OW_CMD_CONVERT_T, NULL) != MRAA_SUCCESS) {
+        return -1;
+    }
+
+    if (conversion_ms > 0) {
+        usleep(conversion_ms * 1000);
+    } else {
+        /* devices hold read slots low while converting, the wired AND
+         * of the bus reads 1 once the last one is done
+         */
+        int waited = 0;
+        int bit;
+        while ((bit = mraa_uart_ow_bit(dev, 1)) == 0 && waited < OW_CONVERSION_MAX_MS) {
+            usleep(OW_BUSY_POLL_MS * 1000);
+            waited += OW_BUSY_POLL_MS;
+        }
+        if (bit < 0) {
+            return -1;
+        }
+    }
+
+    /* one reset and one block per device: match rom, the rom code, read
+     * scratchpad and 9 read bytes
+     */
+    int good = 0;
+    for (i = 0; i < count; i++) {
+        uint8_t buf[MRAA_UART_OW_ROMCODE_SIZE + 2 + OW_SCRATCHPAD_SIZE];
+        uint8_t* scratchpad = buf + MRAA_UART_OW_ROMCODE_SIZE + 2;
+
+        mraa_result_t rv = mraa_uart_ow_reset(dev);
+        if (rv == MRAA_ERROR_UART_OW_NO_DEVICES || rv == MRAA_ERROR_UART_OW_SHORTED) {
+            /* the bus is gone, none of the others will answer either */
+            break;
+        } else if (rv != MRAA_SUCCESS) {
+            return -1;
+        }
+
+        buf[0] = MRAA_UART_OW_CMD_MATCH_ROM;
+        memcpy(buf + 1, readings[i].id, MRAA_UART_OW_ROMCODE_SIZE);
+        buf[MRAA_UART_OW_ROMCODE_SIZE + 1] = MRAA_UART_OW_CMD_READ_SCRATCHPAD;
+        memset(scratchpad, 0xff, OW_SCRATCHPAD_SIZE);
+        if (_ow_transfer(dev, buf, sizeof(buf)) != MRAA_SUCCESS) {
+            return -1;
+        }
+
+        memcpy(readings[i].scratchpad, scratchpad, OW_SCRATCHPAD_SIZE);
+        readings[i].raw = (int16_t) (scratchpad[0] | (scratchpad[1] << 8));
+        /* a device that doesn't answer reads as all 1s, which fails the
+         * CRC, a bus stuck low reads as all 0s, which doesn't
+         */
+        uint8_t any = 0;
+        int j;
+        for (j = 0; j < OW_SCRATCHPAD_SIZE; j++) {
+            any |= scratchpad[j];
+        }
+        readings[i].ok = any != 0 &&
+                         mraa_uart_ow_crc8(scratchpad, OW_SCRATCHPAD_SIZE - 1) == scratchpad[OW_SCRATCHPAD_SIZE - 1];
+        if (readings[i].ok) {
+            good++;
+        }
+    }
+
+    return good;
+}
+
+// CRC8 lookup tables, [0] advances the CRC by one byte, [k] by a byte
+// followed by k zero bytes, which lets the slice-by-4 variants take four
+// bytes per step. The CRC16 is the Modbus one started at 0, its byte
+// table is shared and _ow_crc16_slice[k - 1] is its [k].
+static uint8_t _ow_crc8_table[4][256];
+static uint16_t _ow_crc16_slice[3][256];
+static pthread_once_t _ow_crc_once = PTHREAD_ONCE_INIT;
+
+static void
+_ow_crc_make_tables()
+{
+    // 0x8c = X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0, reflected
+    static const uint8_t CRC8POLY = 0x8c;
+    int i, k;
+
+    for (i = 0; i < 256; i++) {
+        uint8_t crc8 = i;
+        for (k = 0; k < 8; k++) {
+            crc8 = (crc8 & 0x01) ? (crc8 >> 1) ^ CRC8POLY : crc8 >> 1;
+        }
+        _ow_crc8_table[0][i] = crc8;
+    }
+    for (k = 1; k < 4; k++) {
+        const uint16_t* crc16_prev = k == 1 ? mraa_modbus_crc_table : _ow_crc16_slice[k - 2];
+        for (i = 0; i < 256; i++) {
+            uint16_t crc16 = crc16_prev[i];
+            _ow_crc8_table[k][i] = _ow_crc8_table[0][_ow_crc8_table[k - 1][i]];
+            _ow_crc16_slice[k - 1][i] = (crc16 >> 8) ^ mraa_modbus_crc_table[crc16 & 0xff];
+        }
+    }
 }
 
 uint8_t
 mraa_uart_ow_crc8(uint8_t* buffer, uint16_t length)
 {
-    // 0x18 = X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0
-    static const uint8_t CRC8POLY = 0x18;
+    uint8_t crc = 0x00;
+    uint16_t i;
+
+    pthread_once(&_ow_crc_once, _ow_crc_make_tables);
+
+    for (i = 0; i < length; i++)
+        crc = _ow_crc8_table[0][crc ^ buffer[i]];
+
+    return crc;
+}
 
+uint8_t
+mraa_uart_ow_crc8_slice4(uint8_t* buffer, uint16_t length)
+{
     uint8_t crc = 0x00;
-    uint16_t loop_count;
-    uint8_t bit_counter;
-    uint8_t data;
-    uint8_t feedback_bit;
-
-    for (loop_count = 0; loop_count != length; loop_count++) {
-        data = buffer[loop_count];
-        bit_counter = 8;
-        do {
-            feedback_bit = (crc ^ data) & 0x01;
-            if (feedback_bit == 0x01)
-                crc = crc ^ CRC8POLY;
-            crc = (crc >> 1) & 0x7F;
-            if (feedback_bit == 0x01)
-                crc = crc | 0x80;
-            data = data >> 1;
-            bit_counter--;
-        } while (bit_counter > 0);
+
+    pthread_once(&_ow_crc_once, _ow_crc_make_tables);
+
+    while (length >= 4) {
+        crc = _ow_crc8_table[3][crc ^ buffer[0]] ^ _ow_crc8_table[2][buffer[1]] ^
+              _ow_crc8_table[1][buffer[2]] ^ _ow_crc8_table[0][buffer[3]];
+        buffer += 4;
+        length -= 4;
+    }
+    while (length--)
+        crc = _ow_crc8_table[0][crc ^ *buffer++];
+
+    return crc;
+}
+
+uint16_t
+mraa_uart_ow_crc16(uint8_t* buffer, uint16_t length)
+{
+    uint16_t crc = 0x0000;
+    uint16_t i;
+
+    for (i = 0; i < length; i++)
+        crc = (crc >> 8) ^ mraa_modbus_crc_table[(crc ^ buffer[i]) & 0xff];
+
+    return crc;
+}
+
+uint16_t
+mraa_uart_ow_crc16_slice4(uint8_t* buffer, uint16_t length)
+{
+    uint16_t crc = 0x0000;
+
+    pthread_once(&_ow_crc_once, _ow_crc_make_tables);
+
+    while (length >= 4) {
+        crc = _ow_crc16_slice[2][(crc ^ buffer[0]) & 0xff] ^ _ow_crc16_slice[1][(crc >> 8) ^ buffer[1]] ^
+              _ow_crc16_slice[0][buffer[2]] ^ mraa_modbus_crc_table[buffer[3]];
+        buffer += 4;
+        length -= 4;
     }
+    while (length--)
+        crc = (crc >> 8) ^ mraa_modbus_crc_table[(crc ^ *buffer++) & 0xff];
 
     return crc;
 }
@@ -18,6 +18,7 @@ class UartChecksDataAvailable(u.TestCase):
     del self.uart
 
   def test_uart_data_available(self):
+    self.uart.writeStr("Z")
     self.assertEqual(self.uart.dataAvailable(10),
                      True,
                      "Running UART dataAvailable() did not return True")
@@ -6,6 +6,7 @@
 # SPDX-License-Identifier: MIT
 
 import mraa as m
+import time
 import unittest as u
 
 from uart_checks_shared import *
@@ -20,6 +21,8 @@ class UartChecksRead(u.TestCase):
   def test_uart_read(self):
     TEST_DATA_LEN = 10
     EXPECTED_RESULT = bytearray([MOCK_UART_DATA_BYTE for x in range(TEST_DATA_LEN)])
+    self.uart.write(EXPECTED_RESULT)
+    time.sleep(MOCK_UART_LOOPBACK_DELAY)
     self.assertEqual(self.uart.read(TEST_DATA_LEN),
                      EXPECTED_RESULT,
                      "Running UART read(%d) did not return %s" % (TEST_DATA_LEN, repr(EXPECTED_RESULT)))
@@ -27,6 +30,8 @@ class UartChecksRead(u.TestCase):
   def test_uart_readStr(self):
     TEST_DATA_LEN = 10
     EXPECTED_RESULT = chr(MOCK_UART_DATA_BYTE) * TEST_DATA_LEN
+    self.uart.writeStr(EXPECTED_RESULT)
+    time.sleep(MOCK_UART_LOOPBACK_DELAY)
     self.assertEqual(self.uart.readStr(TEST_DATA_LEN),
                      EXPECTED_RESULT,
                      "Running UART readStr(%d) did not return %s" % (TEST_DATA_LEN, EXPECTED_RESULT))
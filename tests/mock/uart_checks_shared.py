@@ -6,5 +6,7 @@
 # SPDX-License-Identifier: MIT
 
 MRAA_UART_DEV_NUM = 0
-# This one is defined in mock_board_uart.h
+# written to the mock loopback and read back
 MOCK_UART_DATA_BYTE = 0x5A
+# the mock line is a loopback, this is long enough for 10 bytes at 9600 baud
+MOCK_UART_LOOPBACK_DELAY = 0.1
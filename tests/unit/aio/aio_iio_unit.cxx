@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "aio/aio_iio.h"
+
+/* Scan element types, layout and unpacking of the IIO buffered capture */
+class aio_iio : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        aio_iio() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~aio_iio() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            memset(&buf, 0, sizeof(buf));
+            memset(elements, 0, sizeof(elements));
+            buf.fd = -1;
+            buf.trigger_now_fd = -1;
+            buf.timestamp_location = -1;
+            buf.elements = elements;
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown() {}
+
+        mraa_aio_iio_buffer_t buf;
+        mraa_aio_iio_element_t elements[4];
+};
+
+/* Types parse into storage, bits, shift, sign and endianness */
+TEST_F(aio_iio, test_parse_type)
+{
+    mraa_aio_iio_element_t e;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s12/16>>4", &e));
+    ASSERT_EQ(2, e.bytes);
+    ASSERT_EQ(12, e.bits);
+    ASSERT_EQ(4, e.shift);
+    ASSERT_TRUE(e.is_signed);
+    ASSERT_FALSE(e.big_endian);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("be:u24/32", &e));
+    ASSERT_EQ(4, e.bytes);
+    ASSERT_EQ(24, e.bits);
+    ASSERT_EQ(0, e.shift);
+    ASSERT_FALSE(e.is_signed);
+    ASSERT_TRUE(e.big_endian);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s32/32", &e));
+    ASSERT_EQ(4, e.bytes);
+    ASSERT_EQ(32, e.bits);
+    ASSERT_EQ(0, e.shift);
+    ASSERT_TRUE(e.is_signed);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s64/64", &e));
+    ASSERT_EQ(8, e.bytes);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_aio_iio_parse_type("le:s12/12", &e));
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_aio_iio_parse_type("le:s12", &e));
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_aio_iio_parse_type("", &e));
+}
+
+/* Each element is aligned to its size and the scan to the largest */
+TEST_F(aio_iio, test_scan_layout)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:u12/16", &elements[0]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("be:u24/32", &elements[1]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s8/8", &elements[2]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s64/64", &elements[3]));
+
+    ASSERT_EQ(24, mraa_aio_iio_scan_layout(elements, 4));
+    ASSERT_EQ(0, elements[0].location);
+    ASSERT_EQ(4, elements[1].location);
+    ASSERT_EQ(8, elements[2].location);
+    ASSERT_EQ(16, elements[3].location);
+
+    // a 32 bit value pads a scan ending on a 16 bit one
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:u32/32", &elements[0]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:u16/16", &elements[1]));
+    ASSERT_EQ(8, mraa_aio_iio_scan_layout(elements, 2));
+    ASSERT_EQ(0, elements[0].location);
+    ASSERT_EQ(4, elements[1].location);
+
+    ASSERT_EQ(0, mraa_aio_iio_scan_layout(elements, 0));
+}
+
+/* Values are shifted, masked and sign extended, the timestamp read as is */
+TEST_F(aio_iio, test_unpack)
+{
+    int32_t samples[3];
+    uint8_t scan[24];
+    int64_t timestamp = 1234567890123LL;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s12/16>>4", &elements[0]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("be:u24/32", &elements[1]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s32/32", &elements[2]));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_iio_parse_type("le:s64/64", &elements[3]));
+    ASSERT_EQ(24, mraa_aio_iio_scan_layout(elements, 4));
+    buf.count = 3;
+    buf.timestamp_location = elements[3].location;
+
+    memset(scan, 0xee, sizeof(scan));
+    // -5 in 12 bits above 4 bits of noise
+    scan[0] = 0xb7;
+    scan[1] = 0xff;
+    // 0x123456 below a byte of noise
+    scan[4] = 0xab;
+    scan[5] = 0x12;
+    scan[6] = 0x34;
+    scan[7] = 0x56;
+    // -2
+    scan[8] = 0xfe;
+    scan[9] = 0xff;
+    scan[10] = 0xff;
+    scan[11] = 0xff;
+    memcpy(scan + 16, &timestamp, sizeof(timestamp));
+
+    mraa_aio_iio_buffer_unpack(&buf, scan, samples);
+    ASSERT_EQ(-5, samples[0]);
+    ASSERT_EQ(0x123456, samples[1]);
+    ASSERT_EQ(-2, samples[2]);
+    ASSERT_EQ(timestamp, mraa_aio_iio_buffer_timestamp(&buf, scan));
+
+    // the same bits unsigned aren't extended
+    elements[0].is_signed = 0;
+    mraa_aio_iio_buffer_unpack(&buf, scan, samples);
+    ASSERT_EQ(0xffb, samples[0]);
+
+    buf.timestamp_location = -1;
+    ASSERT_EQ(-1, mraa_aio_iio_buffer_timestamp(&buf, scan));
+}
@@ -83,7 +83,8 @@ TEST_F(api_common_h_unit, test_libmraa_common_methods)
         EXPECT_EQ(1, mraa_get_i2c_bus_count());
         EXPECT_EQ(0, mraa_get_i2c_bus_id(0));
         EXPECT_EQ(0, mraa_get_pwm_count());
-        EXPECT_EQ(1, mraa_get_spi_bus_count());
+        /* spidev bus 0 plus bit-banged bus 1 */
+        EXPECT_EQ(2, mraa_get_spi_bus_count());
         EXPECT_EQ(1, mraa_get_uart_count());
 
         /* Test pin to name method/s */
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/aio.h"
+#include "gtest/gtest.h"
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+
+#define CHANNELS 4
+
+/* MRAA AIO C API test fixture, runs against the mock platform */
+class mraa_aio_h_unit : public ::testing::Test
+{
+  protected:
+    virtual void
+    SetUp()
+    {
+        for (int i = 0; i < CHANNELS; i++) {
+            dev[i] = mraa_aio_init(0);
+            ASSERT_TRUE(dev[i] != NULL);
+        }
+    }
+
+    virtual void
+    TearDown()
+    {
+        for (int i = 0; i < CHANNELS; i++) {
+            mraa_aio_close(dev[i]);
+        }
+    }
+
+    mraa_aio_context dev[CHANNELS];
+};
+
+/* The mock board replaces AIO reads, the group reads through them */
+TEST_F(mraa_aio_h_unit, test_group_read)
+{
+    int32_t samples[CHANNELS];
+    uint64_t first, second;
+
+    mraa_aio_group_context group = mraa_aio_group_init(dev, CHANNELS);
+    ASSERT_TRUE(group != NULL);
+    ASSERT_EQ(CHANNELS, mraa_aio_group_get_count(group));
+    ASSERT_FALSE(mraa_aio_group_is_buffered(group));
+
+    memset(samples, 0xff, sizeof(samples));
+    ASSERT_EQ(CHANNELS, mraa_aio_group_read(group, samples, &first));
+    for (int i = 0; i < CHANNELS; i++) {
+        ASSERT_GE(samples[i], 0);
+        ASSERT_LT(samples[i], 1 << mraa_aio_get_bit(dev[i]));
+    }
+    ASSERT_EQ(CHANNELS, mraa_aio_group_read(group, samples, &second));
+    ASSERT_GE(second, first);
+    ASSERT_EQ(CHANNELS, mraa_aio_group_read(group, samples, NULL));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_group_close(group));
+}
+
+TEST_F(mraa_aio_h_unit, test_group_invalid)
+{
+    int32_t samples[CHANNELS];
+    mraa_aio_context none[2] = { dev[0], NULL };
+
+    ASSERT_TRUE(mraa_aio_group_init(dev, 0) == NULL);
+    ASSERT_TRUE(mraa_aio_group_init(NULL, 1) == NULL);
+    ASSERT_TRUE(mraa_aio_group_init(none, 2) == NULL);
+    ASSERT_EQ(-1, mraa_aio_group_read(NULL, samples, NULL));
+    ASSERT_EQ(-1, mraa_aio_group_get_count(NULL));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_group_close(NULL));
+}
+
+/* Without an IIO buffer the capture thread reads the channel at the rate */
+TEST_F(mraa_aio_h_unit, test_stream_ring)
+{
+    int32_t ring[512], samples[512];
+    mraa_aio_stream_stats_t stats;
+    int got = 0;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_start(dev[0], 1000, ring, 512));
+    ASSERT_FALSE(mraa_aio_stream_is_buffered(dev[0]));
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_aio_stream_start(dev[0], 1000, ring, 512));
+
+    while (got < 50) {
+        int n = mraa_aio_stream_read(dev[0], samples + got, 512 - got, 1000);
+        ASSERT_GT(n, 0);
+        got += n;
+    }
+    for (int i = 0; i < got; i++) {
+        ASSERT_GE(samples[i], 0);
+        ASSERT_LT(samples[i], 1 << mraa_aio_get_bit(dev[0]));
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_get_stats(dev[0], &stats));
+    ASSERT_GE(stats.samples, (uint64_t) got);
+    ASSERT_EQ(0u, stats.dropped);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stop(dev[0]));
+    ASSERT_EQ(-1, mraa_aio_stream_read(dev[0], samples, 1, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_stream_get_stats(dev[0], &stats));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stop(dev[0]));
+}
+
+/* A ring nobody reads fills up and the newer samples are counted as dropped */
+TEST_F(mraa_aio_h_unit, test_stream_ring_full)
+{
+    int32_t ring[8], samples[8];
+    mraa_aio_stream_stats_t stats;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_start(dev[1], 2000, ring, 8));
+    for (int i = 0; i < 1000; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_get_stats(dev[1], &stats));
+        if (stats.dropped > 0) {
+            break;
+        }
+        usleep(1000);
+    }
+    ASSERT_GT(stats.dropped, 0u);
+    ASSERT_EQ(8, mraa_aio_stream_read(dev[1], samples, 8, 0));
+
+    /* closing stops the capture */
+    mraa_aio_close(dev[1]);
+    dev[1] = mraa_aio_init(0);
+    ASSERT_TRUE(dev[1] != NULL);
+}
+
+struct stream_count {
+    std::atomic<int> samples;
+    mraa_aio_context dev;
+    mraa_boolean_t bad_call;
+};
+
+static void
+stream_callback(mraa_aio_context dev, const int32_t* samples, int count, uint64_t timestamp, void* args)
+{
+    struct stream_count* sc = (struct stream_count*) args;
+    if (dev != sc->dev || timestamp == 0) {
+        sc->bad_call = 1;
+    }
+    sc->samples += count;
+}
+
+TEST_F(mraa_aio_h_unit, test_stream_callback)
+{
+    struct stream_count sc;
+    sc.samples = 0;
+    sc.dev = dev[2];
+    sc.bad_call = 0;
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_stream_start_callback(dev[2], 0, stream_callback, &sc));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_stream_start_callback(dev[2], 1000000001, stream_callback, &sc));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_stream_start(dev[2], 1000, NULL, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_start_callback(dev[2], 1000, stream_callback, &sc));
+    for (int i = 0; i < 1000 && sc.samples < 20; i++) {
+        usleep(1000);
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stop(dev[2]));
+    ASSERT_GE(sc.samples, 20);
+    ASSERT_FALSE(sc.bad_call);
+
+    /* no ring to read from */
+    int32_t sample;
+    ASSERT_EQ(-1, mraa_aio_stream_read(dev[2], &sample, 1, 0));
+
+    /* a stopped capture can be started again */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_start_callback(dev[2], 1000, stream_callback, &sc));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_stream_stop(dev[2]));
+}
+
+/* Every context keeps its own scaling */
+TEST_F(mraa_aio_h_unit, test_scale)
+{
+    int32_t raw[5] = { 0, 1, 100, 511, 1023 };
+    int32_t values[5];
+    float floats[5];
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_bit(dev[1], 8));
+    ASSERT_EQ(10, mraa_aio_get_bit(dev[0]));
+    ASSERT_EQ(8, mraa_aio_get_bit(dev[1]));
+
+    /* the mock board replaces reads, its samples are scaled already */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_scale(dev[0], raw, values, 5));
+    ASSERT_EQ(0, memcmp(raw, values, sizeof(raw)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_scale_float(dev[0], raw, floats, 5));
+    ASSERT_FLOAT_EQ(0.0f, floats[0]);
+    ASSERT_FLOAT_EQ(1.0f, floats[4]);
+    for (int i = 1; i < 5; i++) {
+        ASSERT_GT(floats[i], floats[i - 1]);
+    }
+
+    /* in place */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_scale(dev[1], raw, raw, 5));
+    ASSERT_EQ(1023, raw[4]);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_scale(dev[0], NULL, NULL, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_scale(NULL, raw, values, 5));
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_aio_scale_float(dev[0], NULL, floats, 5));
+
+    /* reads follow the new width too */
+    int value = mraa_aio_read(dev[1]);
+    ASSERT_GE(value, 0);
+    ASSERT_LT(value, 256);
+    float f = mraa_aio_read_float(dev[1]);
+    ASSERT_GE(f, 0.0f);
+    ASSERT_LE(f, 1.0f);
+}
+
+/* Decimation and the filters on known samples */
+TEST_F(mraa_aio_h_unit, test_filter_samples)
+{
+    int32_t out[16];
+
+    /* no filter, a copy */
+    int32_t plain[3] = { 7, 8, 9 };
+    ASSERT_EQ(3, mraa_aio_filter_samples(dev[0], plain, out, 3));
+    ASSERT_EQ(0, memcmp(plain, out, sizeof(plain)));
+
+    /* four raw samples per output, the leftover one waits for the next call */
+    int32_t decimate[9] = { 0, 4, 8, 13, 100, 100, 100, 100, 1 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[0], 4, MRAA_AIO_FILTER_NONE, 0));
+    ASSERT_EQ(2, mraa_aio_filter_samples(dev[0], decimate, out, 9));
+    ASSERT_EQ(6, out[0]);
+    ASSERT_EQ(100, out[1]);
+    int32_t rest[3] = { 1, 1, 2 };
+    ASSERT_EQ(1, mraa_aio_filter_samples(dev[0], rest, out, 3));
+    ASSERT_EQ(1, out[0]);
+
+    int32_t average[3] = { 10, 20, 31 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[0], 1, MRAA_AIO_FILTER_MOVING_AVERAGE, 2));
+    ASSERT_EQ(3, mraa_aio_filter_samples(dev[0], average, out, 3));
+    ASSERT_EQ(10, out[0]);
+    ASSERT_EQ(15, out[1]);
+    ASSERT_EQ(26, out[2]);
+
+    /* a spike doesn't get through a median of three */
+    int32_t median[5] = { 10, 1000, 12, 11, 13 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[0], 1, MRAA_AIO_FILTER_MEDIAN, 3));
+    ASSERT_EQ(5, mraa_aio_filter_samples(dev[0], median, out, 5));
+    ASSERT_EQ(10, out[0]);
+    ASSERT_EQ(505, out[1]);
+    ASSERT_EQ(12, out[2]);
+    ASSERT_EQ(12, out[3]);
+    ASSERT_EQ(12, out[4]);
+
+    /* period 3 weighs each new sample by a half, in place */
+    int32_t ema[3] = { 100, 200, 200 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[0], 1, MRAA_AIO_FILTER_EMA, 3));
+    ASSERT_EQ(3, mraa_aio_filter_samples(dev[0], ema, ema, 3));
+    ASSERT_EQ(100, ema[0]);
+    ASSERT_EQ(150, ema[1]);
+    ASSERT_EQ(175, ema[2]);
+
+    /* a reset starts the EMA over */
+    int32_t again[1] = { 40 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_filter_reset(dev[0]));
+    ASSERT_EQ(1, mraa_aio_filter_samples(dev[0], again, out, 1));
+    ASSERT_EQ(40, out[0]);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_set_filter(dev[0], 0, MRAA_AIO_FILTER_NONE, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_aio_set_filter(dev[0], 1, MRAA_AIO_FILTER_MEDIAN, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER,
+              mraa_aio_set_filter(dev[0], 1, MRAA_AIO_FILTER_EMA, MRAA_AIO_FILTER_MAX_LENGTH + 1));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER,
+              mraa_aio_set_filter(dev[0], MRAA_AIO_FILTER_MAX_OVERSAMPLING + 1, MRAA_AIO_FILTER_NONE, 0));
+    ASSERT_EQ(-1, mraa_aio_filter_samples(NULL, plain, out, 3));
+}
+
+/* Filtered reads oversample through the board's reads */
+TEST_F(mraa_aio_h_unit, test_read_filtered)
+{
+    /* without a filter, plain reads */
+    int value = mraa_aio_read_filtered(dev[0]);
+    ASSERT_GE(value, 0);
+    ASSERT_LT(value, 1 << mraa_aio_get_bit(dev[0]));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[0], 16, MRAA_AIO_FILTER_MOVING_AVERAGE, 4));
+    for (int i = 0; i < 8; i++) {
+        value = mraa_aio_read_filtered(dev[0]);
+        ASSERT_GE(value, 0);
+        ASSERT_LT(value, 1 << mraa_aio_get_bit(dev[0]));
+        float f = mraa_aio_read_filtered_float(dev[0]);
+        ASSERT_GE(f, 0.0f);
+        ASSERT_LE(f, 1.0f);
+    }
+
+    /* turning it off and closing with a filter set */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[0], 1, MRAA_AIO_FILTER_NONE, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_aio_set_filter(dev[1], 4, MRAA_AIO_FILTER_EMA, 8));
+}
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mraa/modbus.h"
+
+#define SIM_SLAVE 17
+#define SIM_REGISTERS 100
+/* how the simulated slave spoils its replies */
+#define SIM_FAULT_NONE 0
+#define SIM_FAULT_CRC 1
+#define SIM_FAULT_SLAVE 2
+
+/* Modbus master on a pseudo terminal, a thread on the master side plays
+ * slave SIM_SLAVE with SIM_REGISTERS holding registers */
+class mraa_modbus_h_pty : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_modbus_h_pty() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_modbus_h_pty() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            dev = NULL;
+            master = -1;
+            running = false;
+            requests = 0;
+            fault = SIM_FAULT_NONE;
+            if (mraa_get_platform_type() == MRAA_MOCK_PLATFORM) {
+                GTEST_SKIP() << "uart functions are replaced on the mock platform";
+            }
+            for (int i = 0; i < SIM_REGISTERS; i++) {
+                registers[i] = 0x1000 + i;
+            }
+            master = posix_openpt(O_RDWR | O_NOCTTY);
+            ASSERT_GE(master, 0);
+            ASSERT_EQ(0, grantpt(master));
+            ASSERT_EQ(0, unlockpt(master));
+            /* ptys refuse PARENB, so no parity and two stop bits */
+            dev = mraa_modbus_init_raw(ptsname(master), 115200, MRAA_UART_PARITY_NONE);
+            ASSERT_TRUE(dev != NULL);
+            running = true;
+            slave = std::thread(&mraa_modbus_h_pty::simulate, this);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            if (running) {
+                running = false;
+                slave.join();
+            }
+            if (dev != NULL) {
+                mraa_modbus_stop(dev);
+            }
+            if (master >= 0) {
+                close(master);
+            }
+        }
+
+        void reply(std::vector<uint8_t> frame)
+        {
+            if (fault == SIM_FAULT_SLAVE) {
+                frame[0]++;
+            }
+            uint16_t crc = mraa_modbus_crc16(frame.data(), frame.size());
+            frame.push_back(crc & 0xFF);
+            frame.push_back(crc >> 8);
+            if (fault == SIM_FAULT_CRC) {
+                frame.back() ^= 0x01;
+            }
+            if (write(master, frame.data(), frame.size()) < 0) {
+                ADD_FAILURE() << "slave write failed";
+            }
+        }
+
+        void answer(const std::vector<uint8_t>& rq)
+        {
+            unsigned int addr = (rq[2] << 8) | rq[3];
+            unsigned int arg = (rq[4] << 8) | rq[5];
+
+            requests++;
+            if (rq[0] != SIM_SLAVE) {
+                return;
+            }
+            if ((rq[1] != 0x06 && addr + arg > SIM_REGISTERS) || addr >= SIM_REGISTERS) {
+                reply({ rq[0], (uint8_t)(rq[1] | 0x80), 0x02 });
+                return;
+            }
+            if (rq[1] == 0x03 || rq[1] == 0x04) {
+                std::vector<uint8_t> out = { rq[0], rq[1], (uint8_t)(arg * 2) };
+                for (unsigned int i = 0; i < arg; i++) {
+                    out.push_back(registers[addr + i] >> 8);
+                    out.push_back(registers[addr + i] & 0xFF);
+                }
+                reply(out);
+            } else if (rq[1] == 0x06) {
+                registers[addr] = arg;
+                reply(std::vector<uint8_t>(rq.begin(), rq.begin() + 6));
+            } else if (rq[1] == 0x10) {
+                for (unsigned int i = 0; i < arg; i++) {
+                    registers[addr + i] = (rq[7 + i * 2] << 8) | rq[8 + i * 2];
+                }
+                reply(std::vector<uint8_t>(rq.begin(), rq.begin() + 6));
+            }
+        }
+
+        void simulate()
+        {
+            std::vector<uint8_t> rq;
+            struct pollfd pfd = { master, POLLIN, 0 };
+
+            while (running) {
+                if (poll(&pfd, 1, 10) <= 0) {
+                    continue;
+                }
+                uint8_t buf[256];
+                ssize_t n = read(master, buf, sizeof(buf));
+                if (n <= 0) {
+                    continue;
+                }
+                rq.insert(rq.end(), buf, buf + n);
+                while (rq.size() >= 8) {
+                    size_t need = rq[1] == 0x10 ? 9 + rq[6] : 8;
+                    if (rq.size() < need) {
+                        break;
+                    }
+                    std::vector<uint8_t> frame(rq.begin(), rq.begin() + need);
+                    rq.erase(rq.begin(), rq.begin() + need);
+                    if (mraa_modbus_crc16(frame.data(), frame.size()) != 0) {
+                        ADD_FAILURE() << "request with a bad CRC";
+                        continue;
+                    }
+                    answer(frame);
+                }
+            }
+        }
+
+        int master;
+        mraa_modbus_context dev;
+        std::thread slave;
+        std::atomic<bool> running;
+        std::atomic<int> requests;
+        std::atomic<int> fault;
+        uint16_t registers[SIM_REGISTERS];
+};
+
+/* Reference frame from the Modbus specification */
+TEST(mraa_modbus_h, test_crc16)
+{
+    uint8_t frame[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x0A };
+
+    ASSERT_EQ(0xCDC5, mraa_modbus_crc16(frame, sizeof(frame)));
+}
+
+/* 3.5 characters at low rates, fixed 1750us above 19200 */
+TEST_F(mraa_modbus_h_pty, test_frame_gap)
+{
+    ASSERT_EQ(1750, dev->gap_us);
+    ASSERT_EQ(95, dev->char_us);
+}
+
+TEST_F(mraa_modbus_h_pty, test_read_write)
+{
+    uint16_t values[4];
+    uint16_t write[3] = { 0xAAAA, 0xBBBB, 0xCCCC };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_read_registers(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 10, 4, values));
+    ASSERT_EQ(0x100A, values[0]);
+    ASSERT_EQ(0x100D, values[3]);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_write_register(dev, SIM_SLAVE, 10, 0x1234));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_write_registers(dev, SIM_SLAVE, 11, 3, write));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_read_registers(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 10, 4, values));
+    ASSERT_EQ(0x1234, values[0]);
+    ASSERT_EQ(0xBBBB, values[2]);
+
+    mraa_modbus_slave_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_get_stats(dev, SIM_SLAVE, &stats));
+    ASSERT_EQ(4, stats.requests);
+    ASSERT_EQ(4, stats.responses);
+    ASSERT_LE(stats.latency_min_us, stats.latency_max_us);
+}
+
+/* Adjacent and overlapping reads go out as one request */
+TEST_F(mraa_modbus_h_pty, test_poll_merge)
+{
+    uint16_t a[4], b[2], c[3], d[1];
+
+    int ida = mraa_modbus_poll_add(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 0, 4, a, 1000);
+    int idb = mraa_modbus_poll_add(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 4, 2, b, 1000);
+    int idc = mraa_modbus_poll_add(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 3, 3, c, 1000);
+    int idd = mraa_modbus_poll_add(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 50, 1, d, 1000);
+    ASSERT_GE(ida, 0);
+    ASSERT_GE(idd, 0);
+
+    ASSERT_EQ(2, mraa_modbus_poll(dev));
+    ASSERT_EQ(2, requests);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_poll_result(dev, ida));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_poll_result(dev, idc));
+    ASSERT_EQ(0x1003, a[3]);
+    ASSERT_EQ(0x1005, b[1]);
+    ASSERT_EQ(0x1003, c[0]);
+    ASSERT_EQ(0x1032, d[0]);
+
+    /* nothing is due again for a second */
+    ASSERT_EQ(0, mraa_modbus_poll(dev));
+    ASSERT_GT(mraa_modbus_poll_next_ms(dev), 900);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_poll_remove(dev, idb));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_modbus_poll_result(dev, idb));
+}
+
+/* A slave that never answers times out and is counted */
+TEST_F(mraa_modbus_h_pty, test_timeout)
+{
+    uint16_t value;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_set_timeout(dev, 30));
+    ASSERT_EQ(MRAA_ERROR_NO_DATA_AVAILABLE,
+              mraa_modbus_read_registers(dev, SIM_SLAVE + 1, MRAA_MODBUS_READ_INPUT_REGISTERS, 0, 1, &value));
+
+    mraa_modbus_slave_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_get_stats(dev, SIM_SLAVE + 1, &stats));
+    ASSERT_EQ(1, stats.requests);
+    ASSERT_EQ(1, stats.timeouts);
+    ASSERT_EQ(0, stats.responses);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_reset_stats(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_get_stats(dev, SIM_SLAVE + 1, &stats));
+    ASSERT_EQ(0, stats.requests);
+}
+
+/* Reads past the register map get an illegal data address exception */
+TEST_F(mraa_modbus_h_pty, test_exception)
+{
+    uint16_t values[4];
+
+    ASSERT_EQ(MRAA_ERROR_UNSPECIFIED,
+              mraa_modbus_read_registers(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 98, 4, values));
+
+    mraa_modbus_slave_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_get_stats(dev, SIM_SLAVE, &stats));
+    ASSERT_EQ(1, stats.exceptions);
+    ASSERT_EQ(0x02, stats.last_exception);
+}
+
+/* A bad CRC and a reply from the wrong slave are counted apart */
+TEST_F(mraa_modbus_h_pty, test_bad_response)
+{
+    uint16_t value;
+    mraa_modbus_slave_stats_t stats;
+
+    fault = SIM_FAULT_CRC;
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE,
+              mraa_modbus_read_registers(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 0, 1, &value));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_get_stats(dev, SIM_SLAVE, &stats));
+    ASSERT_EQ(1, stats.crc_errors);
+    ASSERT_EQ(0, stats.frame_errors);
+
+    fault = SIM_FAULT_SLAVE;
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE,
+              mraa_modbus_read_registers(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 0, 1, &value));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_modbus_get_stats(dev, SIM_SLAVE, &stats));
+    ASSERT_EQ(1, stats.crc_errors);
+    ASSERT_EQ(1, stats.frame_errors);
+    ASSERT_EQ(0, stats.io_errors);
+    ASSERT_EQ(0, stats.responses);
+
+    fault = SIM_FAULT_NONE;
+    ASSERT_EQ(MRAA_SUCCESS,
+              mraa_modbus_read_registers(dev, SIM_SLAVE, MRAA_MODBUS_READ_HOLDING_REGISTERS, 0, 1, &value));
+    ASSERT_EQ(0x1000, value);
+}
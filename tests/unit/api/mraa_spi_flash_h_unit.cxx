@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/spi_flash.h"
+#include "gtest/gtest.h"
+#include <string.h>
+#include <vector>
+
+/* The mock SPI bus 0 carries an emulated 256KiB flash with SFDP */
+#define MOCK_SPI_FLASH_SIZE (256 * 1024)
+
+/* MRAA SPI flash C API test fixture, runs against the mock platform */
+class mraa_spi_flash_h_unit : public ::testing::Test
+{
+  protected:
+    virtual void
+    SetUp()
+    {
+        dev = mraa_spi_flash_init(0);
+        ASSERT_TRUE(dev != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        mraa_spi_flash_stop(dev);
+    }
+
+    mraa_spi_flash_context dev;
+};
+
+TEST_F(mraa_spi_flash_h_unit, test_identify)
+{
+    ASSERT_EQ(0xEF, dev->jedec_id[0]);
+    ASSERT_EQ(0x40, dev->jedec_id[1]);
+    ASSERT_EQ(0x12, dev->jedec_id[2]);
+    ASSERT_TRUE(dev->sfdp);
+    ASSERT_EQ((uint32_t) MOCK_SPI_FLASH_SIZE, dev->size);
+    ASSERT_EQ(256u, dev->page_size);
+    ASSERT_EQ(4096u, dev->erase_size);
+    ASSERT_EQ(0x20, dev->erase_opcode);
+    ASSERT_EQ(3, dev->addr_bytes);
+    ASSERT_EQ(32u, dev->program_time_us);
+    /* the mock controller has no quad lines, so 1-1-2 is the best it gets */
+    ASSERT_EQ(MRAA_SPI_FLASH_CMD_DUAL_READ, dev->read_opcode);
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_DUAL, dev->read_width);
+    ASSERT_EQ(1, dev->read_dummy);
+}
+
+TEST_F(mraa_spi_flash_h_unit, test_erase_write_read)
+{
+    const uint32_t addr = 0x2000 + 100;
+    std::vector<uint8_t> data(700), back(data.size());
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_erase(dev, 0x2000, 4096));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_read(dev, 0x2000, &back[0], back.size()));
+    for (size_t i = 0; i < back.size(); i++) {
+        ASSERT_EQ(0xFF, back[i]);
+    }
+
+    /* unaligned start and end, spans three pages */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_write(dev, addr, &data[0], data.size()));
+    ASSERT_EQ(0, mraa_spi_flash_read_status(dev) & 0x03);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_read(dev, addr, &back[0], back.size()));
+    ASSERT_EQ(0, memcmp(&data[0], &back[0], data.size()));
+
+    uint8_t edge[2];
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_read(dev, addr - 1, edge, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_read(dev, addr + data.size(), edge + 1, 1));
+    ASSERT_EQ(0xFF, edge[0]);
+    ASSERT_EQ(0xFF, edge[1]);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_flash_erase(dev, 0x2001, 4096));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_flash_write(dev, MOCK_SPI_FLASH_SIZE - 1, &data[0], 2));
+}
+
+TEST_F(mraa_spi_flash_h_unit, test_chunked_read)
+{
+    /* larger than the spidev buffer, so it must be split into messages */
+    const uint32_t len = 3 * dev->max_transfer + 17;
+    std::vector<uint8_t> data(len), back(len);
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)(i ^ (i >> 8));
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_erase(dev, 0x10000, (len + 4095) & ~4095u));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_write(dev, 0x10000, &data[0], len));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_flash_read(dev, 0x10000, &back[0], len));
+    ASSERT_EQ(0, memcmp(&data[0], &back[0], len));
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mraa/spi.h"
+#include "gtest/gtest.h"
+#include <string.h>
+
+#define MOCK_SPI_REPLY_DATA_MODIFIER_BYTE 0xAB
+#define MOCK_SPI_REPLY_DATA_MODIFIER_WORD 0xABBA
+#define MOCK_SPI_REPLY_DATA_MODIFIER_WORD32 0xABBAABBA
+
+/* Reference bit reversal of the low 'bits' bits of a value */
+static uint32_t
+reverse_bits(uint32_t value, unsigned int bits)
+{
+    uint32_t out = 0;
+    for (unsigned int i = 0; i < bits; i++) {
+        if (value & (1UL << i)) {
+            out |= 1UL << (bits - 1 - i);
+        }
+    }
+    return out;
+}
+
+/* MRAA SPI C API test fixture, runs against the mock platform */
+class mraa_spi_h_unit : public ::testing::Test
+{
+  protected:
+    virtual void
+    SetUp()
+    {
+        dev = mraa_spi_init(0);
+        ASSERT_TRUE(dev != NULL);
+    }
+
+    virtual void
+    TearDown()
+    {
+        mraa_spi_stop(dev);
+    }
+
+    mraa_spi_context dev;
+};
+
+/* 32 bit word transfers reach the platform as whole words */
+TEST_F(mraa_spi_h_unit, test_transfer_buf_word32)
+{
+    uint32_t tx[5] = { 0x00000000, 0xFFFFFFFF, 0x12345678, 0xDEADBEEF, 0x00010002 };
+    uint32_t rx[5] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_bit_per_word(dev, 32));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf_word32(dev, tx, rx, sizeof(tx)));
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(tx[i] ^ MOCK_SPI_REPLY_DATA_MODIFIER_WORD32, rx[i]);
+    }
+}
+
+/* The mock controller lacks lsb first, bytes get reversed in software */
+TEST_F(mraa_spi_h_unit, test_soft_lsb_bytes)
+{
+    uint8_t tx[29];
+    uint8_t rx[29];
+    uint8_t expect = (uint8_t) reverse_bits(MOCK_SPI_REPLY_DATA_MODIFIER_BYTE, 8);
+
+    for (int i = 0; i < (int) sizeof(tx); i++) {
+        tx[i] = (uint8_t) (i * 37 + 5);
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_lsbmode(dev, 1));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(dev, tx, rx, sizeof(tx)));
+    for (int i = 0; i < (int) sizeof(tx); i++) {
+        /* tx buffer must be left untouched */
+        ASSERT_EQ((uint8_t) (i * 37 + 5), tx[i]);
+        ASSERT_EQ(tx[i] ^ expect, rx[i]);
+    }
+    ASSERT_EQ(0x12 ^ expect, mraa_spi_write(dev, 0x12));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_lsbmode(dev, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(dev, tx, rx, sizeof(tx)));
+    for (int i = 0; i < (int) sizeof(tx); i++) {
+        ASSERT_EQ(tx[i] ^ MOCK_SPI_REPLY_DATA_MODIFIER_BYTE, rx[i]);
+    }
+}
+
+/* Words narrower than their container are reversed within their width */
+TEST_F(mraa_spi_h_unit, test_soft_lsb_words)
+{
+    uint16_t tx16[11];
+    uint16_t rx16[11];
+    uint32_t tx32[7];
+    uint32_t rx32[7];
+
+    for (int i = 0; i < 11; i++) {
+        tx16[i] = (uint16_t) ((i * 0x1357) & 0x0FFF);
+    }
+    for (int i = 0; i < 7; i++) {
+        tx32[i] = (uint32_t) (i * 0x01234567UL) & 0x00FFFFFF;
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_lsbmode(dev, 1));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_bit_per_word(dev, 16));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf_word(dev, tx16, rx16, sizeof(tx16)));
+    for (int i = 0; i < 11; i++) {
+        ASSERT_EQ(tx16[i] ^ reverse_bits(MOCK_SPI_REPLY_DATA_MODIFIER_WORD, 16), rx16[i]);
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_bit_per_word(dev, 12));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf_word(dev, tx16, rx16, sizeof(tx16)));
+    for (int i = 0; i < 11; i++) {
+        ASSERT_EQ(tx16[i] ^ reverse_bits(MOCK_SPI_REPLY_DATA_MODIFIER_WORD & 0x0FFF, 12), rx16[i]);
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_bit_per_word(dev, 24));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf_word32(dev, tx32, rx32, sizeof(tx32)));
+    for (int i = 0; i < 7; i++) {
+        ASSERT_EQ(tx32[i] ^ reverse_bits(MOCK_SPI_REPLY_DATA_MODIFIER_WORD32 & 0x00FFFFFF, 24), rx32[i]);
+    }
+}
+
+/* Quad requests are stepped down to what the controller grants */
+TEST_F(mraa_spi_h_unit, test_buswidth_degrade)
+{
+    mraa_spi_buswidth_t tx, rx;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_get_buswidth(dev, &tx, &rx));
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_SINGLE, tx);
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_SINGLE, rx);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_buswidth(dev, MRAA_SPI_BUSWIDTH_SINGLE, MRAA_SPI_BUSWIDTH_QUAD));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_get_buswidth(dev, &tx, &rx));
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_SINGLE, tx);
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_DUAL, rx);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_buswidth(dev, (mraa_spi_buswidth_t) 3, MRAA_SPI_BUSWIDTH_SINGLE));
+}
+
+/* A command segment followed by a wide read segment in one message */
+TEST_F(mraa_spi_h_unit, test_transfer_segments)
+{
+    /* Segmented transfers go to the emulated flash, a dual output read has
+     * to return the same data as a plain single width read */
+    uint8_t read_cmd[4] = { 0x03, 0x00, 0x10, 0x00 };
+    uint8_t dual_cmd[5] = { 0x3B, 0x00, 0x10, 0x00, 0x00 };
+    uint8_t expected[16];
+    uint8_t data[16];
+    mraa_spi_segment_t segs[2];
+
+    memset(segs, 0, sizeof(segs));
+    segs[0].txbuf = read_cmd;
+    segs[0].length = sizeof(read_cmd);
+    segs[1].rxbuf = expected;
+    segs[1].length = sizeof(expected);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_segments(dev, segs, 2));
+
+    segs[0].txbuf = dual_cmd;
+    segs[0].length = sizeof(dual_cmd);
+    segs[1].rxbuf = data;
+    segs[1].rx_width = MRAA_SPI_BUSWIDTH_DUAL;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_buswidth(dev, MRAA_SPI_BUSWIDTH_SINGLE, MRAA_SPI_BUSWIDTH_DUAL));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_segments(dev, segs, 2));
+    ASSERT_EQ(0, memcmp(expected, data, sizeof(data)));
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_segments(dev, segs, 0));
+}
+
+/* Mock bus 1 is bit-banged over gpios with mosi looped back to miso */
+TEST(mraa_spi_h_soft, test_soft_loopback)
+{
+    mraa_spi_context soft = mraa_spi_init(1);
+    ASSERT_TRUE(soft != NULL);
+
+    uint8_t tx[8] = { 0x00, 0xFF, 0xA5, 0x5A, 0x01, 0x80, 0x3C, 0xC3 };
+    uint8_t rx[8];
+    for (int mode = MRAA_SPI_MODE0; mode <= MRAA_SPI_MODE3; mode++) {
+        memset(rx, 0, sizeof(rx));
+        ASSERT_EQ(MRAA_SUCCESS, mraa_spi_mode(soft, (mraa_spi_mode_t) mode));
+        ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(soft, tx, rx, sizeof(tx)));
+        ASSERT_EQ(0, memcmp(tx, rx, sizeof(tx)));
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_lsbmode(soft, 1));
+    ASSERT_EQ(0x35, mraa_spi_write(soft, 0x35));
+
+    uint16_t txw[3] = { 0x0ABC, 0x0123, 0x0FFF }, rxw[3];
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_bit_per_word(soft, 12));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf_word(soft, txw, rxw, sizeof(txw)));
+    ASSERT_EQ(0, memcmp(txw, rxw, sizeof(txw)));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_stop(soft));
+}
+
+TEST(mraa_spi_h_soft, test_soft_clock)
+{
+    mraa_spi_context soft = mraa_spi_init(1);
+    ASSERT_TRUE(soft != NULL);
+
+    /* the achieved clock is measured and never exceeds the requested one */
+    uint8_t tx[16] = { 0 };
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_frequency(soft, 50000));
+    ASSERT_EQ(50000, mraa_spi_get_frequency(soft));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(soft, tx, NULL, sizeof(tx)));
+    int hz = mraa_spi_get_frequency(soft);
+    ASSERT_GT(hz, 0);
+    ASSERT_LE(hz, 50000);
+
+    mraa_spi_buswidth_t txw, rxw;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_buswidth(soft, MRAA_SPI_BUSWIDTH_QUAD, MRAA_SPI_BUSWIDTH_QUAD));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_get_buswidth(soft, &txw, &rxw));
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_SINGLE, txw);
+    ASSERT_EQ(MRAA_SPI_BUSWIDTH_SINGLE, rxw);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_stop(soft));
+}
+
+TEST_F(mraa_spi_h_unit, test_stats)
+{
+    mraa_spi_stats_t stats;
+    uint8_t buf[64] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_reset_stats(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_frequency(dev, 1000000));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_transfer_buf(dev, buf, buf, sizeof(buf)));
+    ASSERT_EQ(MOCK_SPI_REPLY_DATA_MODIFIER_BYTE, mraa_spi_write(dev, 0x00));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_spi_transfer_buf(dev, buf, buf, 0));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_get_stats(dev, &stats));
+    ASSERT_EQ(2u, stats.transfers);
+    ASSERT_EQ(1u, stats.errors);
+    ASSERT_EQ(sizeof(buf) + 1, stats.bytes);
+    /* 65 bytes at 1MHz */
+    ASSERT_EQ(520000u, stats.wire_ns);
+    ASSERT_LE(stats.max_latency_ns, stats.busy_ns);
+    ASSERT_GT(stats.elapsed_ns, 0u);
+    ASSERT_GT(stats.utilisation, 0.0f);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_reset_stats(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_spi_get_stats(dev, &stats));
+    ASSERT_EQ(0u, stats.transfers);
+    ASSERT_EQ(0u, stats.bytes);
+    ASSERT_EQ(MRAA_ERROR_INVALID_HANDLE, mraa_spi_get_stats(dev, NULL));
+}
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mraa/uart.h"
+#include "mraa/uart_group.h"
+
+#define PORTS 16
+
+/* A group of UARTs over pseudo terminals */
+class mraa_uart_group_h : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_uart_group_h() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_uart_group_h() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            group = NULL;
+            if (mraa_get_platform_type() == MRAA_MOCK_PLATFORM) {
+                GTEST_SKIP() << "uart functions are replaced on the mock platform";
+            }
+            group = mraa_uart_group_init();
+            ASSERT_TRUE(group != NULL);
+            for (int i = 0; i < PORTS; i++) {
+                master[i] = posix_openpt(O_RDWR | O_NOCTTY);
+                ASSERT_GE(master[i], 0);
+                ASSERT_EQ(0, grantpt(master[i]));
+                ASSERT_EQ(0, unlockpt(master[i]));
+                dev[i] = mraa_uart_init_raw(ptsname(master[i]));
+                ASSERT_TRUE(dev[i] != NULL);
+            }
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            if (group == NULL) {
+                return;
+            }
+            mraa_uart_group_stop(group);
+            for (int i = 0; i < PORTS; i++) {
+                mraa_uart_stop(dev[i]);
+                close(master[i]);
+            }
+        }
+
+        /* Wait until cond holds, up to a second */
+        template <typename Cond>
+        bool wait_for(Cond cond)
+        {
+            for (int i = 0; i < 1000; i++) {
+                if (cond()) {
+                    return true;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            return cond();
+        }
+
+        mraa_uart_group_context group;
+        int master[PORTS];
+        mraa_uart_context dev[PORTS];
+};
+
+struct received {
+    std::mutex lock;
+    std::string data[PORTS];
+    mraa_uart_context* devs;
+    mraa_uart_group_context group;
+};
+
+/* Records the data and echoes it back from the group thread */
+static void
+echo_callback(mraa_uart_context dev, const char* data, int length, void* args)
+{
+    struct received* rx = (struct received*) args;
+    std::lock_guard<std::mutex> guard(rx->lock);
+    for (int i = 0; i < PORTS; i++) {
+        if (rx->devs[i] == dev) {
+            rx->data[i].append(data, length);
+        }
+    }
+    mraa_uart_group_write(rx->group, dev, data, length);
+}
+
+static std::string
+master_read(int master, size_t length)
+{
+    std::string got;
+    char buf[256];
+    struct pollfd pfd = { master, POLLIN, 0 };
+
+    while (got.size() < length && poll(&pfd, 1, 1000) > 0) {
+        ssize_t n = read(master, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        got.append(buf, n);
+    }
+    return got;
+}
+
+/* All ports are served by the one thread */
+TEST_F(mraa_uart_group_h, test_many_ports)
+{
+    struct received rx;
+    rx.devs = dev;
+    rx.group = group;
+
+    for (int i = 0; i < PORTS; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_add(group, dev[i], echo_callback, &rx, 0));
+    }
+    ASSERT_EQ(PORTS, mraa_uart_group_get_count(group));
+
+    for (int i = 0; i < PORTS; i++) {
+        std::string msg = "port" + std::to_string(i);
+        ASSERT_EQ((ssize_t) msg.size(), write(master[i], msg.data(), msg.size()));
+    }
+    for (int i = 0; i < PORTS; i++) {
+        std::string msg = "port" + std::to_string(i);
+        ASSERT_EQ(msg, master_read(master[i], msg.size()));
+        std::lock_guard<std::mutex> guard(rx.lock);
+        ASSERT_EQ(msg, rx.data[i]);
+    }
+
+    mraa_uart_group_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_get_stats(group, dev[3], &stats));
+    ASSERT_EQ(5u, stats.rx_bytes);
+    ASSERT_EQ(5u, stats.tx_bytes);
+    ASSERT_EQ(0u, stats.tx_overflows);
+    ASSERT_EQ(0u, stats.tx_queued);
+}
+
+static void
+ignore_callback(mraa_uart_context dev, const char* data, int length, void* args)
+{
+}
+
+/* What a stalled port can't take is queued, then dropped and counted */
+TEST_F(mraa_uart_group_h, test_queue_overflow)
+{
+    mraa_uart_group_stats_t stats;
+    std::string chunk(4096, 'q');
+    size_t accepted = 0;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_add(group, dev[0], ignore_callback, NULL, 64));
+
+    /* nobody reads the master, the pty fills up */
+    int n;
+    for (int i = 0; i < 1024; i++) {
+        n = mraa_uart_group_write(group, dev[0], chunk.data(), chunk.size());
+        ASSERT_GE(n, 0);
+        accepted += n;
+        if ((size_t) n < chunk.size()) {
+            break;
+        }
+    }
+    ASSERT_LT((size_t) n, chunk.size());
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_get_stats(group, dev[0], &stats));
+    ASSERT_EQ(64u, stats.tx_queued);
+    ASSERT_EQ(chunk.size() - n, stats.tx_overflows);
+    ASSERT_EQ(accepted, stats.tx_bytes + stats.tx_queued);
+
+    /* draining the master lets the thread send the queue */
+    size_t got = master_read(master[0], accepted).size();
+    ASSERT_EQ(accepted, got);
+    ASSERT_TRUE(wait_for([&] {
+        mraa_uart_group_get_stats(group, dev[0], &stats);
+        return stats.tx_queued == 0;
+    }));
+    ASSERT_EQ(accepted, stats.tx_bytes);
+}
+
+static void
+rx_callback(const char* data, int length, void* args)
+{
+}
+
+TEST_F(mraa_uart_group_h, test_add_remove)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_add(group, dev[0], ignore_callback, NULL, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_add(group, dev[1], ignore_callback, NULL, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_uart_group_add(group, dev[0], ignore_callback, NULL, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_RESOURCE, mraa_uart_set_rx_callback(dev[0], rx_callback, NULL, 1, 0));
+    ASSERT_EQ(2, mraa_uart_group_get_count(group));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_remove(group, dev[0]));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_group_remove(group, dev[0]));
+    ASSERT_EQ(-1, mraa_uart_group_write(group, dev[0], "x", 1));
+    ASSERT_EQ(1, mraa_uart_group_get_count(group));
+
+    /* stopping a port takes it out of its group */
+    mraa_uart_stop(dev[1]);
+    ASSERT_EQ(0, mraa_uart_group_get_count(group));
+    dev[1] = mraa_uart_init_raw(ptsname(master[1]));
+    ASSERT_TRUE(dev[1] != NULL);
+}
+
+/* A port whose far end goes away is dropped from polling */
+TEST_F(mraa_uart_group_h, test_hangup)
+{
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_add(group, dev[0], ignore_callback, NULL, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_group_add(group, dev[1], ignore_callback, NULL, 0));
+    close(master[0]);
+    master[0] = open("/dev/null", O_RDWR);
+
+    ASSERT_TRUE(wait_for([&] { return mraa_uart_group_write(group, dev[0], "x", 1) < 0; }));
+    ASSERT_EQ(1, mraa_uart_group_write(group, dev[1], "x", 1));
+    ASSERT_EQ("x", master_read(master[1], 1));
+}
@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mraa/uart.h"
+#include "mraa/uart.hpp"
+#include "mraa/gpio.h"
+
+/* UART over a pseudo terminal, the pty slave stands in for a real tty */
+class mraa_uart_h_pty : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_uart_h_pty() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_uart_h_pty() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            dev = NULL;
+            master = -1;
+            if (mraa_get_platform_type() == MRAA_MOCK_PLATFORM) {
+                GTEST_SKIP() << "uart functions are replaced on the mock platform";
+            }
+            master = posix_openpt(O_RDWR | O_NOCTTY);
+            ASSERT_GE(master, 0);
+            ASSERT_EQ(0, grantpt(master));
+            ASSERT_EQ(0, unlockpt(master));
+            path = ptsname(master);
+            ASSERT_TRUE(path != NULL);
+            dev = mraa_uart_init_raw(path);
+            ASSERT_TRUE(dev != NULL);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            if (dev != NULL) {
+                mraa_uart_stop(dev);
+            }
+            if (master >= 0) {
+                close(master);
+            }
+        }
+
+        int master;
+        const char* path;
+        mraa_uart_context dev;
+};
+
+/* init_raw sets 9600 */
+TEST_F(mraa_uart_h_pty, test_default_baudrate)
+{
+    ASSERT_EQ(9600, mraa_uart_get_baudrate(dev));
+}
+
+/* Rates outside the B* table go through termios2 and read back */
+TEST_F(mraa_uart_h_pty, test_arbitrary_baudrate)
+{
+    int baud = 0;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 250000));
+    ASSERT_EQ(250000, mraa_uart_get_baudrate(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_settings(-1, &path, NULL, &baud, NULL, NULL, NULL, NULL, NULL));
+    ASSERT_EQ(250000, baud);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 31250));
+    ASSERT_EQ(31250, mraa_uart_get_baudrate(dev));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 115200));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_settings(-1, &path, NULL, &baud, NULL, NULL, NULL, NULL, NULL));
+    ASSERT_EQ(115200, baud);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_set_baudrate(dev, 0));
+}
+
+/* Data still passes after a rate change */
+TEST_F(mraa_uart_h_pty, test_loopback)
+{
+    char buf[8] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 1234567));
+    ASSERT_EQ(4, write(master, "mraa", 4));
+    ASSERT_EQ(1, mraa_uart_data_available(dev, 1000));
+    ASSERT_EQ(4, mraa_uart_read(dev, buf, sizeof(buf)));
+    ASSERT_STREQ("mraa", buf);
+}
+
+/* Lines split over several writes come back whole, empty lines included */
+TEST_F(mraa_uart_h_pty, test_frame_delimiter)
+{
+    mraa_uart_frame_config_t config = { MRAA_UART_FRAME_DELIMITER, 0, '\n', 0, 0 };
+    mraa_uart_frame_t frame;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_framing(dev, &config));
+    ASSERT_EQ(MRAA_ERROR_NO_DATA_AVAILABLE, mraa_uart_read_frame(dev, &frame, 0));
+
+    ASSERT_EQ(7, write(master, "hello\nw", 7));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(5, frame.length);
+    ASSERT_EQ(0, memcmp("hello", frame.data, 5));
+    ASSERT_EQ(MRAA_ERROR_NO_DATA_AVAILABLE, mraa_uart_read_frame(dev, &frame, 10));
+
+    ASSERT_EQ(6, write(master, "orld\n\n", 6));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(5, frame.length);
+    ASSERT_EQ(0, memcmp("world", frame.data, 5));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(0, frame.length);
+    ASSERT_EQ(0, mraa_uart_get_frame_errors(dev));
+}
+
+/* Fixed length frames, and a buffer small enough to wrap many times */
+TEST_F(mraa_uart_h_pty, test_frame_fixed)
+{
+    mraa_uart_frame_config_t config = { MRAA_UART_FRAME_FIXED, 10, 0, 3, 0 };
+    mraa_uart_frame_t frame;
+    int i;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_framing(dev, &config));
+    for (i = 0; i < 20; i++) {
+        char msg[3] = { (char) i, (char) (i + 1), (char) (i + 2) };
+        ASSERT_EQ(3, write(master, msg, 3));
+    }
+    for (i = 0; i < 20; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+        ASSERT_EQ(3, frame.length);
+        ASSERT_EQ(i, frame.data[0]);
+        ASSERT_EQ(i + 2, frame.data[2]);
+    }
+}
+
+/* Big endian 2 byte length prefix */
+TEST_F(mraa_uart_h_pty, test_frame_length_prefix)
+{
+    mraa_uart_frame_config_t config = { MRAA_UART_FRAME_LENGTH_PREFIX, 0, 0, 2, 1 };
+    mraa_uart_frame_t frame;
+    const char stream[] = { 0, 3, 'a', 'b', 'c', 0, 0, 0, 1, 'd' };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_framing(dev, &config));
+    ASSERT_EQ(sizeof(stream), write(master, stream, sizeof(stream)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(3, frame.length);
+    ASSERT_EQ(0, memcmp("abc", frame.data, 3));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(0, frame.length);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(1, frame.length);
+    ASSERT_EQ('d', frame.data[0]);
+}
+
+/* SLIP escapes are decoded, a broken escape drops only its frame */
+TEST_F(mraa_uart_h_pty, test_frame_slip)
+{
+    mraa_uart_frame_config_t config = { MRAA_UART_FRAME_SLIP, 0, 0, 0, 0 };
+    mraa_uart_frame_t frame;
+    const unsigned char stream[] = { 0xC0, 0x01, 0xDB, 0xDC, 0xDB, 0xDD, 0x02, 0xC0,
+                                     0xDB, 0x00, 0xC0, 0x03, 0xC0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_framing(dev, &config));
+    ASSERT_EQ(sizeof(stream), write(master, stream, sizeof(stream)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(4, frame.length);
+    ASSERT_EQ(0x01, frame.data[0]);
+    ASSERT_EQ(0xC0, frame.data[1]);
+    ASSERT_EQ(0xDB, frame.data[2]);
+    ASSERT_EQ(0x02, frame.data[3]);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(1, frame.length);
+    ASSERT_EQ(0x03, frame.data[0]);
+    ASSERT_EQ(1, mraa_uart_get_frame_errors(dev));
+}
+
+/* COBS with zeros inside the payload */
+TEST_F(mraa_uart_h_pty, test_frame_cobs)
+{
+    mraa_uart_frame_config_t config = { MRAA_UART_FRAME_COBS, 0, 0, 0, 0 };
+    mraa_uart_frame_t frame;
+    const unsigned char stream[] = { 0x03, 0x11, 0x22, 0x02, 0x33, 0x00, 0x01, 0x01, 0x00 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_framing(dev, &config));
+    ASSERT_EQ(sizeof(stream), write(master, stream, sizeof(stream)));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(4, frame.length);
+    ASSERT_EQ(0x11, frame.data[0]);
+    ASSERT_EQ(0x22, frame.data[1]);
+    ASSERT_EQ(0x00, frame.data[2]);
+    ASSERT_EQ(0x33, frame.data[3]);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(1, frame.length);
+    ASSERT_EQ(0x00, frame.data[0]);
+}
+
+/* A line longer than the buffer is dropped up to its delimiter */
+TEST_F(mraa_uart_h_pty, test_frame_overflow)
+{
+    mraa_uart_frame_config_t config = { MRAA_UART_FRAME_DELIMITER, 8, '\n', 0, 0 };
+    mraa_uart_frame_t frame;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_framing(dev, &config));
+    ASSERT_EQ(23, write(master, "0123456789abcdef\nshort\n", 23));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_read_frame(dev, &frame, 1000));
+    ASSERT_EQ(5, frame.length);
+    ASSERT_EQ(0, memcmp("short", frame.data, 5));
+    ASSERT_EQ(1, mraa_uart_get_frame_errors(dev));
+}
+
+/* poll based data_available copes with fd numbers select can't take */
+TEST_F(mraa_uart_h_pty, test_data_available_high_fd)
+{
+    struct rlimit lim;
+    std::vector<int> fillers;
+    int fd;
+
+    ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &lim));
+    if (lim.rlim_max != RLIM_INFINITY && lim.rlim_max < FD_SETSIZE + 8) {
+        GTEST_SKIP() << "fd limit too low";
+    }
+    if (lim.rlim_cur < FD_SETSIZE + 8) {
+        lim.rlim_cur = FD_SETSIZE + 8;
+        ASSERT_EQ(0, setrlimit(RLIMIT_NOFILE, &lim));
+    }
+    while ((fd = dup(master)) >= 0 && fd < FD_SETSIZE) {
+        fillers.push_back(fd);
+    }
+    ASSERT_GE(fd, FD_SETSIZE);
+    close(fd);
+
+    mraa_uart_context high = mraa_uart_init_raw(path);
+    for (size_t i = 0; i < fillers.size(); i++) {
+        close(fillers[i]);
+    }
+    ASSERT_TRUE(high != NULL);
+
+    ASSERT_EQ(0, mraa_uart_data_available(high, 0));
+    ASSERT_EQ(1, write(master, "x", 1));
+    ASSERT_EQ(1, mraa_uart_data_available(high, 1000));
+    mraa_uart_stop(high);
+}
+
+struct rx_capture {
+    std::mutex lock;
+    std::vector<std::string> chunks;
+};
+
+static void
+rx_collect(const char* data, int length, void* args)
+{
+    rx_capture* cap = (rx_capture*) args;
+    std::lock_guard<std::mutex> guard(cap->lock);
+    cap->chunks.push_back(std::string(data, length));
+}
+
+static size_t
+rx_wait(rx_capture& cap, size_t count)
+{
+    for (int i = 0; i < 200; i++) {
+        {
+            std::lock_guard<std::mutex> guard(cap.lock);
+            if (cap.chunks.size() >= count) {
+                return cap.chunks.size();
+            }
+        }
+        usleep(5000);
+    }
+    std::lock_guard<std::mutex> guard(cap.lock);
+    return cap.chunks.size();
+}
+
+/* Chunks come once min_chunk bytes are in, or after idle_ms */
+TEST_F(mraa_uart_h_pty, test_rx_callback)
+{
+    rx_capture cap;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_rx_callback(dev, rx_collect, &cap, 8, 50));
+
+    ASSERT_EQ(8, write(master, "abcdefgh", 8));
+    ASSERT_EQ(1, rx_wait(cap, 1));
+    ASSERT_EQ("abcdefgh", cap.chunks[0]);
+
+    ASSERT_EQ(3, write(master, "xyz", 3));
+    usleep(10000);
+    {
+        std::lock_guard<std::mutex> guard(cap.lock);
+        ASSERT_EQ(1, cap.chunks.size());
+    }
+    ASSERT_EQ(2, rx_wait(cap, 2));
+    ASSERT_EQ("xyz", cap.chunks[1]);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_rx_callback(dev, NULL, NULL, 0, 0));
+    ASSERT_EQ(2, write(master, "no", 2));
+    usleep(100000);
+    ASSERT_EQ(2, rx_wait(cap, 3));
+    ASSERT_EQ(1, mraa_uart_data_available(dev, 0));
+}
+
+static int64_t
+elapsed_ms(const struct timespec& start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000;
+}
+
+/* A read with nothing coming returns after the read timeout */
+TEST_F(mraa_uart_h_pty, test_read_timeout)
+{
+    char buf[8];
+    struct timespec start;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 30, 0, 0));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    ASSERT_EQ(0, mraa_uart_read(dev, buf, sizeof(buf)));
+    ASSERT_GE(elapsed_ms(start), 29);
+    ASSERT_LT(elapsed_ms(start), 500);
+
+    ASSERT_EQ(2, write(master, "ok", 2));
+    ASSERT_EQ(2, mraa_uart_read(dev, buf, sizeof(buf)));
+}
+
+/* The interchar gap collects a reply written in pieces */
+TEST_F(mraa_uart_h_pty, test_interchar_timeout)
+{
+    char buf[16] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 1000, 0, 40));
+    ASSERT_EQ(3, write(master, "abc", 3));
+    std::thread later([this]() {
+        usleep(5000);
+        ASSERT_EQ(3, write(master, "def", 3));
+    });
+    ASSERT_EQ(6, mraa_uart_read(dev, buf, sizeof(buf)));
+    later.join();
+    ASSERT_STREQ("abcdef", buf);
+}
+
+/* A reply that takes longer than the read timeout is not cut off */
+TEST_F(mraa_uart_h_pty, test_read_longer_than_timeout)
+{
+    char buf[32] = { 0 };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 30, 0, 40));
+    std::thread writer([this]() {
+        for (int i = 0; i < 10; i++) {
+            ASSERT_EQ(2, write(master, "ab", 2));
+            usleep(10000);
+        }
+    });
+    ASSERT_EQ(20, mraa_uart_read(dev, buf, sizeof(buf)));
+    writer.join();
+    ASSERT_STREQ("abababababababababab", buf);
+}
+
+/* A write nobody drains stops at the write timeout */
+TEST_F(mraa_uart_h_pty, test_write_timeout)
+{
+    std::vector<char> big(1 << 20, 'x');
+    struct timespec start;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 0, 30, 0));
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int sent = mraa_uart_write(dev, big.data(), big.size());
+    ASSERT_GT(sent, 0);
+    ASSERT_LT(sent, (int) big.size());
+    ASSERT_GE(elapsed_ms(start), 29);
+    ASSERT_LT(elapsed_ms(start), 500);
+}
+
+/* VMIN makes a read wait for that many bytes */
+TEST_F(mraa_uart_h_pty, test_vmin_vtime)
+{
+    char buf[8];
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_set_vmin_vtime(dev, 256, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_vmin_vtime(dev, 4, 0));
+    ASSERT_EQ(2, write(master, "ab", 2));
+    std::thread later([this]() {
+        usleep(10000);
+        ASSERT_EQ(2, write(master, "cd", 2));
+    });
+    ASSERT_EQ(4, mraa_uart_read(dev, buf, sizeof(buf)));
+    later.join();
+}
+
+/* A pty has no rs485 support and there is no DE pin to fall back to */
+TEST_F(mraa_uart_h_pty, test_rs485_unsupported)
+{
+    mraa_uart_rs485_config_t config = { 0, 0, 0, 0, -1 };
+
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_uart_set_rs485(dev, &config));
+    ASSERT_EQ(MRAA_UART_RS485_OFF, mraa_uart_get_rs485_mode(dev));
+}
+
+/* ptys have no serial_struct and no receive FIFO */
+TEST_F(mraa_uart_h_pty, test_low_latency_unsupported)
+{
+    ASSERT_EQ(MRAA_ERROR_FEATURE_NOT_SUPPORTED, mraa_uart_set_low_latency(dev, 1, 1));
+    ASSERT_EQ(-1, mraa_uart_get_rx_trigger(dev));
+}
+
+/* Collect what arrives on the pty master within ms */
+static std::string
+master_read(int master, int ms)
+{
+    std::string got;
+    char buf[256];
+    struct pollfd pfd = { master, POLLIN, 0 };
+
+    while (poll(&pfd, 1, ms) > 0) {
+        ssize_t n = read(master, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        got.append(buf, n);
+        ms = 10;
+    }
+    return got;
+}
+
+TEST_F(mraa_uart_h_pty, test_writev)
+{
+    struct iovec iov[3] = { { (void*) "head", 4 }, { (void*) "", 0 }, { (void*) "payload", 7 } };
+
+    ASSERT_EQ(11, mraa_uart_writev(dev, iov, 3));
+    ASSERT_EQ("headpayload", master_read(master, 1000));
+    ASSERT_EQ(0, mraa_uart_writev(dev, NULL, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_writev(dev, iov, -1));
+
+    /* the timed write path steps through the buffers itself */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 0, 500, 0));
+    ASSERT_EQ(11, mraa_uart_writev(dev, iov, 3));
+    ASSERT_EQ("headpayload", master_read(master, 1000));
+}
+
+TEST_F(mraa_uart_h_pty, test_writev_span)
+{
+    mraa::Uart uart(path);
+    std::string header("\x02len");
+    std::vector<uint8_t> payload = { 'a', 'b', 'c' };
+    uint16_t crc = 0x4241;
+
+    ASSERT_EQ(9, uart.writev({ header, payload, mraa::Uart::Span(&crc, sizeof(crc)) }));
+    ASSERT_EQ("\x02lenabcAB", master_read(master, 1000));
+}
+
+/* Small writes wait until the threshold, a flush or the delay */
+TEST_F(mraa_uart_h_pty, test_write_coalescing)
+{
+    struct iovec iov[2] = { { (void*) "0123", 4 }, { (void*) "456789", 6 } };
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_write_coalescing(dev, 16, 0));
+    ASSERT_EQ(5, mraa_uart_write(dev, "hello", 5));
+    ASSERT_EQ(1, mraa_uart_write(dev, " ", 1));
+    ASSERT_EQ("", master_read(master, 20));
+
+    /* this one reaches the threshold and goes out with the buffer */
+    ASSERT_EQ(10, mraa_uart_writev(dev, iov, 2));
+    ASSERT_EQ("hello 0123456789", master_read(master, 1000));
+
+    ASSERT_EQ(3, mraa_uart_write(dev, "abc", 3));
+    ASSERT_EQ("", master_read(master, 20));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(dev));
+    ASSERT_EQ("abc", master_read(master, 1000));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_write_coalescing(dev, 64, 30));
+    ASSERT_EQ(3, mraa_uart_write(dev, "def", 3));
+    ASSERT_EQ("def", master_read(master, 1000));
+
+    /* turning it off sends what is left */
+    ASSERT_EQ(3, mraa_uart_write(dev, "ghi", 3));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_write_coalescing(dev, 0, 0));
+    ASSERT_EQ("ghi", master_read(master, 1000));
+}
+
+/* A full iovec array behind buffered bytes still goes out */
+TEST_F(mraa_uart_h_pty, test_write_coalescing_iov_max)
+{
+    std::vector<struct iovec> iov(1024);
+    for (size_t i = 0; i < iov.size(); i++) {
+        iov[i].iov_base = (void*) "x";
+        iov[i].iov_len = 1;
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 0, 500, 0));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_write_coalescing(dev, 16, 0));
+    ASSERT_EQ(3, mraa_uart_write(dev, "abc", 3));
+    ASSERT_EQ(1024, mraa_uart_writev(dev, iov.data(), (int) iov.size()));
+    ASSERT_EQ("abc" + std::string(1024, 'x'), master_read(master, 1000));
+}
+
+/* UART 0 of the mock platform, which declares GPIO0 as its DE pin */
+class mraa_uart_h_mock : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_uart_h_mock() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_uart_h_mock() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            dev = NULL;
+            if (mraa_get_platform_type() != MRAA_MOCK_PLATFORM) {
+                GTEST_SKIP() << "needs the mock platform";
+            }
+            dev = mraa_uart_init(0);
+            ASSERT_TRUE(dev != NULL);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            if (dev != NULL) {
+                mraa_uart_stop(dev);
+            }
+        }
+
+        mraa_uart_context dev;
+};
+
+/* Without kernel support the platform DE gpio is driven, idle is receive */
+TEST_F(mraa_uart_h_mock, test_rs485_gpio)
+{
+    mraa_uart_rs485_config_t config = { 0, 0, 10, 10, -1 };
+    mraa_gpio_context de = mraa_gpio_init(0);
+    ASSERT_TRUE(de != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_gpio_dir(de, MRAA_GPIO_IN));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_rs485(dev, &config));
+    ASSERT_EQ(MRAA_UART_RS485_GPIO, mraa_uart_get_rs485_mode(dev));
+    ASSERT_EQ(0, mraa_gpio_read(de));
+    ASSERT_EQ(4, mraa_uart_write(dev, "mraa", 4));
+    ASSERT_EQ(0, mraa_gpio_read(de));
+
+    config.de_active_low = 1;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_rs485(dev, &config));
+    ASSERT_EQ(1, mraa_gpio_read(de));
+    ASSERT_EQ(4, mraa_uart_write(dev, "mraa", 4));
+    ASSERT_EQ(1, mraa_gpio_read(de));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_rs485(dev, NULL));
+    ASSERT_EQ(MRAA_UART_RS485_OFF, mraa_uart_get_rs485_mode(dev));
+    mraa_gpio_close(de);
+}
+
+/* The mock line loops what is written back */
+TEST_F(mraa_uart_h_mock, test_writev)
+{
+    struct iovec iov[2] = { { (void*) "mr", 2 }, { (void*) "aa", 2 } };
+    char buf[4];
+
+    ASSERT_EQ(4, mraa_uart_writev(dev, iov, 2));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 1000, 0, 50));
+    ASSERT_EQ(4, mraa_uart_read(dev, buf, sizeof(buf)));
+    ASSERT_EQ(0, memcmp(buf, "mraa", 4));
+}
@@ -0,0 +1,706 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mraa/uart_ow.h"
+
+/* A DS18B20 on the simulated bus */
+struct ow_device {
+    uint8_t rom[MRAA_UART_OW_ROMCODE_SIZE];
+    uint8_t scratchpad[9];
+    bool active;
+    bool overdrive;
+    std::chrono::steady_clock::time_point busy_until; /**< end of the running conversion */
+};
+
+/* How long the simulated devices take to convert */
+#define CONVERSION_MS 100
+
+/* The far side of a pty standing in for a 1-wire bus behind a uart. Every
+ * byte the uart sends is a bit slot, or a reset pulse at 9600 baud, and
+ * the echo is what the devices on the bus make of it. */
+class ow_bus
+{
+  public:
+    ow_bus(int master) : master(master), stop(false), bursts(0), conversions(0), speed_errors(0), overdrive_slots(0)
+    {
+        thread = std::thread(&ow_bus::run, this);
+    }
+
+    ~ow_bus()
+    {
+        stop = true;
+        thread.join();
+    }
+
+    /* The device reads serial degrees once converted, 85 before */
+    void
+    add_device(uint8_t serial, bool bad_crc = false, uint8_t family = 0x28)
+    {
+        ow_device device;
+        uint8_t rom[MRAA_UART_OW_ROMCODE_SIZE] = { family, serial, 0x5a, serial, 0x00, 0x01, 0x00, 0x00 };
+        rom[7] = mraa_uart_ow_crc8(rom, 7);
+        memcpy(device.rom, rom, sizeof(rom));
+        uint8_t scratchpad[8] = { 0x50, 0x05, 0x4b, 0x46, 0x7f, 0xff, 0x0c, 0x10 };
+        memcpy(device.scratchpad, scratchpad, sizeof(scratchpad));
+        device.scratchpad[8] = mraa_uart_ow_crc8(device.scratchpad, 8) ^ (bad_crc ? 1 : 0);
+        device.active = false;
+        device.overdrive = false;
+        device.busy_until = std::chrono::steady_clock::now();
+        this->serial[device.rom[1]] = serial;
+        std::lock_guard<std::mutex> guard(lock);
+        devices.push_back(device);
+    }
+
+    void
+    remove_device(uint8_t serial)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (auto it = devices.begin(); it != devices.end(); ++it) {
+            if (it->rom[1] == serial) {
+                devices.erase(it);
+                return;
+            }
+        }
+    }
+
+    /* Let after search rom commands through, then leave the next one
+     * unanswered */
+    void
+    silence_search(int after)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        silent_search = after;
+    }
+
+    std::vector<ow_device>
+    get_devices()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return devices;
+    }
+
+    int master;
+    std::atomic<bool> stop;
+    std::atomic<int> bursts; /**< reads that brought bit slots */
+    std::atomic<int> conversions; /**< convert T commands seen */
+    std::atomic<int> speed_errors; /**< resets and slots selected devices couldn't follow */
+    std::atomic<int> overdrive_slots; /**< bit slots at overdrive speed */
+
+  private:
+    enum state { ROM_CMD, READ_ROM, MATCH_ROM, SEARCH_ROM, FUNCTION, READ_SCRATCHPAD, CONVERTING, IDLE };
+
+    void
+    convert()
+    {
+        auto now = std::chrono::steady_clock::now();
+        conversions++;
+        for (auto& device : devices) {
+            if (device.active) {
+                int16_t raw = serial[device.rom[1]] * 16;
+                bool bad = device.scratchpad[8] != mraa_uart_ow_crc8(device.scratchpad, 8);
+                device.scratchpad[0] = raw & 0xff;
+                device.scratchpad[1] = raw >> 8;
+                device.scratchpad[8] = mraa_uart_ow_crc8(device.scratchpad, 8) ^ (bad ? 1 : 0);
+                device.busy_until = now + std::chrono::milliseconds(CONVERSION_MS);
+            }
+        }
+    }
+
+    static bool
+    bit_of(const uint8_t* data, int bit)
+    {
+        return (data[bit / 8] >> (bit % 8)) & 1;
+    }
+
+    /* A selected device at the speed of the slot */
+    bool
+    hears(const ow_device& device)
+    {
+        return device.active && device.overdrive == od_slot;
+    }
+
+    /* Wired AND of what the selected devices put on the bus */
+    template <typename F>
+    bool
+    drive(F device_bit)
+    {
+        bool bus = true;
+        for (auto& device : devices) {
+            if (hears(device)) {
+                bus = bus && device_bit(device);
+            }
+        }
+        return bus;
+    }
+
+    /* A standard speed reset reaches every device and ends overdrive,
+     * an overdrive one only the devices in overdrive */
+    uint8_t
+    reset(bool overdrive)
+    {
+        bool presence = false;
+        st = ROM_CMD;
+        count = 0;
+        cmd = 0;
+        for (auto& device : devices) {
+            if (!overdrive) {
+                device.overdrive = false;
+            }
+            device.active = device.overdrive == overdrive;
+            presence = presence || device.active;
+        }
+        if (overdrive && !presence) {
+            speed_errors++;
+        }
+        return presence ? 0xe0 : 0xf0;
+    }
+
+    bool
+    slot(bool master_bit)
+    {
+        bool bus = master_bit;
+        for (auto& device : devices) {
+            if (device.active && st != IDLE && !hears(device)) {
+                speed_errors++;
+                break;
+            }
+        }
+        switch (st) {
+            case ROM_CMD:
+            case FUNCTION:
+                cmd |= master_bit << count;
+                if (++count < 8) {
+                    break;
+                }
+                count = 0;
+                if (st == FUNCTION) {
+                    if (cmd == MRAA_UART_OW_CMD_CONVERT_T) {
+                        convert();
+                        st = CONVERTING;
+                    } else {
+                        st = cmd == MRAA_UART_OW_CMD_READ_SCRATCHPAD ? READ_SCRATCHPAD : IDLE;
+                    }
+                } else if (cmd == MRAA_UART_OW_CMD_READ_ROM) {
+                    st = READ_ROM;
+                } else if (cmd == MRAA_UART_OW_CMD_MATCH_ROM) {
+                    st = MATCH_ROM;
+                } else if (cmd == MRAA_UART_OW_CMD_SEARCH_ROM) {
+                    st = SEARCH_ROM;
+                    /* nobody answers this one, as if they all dropped out */
+                    if (silent_search == 0) {
+                        st = IDLE;
+                    }
+                    if (silent_search >= 0) {
+                        silent_search--;
+                    }
+                } else if (cmd == MRAA_UART_OW_CMD_SKIP_ROM) {
+                    st = FUNCTION;
+                } else if (cmd == MRAA_UART_OW_CMD_SKIP_ROM_OVERDRIVE || cmd == MRAA_UART_OW_CMD_MATCH_ROM_OVERDRIVE) {
+                    for (auto& device : devices) {
+                        device.overdrive = device.overdrive || device.active;
+                    }
+                    st = cmd == MRAA_UART_OW_CMD_SKIP_ROM_OVERDRIVE ? FUNCTION : MATCH_ROM;
+                    od_match = cmd == MRAA_UART_OW_CMD_MATCH_ROM_OVERDRIVE;
+                } else {
+                    st = IDLE;
+                }
+                cmd = 0;
+                break;
+            case READ_ROM:
+                bus = master_bit && drive([&](ow_device& d) { return bit_of(d.rom, count); });
+                if (++count == 64) {
+                    st = FUNCTION;
+                    count = 0;
+                }
+                break;
+            case MATCH_ROM:
+                for (auto& device : devices) {
+                    device.active = hears(device) && bit_of(device.rom, count) == master_bit;
+                }
+                if (++count == 64) {
+                    /* only the device matched stays in overdrive */
+                    for (auto& device : devices) {
+                        device.overdrive = device.overdrive && (!od_match || device.active);
+                    }
+                    od_match = false;
+                    st = FUNCTION;
+                    count = 0;
+                }
+                break;
+            case SEARCH_ROM: {
+                int bit = count / 3;
+                if (count % 3 == 0) {
+                    bus = master_bit && drive([&](ow_device& d) { return bit_of(d.rom, bit); });
+                } else if (count % 3 == 1) {
+                    bus = master_bit && drive([&](ow_device& d) { return !bit_of(d.rom, bit); });
+                } else {
+                    for (auto& device : devices) {
+                        device.active = hears(device) && bit_of(device.rom, bit) == master_bit;
+                    }
+                }
+                if (++count == 64 * 3) {
+                    st = IDLE;
+                }
+                break;
+            }
+            case READ_SCRATCHPAD:
+                if (count < 72) {
+                    bus = master_bit && drive([&](ow_device& d) { return bit_of(d.scratchpad, count); });
+                }
+                count++;
+                break;
+            case CONVERTING: {
+                /* read slots are held low until the conversion is done */
+                auto now = std::chrono::steady_clock::now();
+                bus = master_bit && drive([&](ow_device& d) { return now >= d.busy_until; });
+                break;
+            }
+            case IDLE:
+                break;
+        }
+        return bus;
+    }
+
+    void
+    run()
+    {
+        uint8_t buf[256];
+        struct pollfd pfd = { master, POLLIN, 0 };
+
+        while (!stop) {
+            if (poll(&pfd, 1, 10) <= 0) {
+                continue;
+            }
+            ssize_t n = read(master, buf, sizeof(buf));
+            if (n <= 0) {
+                continue;
+            }
+            /* 9600 and 115200 bd are the standard speed reset and slots,
+             * 1 Mbd the overdrive slots and anything else the overdrive
+             * reset */
+            struct termios termio;
+            tcgetattr(master, &termio);
+            speed_t speed = cfgetospeed(&termio);
+            bool reset_speed = speed != B115200 && speed != B1000000;
+            od_slot = speed == B1000000;
+            if (od_slot) {
+                overdrive_slots += n;
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            for (ssize_t i = 0; i < n; i++) {
+                if (reset_speed) {
+                    buf[i] = buf[i] == 0xf0 ? reset(speed != B9600) : buf[i];
+                } else if (buf[i] == 0xff) {
+                    buf[i] = slot(true) ? 0xff : 0xfc;
+                } else {
+                    slot(false);
+                    buf[i] = 0x00;
+                }
+            }
+            if (!reset_speed) {
+                bursts++;
+            }
+            if (write(master, buf, n) != n) {
+                ADD_FAILURE() << "echo failed";
+            }
+        }
+    }
+
+    std::thread thread;
+    std::mutex lock;
+    std::vector<ow_device> devices;
+    uint8_t serial[256] = {};
+    state st = IDLE;
+    int count = 0;
+    uint8_t cmd = 0;
+    bool od_slot = false;
+    bool od_match = false;
+    int silent_search = -1; /**< search rom commands until one goes unanswered */
+};
+
+/* UART 1-wire over a pseudo terminal with a simulated bus on the far end */
+class mraa_uart_ow_h : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mraa_uart_ow_h() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mraa_uart_ow_h() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            dev = NULL;
+            bus = NULL;
+            master = -1;
+            if (mraa_get_platform_type() == MRAA_MOCK_PLATFORM) {
+                GTEST_SKIP() << "uart functions are replaced on the mock platform";
+            }
+            master = posix_openpt(O_RDWR | O_NOCTTY);
+            ASSERT_GE(master, 0);
+            ASSERT_EQ(0, grantpt(master));
+            ASSERT_EQ(0, unlockpt(master));
+            dev = mraa_uart_ow_init_raw(ptsname(master));
+            ASSERT_TRUE(dev != NULL);
+            bus = new ow_bus(master);
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            delete bus;
+            if (dev != NULL) {
+                mraa_uart_ow_stop(dev);
+            }
+            if (master >= 0) {
+                close(master);
+            }
+        }
+
+        int master;
+        ow_bus* bus;
+        mraa_uart_ow_context dev;
+};
+
+TEST_F(mraa_uart_ow_h, test_reset)
+{
+    ASSERT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, mraa_uart_ow_reset(dev));
+    bus->add_device(1);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(dev));
+}
+
+/* Read ROM with one device, byte and bit at a time */
+TEST_F(mraa_uart_ow_h, test_read_rom)
+{
+    uint8_t rom[MRAA_UART_OW_ROMCODE_SIZE];
+
+    bus->add_device(7);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(dev));
+    ASSERT_EQ(MRAA_UART_OW_CMD_READ_ROM, mraa_uart_ow_write_byte(dev, MRAA_UART_OW_CMD_READ_ROM));
+    rom[0] = 0;
+    for (int i = 0; i < 8; i++) {
+        rom[0] |= mraa_uart_ow_bit(dev, 1) << i;
+    }
+    for (int i = 1; i < MRAA_UART_OW_ROMCODE_SIZE; i++) {
+        rom[i] = mraa_uart_ow_read_byte(dev);
+    }
+    ASSERT_EQ(0, memcmp(rom, bus->get_devices()[0].rom, sizeof(rom)));
+}
+
+TEST_F(mraa_uart_ow_h, test_search)
+{
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+    std::set<std::string> found;
+
+    bus->add_device(0x11);
+    bus->add_device(0x12);
+    bus->add_device(0x81);
+
+    mraa_result_t rv = mraa_uart_ow_rom_search(dev, 1, id);
+    while (rv == MRAA_SUCCESS) {
+        ASSERT_EQ(id[7], mraa_uart_ow_crc8(id, 7));
+        ASSERT_TRUE(found.insert(std::string((char*) id, sizeof(id))).second);
+        rv = mraa_uart_ow_rom_search(dev, 0, id);
+    }
+    ASSERT_EQ(3u, found.size());
+    for (auto& device : bus->get_devices()) {
+        ASSERT_EQ(1u, found.count(std::string((char*) device.rom, sizeof(device.rom))));
+    }
+}
+
+/* Match ROM, the rom code and the command go out as one block */
+TEST_F(mraa_uart_ow_h, test_command_block)
+{
+    uint8_t scratchpad[9];
+
+    bus->add_device(0x21);
+    bus->add_device(0x42);
+    std::vector<ow_device> devices = bus->get_devices();
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(dev, 0xbe, devices[1].rom));
+    memset(scratchpad, 0xff, sizeof(scratchpad));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_block(dev, scratchpad, sizeof(scratchpad)));
+    ASSERT_EQ(0, memcmp(scratchpad, devices[1].scratchpad, sizeof(scratchpad)));
+
+    /* 80 + 72 bit slots, a handful of writes rather than one per slot */
+    ASSERT_LE(bus->bursts, 10);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_block(dev, NULL, 0));
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_ow_block(dev, NULL, 1));
+}
+
+/* One conversion for the whole bus, ended by the devices signalling done */
+TEST_F(mraa_uart_ow_h, test_read_temperatures)
+{
+    const int count = 6;
+    mraa_uart_ow_temperature_t readings[count + 1];
+
+    for (int i = 0; i < count; i++) {
+        bus->add_device(20 + i, i == 2);
+    }
+    std::vector<ow_device> devices = bus->get_devices();
+    for (int i = 0; i < count; i++) {
+        memcpy(readings[i].id, devices[i].rom, MRAA_UART_OW_ROMCODE_SIZE);
+    }
+    /* not on the bus */
+    memcpy(readings[count].id, devices[0].rom, MRAA_UART_OW_ROMCODE_SIZE);
+    readings[count].id[1] = 0x99;
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(count - 1, mraa_uart_ow_read_temperatures(dev, readings, count + 1, 0));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    ASSERT_EQ(1, bus->conversions);
+    ASSERT_GE(elapsed.count(), CONVERSION_MS);
+    ASSERT_LT(elapsed.count(), 2 * CONVERSION_MS + 200);
+    for (int i = 0; i < count; i++) {
+        ASSERT_EQ(i != 2, readings[i].ok) << i;
+        ASSERT_EQ((20 + i) * 16, readings[i].raw) << i;
+    }
+    ASSERT_FALSE(readings[count].ok);
+
+    /* a fixed conversion time for parasite power */
+    start = std::chrono::steady_clock::now();
+    ASSERT_EQ(count - 1, mraa_uart_ow_read_temperatures(dev, readings, count, 150));
+    elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    ASSERT_GE(elapsed.count(), 150);
+    ASSERT_EQ(2, bus->conversions);
+}
+
+/* Overdrive for all devices, then for one, and back to standard speed */
+TEST_F(mraa_uart_ow_h, test_overdrive)
+{
+    uint8_t scratchpad[9];
+
+    bus->add_device(0x61);
+    bus->add_device(0x62);
+    std::vector<ow_device> devices = bus->get_devices();
+
+    ASSERT_EQ(MRAA_UART_OW_SPEED_STANDARD, mraa_uart_ow_get_speed(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_overdrive(dev, NULL));
+    ASSERT_EQ(MRAA_UART_OW_SPEED_OVERDRIVE, mraa_uart_ow_get_speed(dev));
+
+    /* overdrive resets and slots from here on */
+    int slots = bus->overdrive_slots;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(dev, MRAA_UART_OW_CMD_READ_SCRATCHPAD, devices[1].rom));
+    memset(scratchpad, 0xff, sizeof(scratchpad));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_block(dev, scratchpad, sizeof(scratchpad)));
+    ASSERT_EQ(0, memcmp(scratchpad, devices[1].scratchpad, sizeof(scratchpad)));
+    ASSERT_EQ(80 + 72, bus->overdrive_slots - slots);
+    ASSERT_EQ(0, bus->speed_errors);
+
+    /* standard speed resets take everything back */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_set_speed(dev, MRAA_UART_OW_SPEED_STANDARD));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_reset(dev));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_command(dev, MRAA_UART_OW_CMD_READ_SCRATCHPAD, devices[0].rom));
+    memset(scratchpad, 0xff, sizeof(scratchpad));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_block(dev, scratchpad, sizeof(scratchpad)));
+    ASSERT_EQ(0, memcmp(scratchpad, devices[0].scratchpad, sizeof(scratchpad)));
+    ASSERT_EQ(0, bus->speed_errors);
+
+    /* only the device matched goes to overdrive */
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_overdrive(dev, devices[0].rom));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_rom_verify(dev, devices[0].rom));
+    ASSERT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, mraa_uart_ow_rom_verify(dev, devices[1].rom));
+    ASSERT_EQ(0, bus->speed_errors);
+
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_ow_set_speed(dev, (mraa_uart_ow_speed_t) 2));
+}
+
+static std::set<std::string>
+change_set(const mraa_uart_ow_change_t* changes, int count, bool present)
+{
+    std::set<std::string> ids;
+    for (int i = 0; i < count; i++) {
+        if ((bool) changes[i].present == present) {
+            ids.insert(std::string((char*) changes[i].id, MRAA_UART_OW_ROMCODE_SIZE));
+        }
+    }
+    return ids;
+}
+
+static std::string
+rom_of(uint8_t serial, uint8_t family = 0x28)
+{
+    uint8_t rom[MRAA_UART_OW_ROMCODE_SIZE] = { family, serial, 0x5a, serial, 0x00, 0x01, 0x00, 0x00 };
+    rom[7] = mraa_uart_ow_crc8(rom, 7);
+    return std::string((char*) rom, sizeof(rom));
+}
+
+/* Known devices are verified with one write each */
+TEST_F(mraa_uart_ow_h, test_rom_verify)
+{
+    bus->add_device(0x31);
+    bus->add_device(0x32);
+
+    std::string there = rom_of(0x32), gone = rom_of(0x33);
+    int bursts = bus->bursts;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_rom_verify(dev, (uint8_t*) there.data()));
+    ASSERT_LE(bus->bursts - bursts, 2);
+    ASSERT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, mraa_uart_ow_rom_verify(dev, (uint8_t*) gone.data()));
+
+    bus->remove_device(0x31);
+    bus->remove_device(0x32);
+    ASSERT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, mraa_uart_ow_rom_verify(dev, (uint8_t*) there.data()));
+}
+
+TEST_F(mraa_uart_ow_h, test_inventory)
+{
+    mraa_uart_ow_change_t changes[16];
+    uint8_t id[MRAA_UART_OW_ROMCODE_SIZE];
+
+    mraa_uart_ow_inventory_context inv = mraa_uart_ow_inventory_init(dev);
+    ASSERT_TRUE(inv != NULL);
+    for (int i = 0; i < 4; i++) {
+        bus->add_device(0x40 + i);
+        bus->add_device(0x50 + i, false, 0x10);
+    }
+
+    /* everything is new at first, nothing changes the second time */
+    ASSERT_EQ(8, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+    ASSERT_EQ(8u, change_set(changes, 8, true).size());
+    ASSERT_EQ(8, mraa_uart_ow_inventory_get_count(inv));
+    ASSERT_EQ(0, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+    ASSERT_EQ(0, mraa_uart_ow_inventory_verify(inv, changes, 16));
+
+    /* verify catches what went away, not what came */
+    bus->remove_device(0x41);
+    bus->add_device(0x44);
+    ASSERT_EQ(1, mraa_uart_ow_inventory_verify(inv, changes, 16));
+    ASSERT_EQ(rom_of(0x41), std::string((char*) changes[0].id, sizeof(id)));
+    ASSERT_FALSE(changes[0].present);
+    ASSERT_EQ(7, mraa_uart_ow_inventory_get_count(inv));
+
+    /* a family search only touches its family */
+    bus->remove_device(0x52);
+    bus->add_device(0x55, false, 0x10);
+    int bursts = bus->bursts;
+    ASSERT_EQ(2, mraa_uart_ow_inventory_search(inv, 0x10, changes, 16));
+    ASSERT_EQ(std::set<std::string>{ rom_of(0x55, 0x10) }, change_set(changes, 2, true));
+    ASSERT_EQ(std::set<std::string>{ rom_of(0x52, 0x10) }, change_set(changes, 2, false));
+    ASSERT_EQ(7, mraa_uart_ow_inventory_get_count(inv));
+    int family_bursts = bus->bursts - bursts;
+
+    ASSERT_EQ(1, mraa_uart_ow_inventory_search(inv, 0x28, changes, 16));
+    ASSERT_EQ(rom_of(0x44), std::string((char*) changes[0].id, sizeof(id)));
+    ASSERT_TRUE(changes[0].present);
+    ASSERT_EQ(8, mraa_uart_ow_inventory_get_count(inv));
+    ASSERT_EQ(0, mraa_uart_ow_inventory_search(inv, 0x22, changes, 16));
+
+    /* the family search didn't walk the whole bus */
+    bursts = bus->bursts;
+    ASSERT_EQ(0, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+    ASSERT_LT(family_bursts, bus->bursts - bursts);
+
+    /* more changes than room */
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_inventory_get_id(inv, i, id));
+        bus->remove_device(id[1]);
+    }
+    ASSERT_EQ(MRAA_ERROR_INVALID_PARAMETER, mraa_uart_ow_inventory_get_id(inv, 8, id));
+    ASSERT_EQ(8, mraa_uart_ow_inventory_search(inv, -1, changes, 2));
+    ASSERT_EQ(0, mraa_uart_ow_inventory_get_count(inv));
+
+    /* a search that breaks off half way reports nothing as removed */
+    for (int i = 0; i < 4; i++) {
+        bus->add_device(0x60 + i);
+    }
+    ASSERT_EQ(4, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+    bus->silence_search(2);
+    ASSERT_EQ(-1, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+    ASSERT_EQ(4, mraa_uart_ow_inventory_get_count(inv));
+    bus->silence_search(0);
+    ASSERT_EQ(-1, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+    ASSERT_EQ(4, mraa_uart_ow_inventory_get_count(inv));
+    ASSERT_EQ(0, mraa_uart_ow_inventory_search(inv, -1, changes, 16));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_inventory_stop(inv));
+}
+
+/* The bitwise CRC8 mraa used before the lookup tables */
+static uint8_t
+crc8_bitwise(const uint8_t* buffer, size_t length)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t data = buffer[i];
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t feedback = (crc ^ data) & 0x01;
+            crc >>= 1;
+            if (feedback)
+                crc ^= 0x8c;
+            data >>= 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t
+crc16_bitwise(const uint8_t* buffer, size_t length)
+{
+    uint16_t crc = 0;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= buffer[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xa001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+TEST(mraa_uart_ow_crc, test_check_values)
+{
+    uint8_t check[] = "123456789";
+    /* CRC-8/MAXIM and CRC-16/MAXIM, the latter is sent inverted */
+    ASSERT_EQ(0xa1, mraa_uart_ow_crc8(check, 9));
+    ASSERT_EQ(0xa1, mraa_uart_ow_crc8_slice4(check, 9));
+    ASSERT_EQ(0x44c2, (uint16_t) ~mraa_uart_ow_crc16(check, 9));
+    ASSERT_EQ(0x44c2, (uint16_t) ~mraa_uart_ow_crc16_slice4(check, 9));
+
+    /* a buffer followed by its CRC checks to 0 */
+    uint8_t rom[8] = { 0x28, 0xff, 0x4b, 0x6f, 0x74, 0x16, 0x04, 0x00 };
+    rom[7] = mraa_uart_ow_crc8(rom, 7);
+    ASSERT_EQ(0, mraa_uart_ow_crc8(rom, 8));
+    uint8_t page[34] = { 0x0f, 0x00, 0x00 };
+    uint16_t crc = mraa_uart_ow_crc16(page, 32);
+    page[32] = crc & 0xff;
+    page[33] = crc >> 8;
+    ASSERT_EQ(0, mraa_uart_ow_crc16_slice4(page, 34));
+}
+
+TEST(mraa_uart_ow_crc, test_matches_bitwise)
+{
+    std::vector<uint8_t> buf(300);
+    srand(44);
+    for (size_t i = 0; i < buf.size(); i++) {
+        buf[i] = rand();
+    }
+    for (size_t length = 0; length <= buf.size(); length++) {
+        uint8_t crc8 = crc8_bitwise(buf.data(), length);
+        uint16_t crc16 = crc16_bitwise(buf.data(), length);
+        ASSERT_EQ(crc8, mraa_uart_ow_crc8(buf.data(), length)) << length;
+        ASSERT_EQ(crc8, mraa_uart_ow_crc8_slice4(buf.data(), length)) << length;
+        ASSERT_EQ(crc16, mraa_uart_ow_crc16(buf.data(), length)) << length;
+        ASSERT_EQ(crc16, mraa_uart_ow_crc16_slice4(buf.data(), length)) << length;
+    }
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "mraa/uart.h"
+#include "mraa/uart_ow.h"
+#include "mock/mock_board_uart.h"
+
+static long
+now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* The mock UART line between the context and the loopback or a test peer */
+class mock_board_uart : public ::testing::Test
+{
+    protected:
+        /* One-time setup logic if needed */
+        mock_board_uart() {}
+
+        /* One-time tear-down logic if needed */
+        virtual ~mock_board_uart() {}
+
+        /* Per-test setup logic if needed */
+        virtual void SetUp()
+        {
+            dev = mraa_uart_init(0);
+            ASSERT_TRUE(dev != NULL);
+            ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_timeout(dev, 1000, 0, 100));
+        }
+
+        /* Per-test tear-down logic if needed */
+        virtual void TearDown()
+        {
+            if (dev != NULL) {
+                mraa_uart_stop(dev);
+            }
+        }
+
+        /* Read until the line stays quiet */
+        std::string read_all(size_t max)
+        {
+            std::string data(max, '\0');
+            size_t got = 0;
+            while (got < max) {
+                int n = mraa_uart_read(dev, &data[got], max - got);
+                if (n <= 0) {
+                    break;
+                }
+                got += n;
+            }
+            data.resize(got);
+            return data;
+        }
+
+        mraa_uart_context dev;
+};
+
+/* Written bytes come back at the rate the line allows */
+TEST_F(mock_board_uart, test_loopback_rate)
+{
+    std::string out(1000, '\0');
+    for (size_t i = 0; i < out.size(); i++) {
+        out[i] = (char) i;
+    }
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 115200));
+    long start = now_ms();
+    ASSERT_EQ(1000, mraa_uart_write(dev, out.data(), out.size()));
+    std::string in = read_all(out.size());
+    long elapsed = now_ms() - start;
+
+    ASSERT_EQ(out, in);
+    /* 10 bits a byte, 87ms */
+    ASSERT_GE(elapsed, 80);
+    ASSERT_LT(elapsed, 500);
+
+    mraa_mock_uart_line_stats_t stats;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_get_line_stats(dev, &stats));
+    ASSERT_EQ(1000u, stats.rx_bytes);
+}
+
+/* Parity and a second stop bit make characters longer */
+TEST_F(mock_board_uart, test_flush_framing)
+{
+    std::string out(100, 'x');
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_mode(dev, 8, MRAA_UART_PARITY_EVEN, 2));
+    long start = now_ms();
+    ASSERT_EQ(100, mraa_uart_write(dev, out.data(), out.size()));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(dev));
+    long elapsed = now_ms() - start;
+
+    /* 12 bits a byte at 9600, 125ms */
+    ASSERT_GE(elapsed, 115);
+    ASSERT_LT(elapsed, 500);
+    ASSERT_EQ(out, read_all(out.size()));
+}
+
+/* A peer replaces the loopback until it hangs up */
+TEST_F(mock_board_uart, test_peer)
+{
+    char buf[4];
+    int peer = mraa_mock_uart_open_peer(dev);
+    ASSERT_GE(peer, 0);
+
+    ASSERT_EQ(4, write(peer, "ping", 4));
+    ASSERT_EQ("ping", read_all(4));
+
+    ASSERT_EQ(4, mraa_uart_write(dev, "pong", 4));
+    struct pollfd pfd = { peer, POLLIN, 0 };
+    size_t got = 0;
+    while (got < sizeof(buf) && poll(&pfd, 1, 1000) > 0) {
+        ssize_t n = read(peer, buf + got, sizeof(buf) - got);
+        ASSERT_GT(n, 0);
+        got += n;
+    }
+    ASSERT_EQ(0, memcmp(buf, "pong", 4));
+    ASSERT_FALSE(mraa_uart_data_available(dev, 50));
+
+    close(peer);
+    usleep(20000);
+    ASSERT_EQ(4, mraa_uart_write(dev, "echo", 4));
+    ASSERT_EQ("echo", read_all(4));
+}
+
+TEST_F(mock_board_uart, test_latency)
+{
+    mraa_mock_uart_line_config_t config = { 50000, 0, 0, 0 };
+    char c;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_set_line(dev, &config));
+    long start = now_ms();
+    ASSERT_EQ(1, mraa_uart_write(dev, "L", 1));
+    ASSERT_EQ(1, mraa_uart_read(dev, &c, 1));
+    ASSERT_GE(now_ms() - start, 50);
+}
+
+TEST_F(mock_board_uart, test_drops)
+{
+    mraa_mock_uart_line_config_t config = { 0, 250000, 0, 7 };
+    mraa_mock_uart_line_stats_t stats;
+    std::string out(200, 'd');
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 115200));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_set_line(dev, &config));
+    ASSERT_EQ(200, mraa_uart_write(dev, out.data(), out.size()));
+    std::string in = read_all(out.size());
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_get_line_stats(dev, &stats));
+    ASSERT_GT(stats.dropped, 20u);
+    ASSERT_LT(stats.dropped, 100u);
+    ASSERT_EQ(200u, stats.dropped + in.size());
+    ASSERT_EQ(in.size(), stats.rx_bytes);
+}
+
+/* Without parity checking a parity error goes unnoticed and garbles the byte */
+TEST_F(mock_board_uart, test_parity_garbled)
+{
+    mraa_mock_uart_line_config_t config = { 0, 0, 1000000, 0 };
+    mraa_mock_uart_line_stats_t stats;
+    std::string out(20, 'p');
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_baudrate(dev, 115200));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_set_line(dev, &config));
+    ASSERT_EQ(20, mraa_uart_write(dev, out.data(), out.size()));
+    std::string in = read_all(out.size());
+
+    ASSERT_EQ(20u, in.size());
+    for (size_t i = 0; i < in.size(); i++) {
+        ASSERT_NE('p', in[i]);
+        ASSERT_EQ(1, __builtin_popcount((unsigned char) (in[i] ^ 'p')));
+    }
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_get_line_stats(dev, &stats));
+    ASSERT_EQ(20u, stats.parity_errors);
+}
+
+/* With INPCK the tty reads parity errors as NULs, with IGNPAR it drops them */
+TEST_F(mock_board_uart, test_parity_checked)
+{
+    mraa_mock_uart_line_config_t config = { 0, 0, 1000000, 0 };
+    struct termios termio;
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_set_mode(dev, 8, MRAA_UART_PARITY_ODD, 1));
+    ASSERT_EQ(0, tcgetattr(dev->fd, &termio));
+    termio.c_iflag |= INPCK;
+    ASSERT_EQ(0, tcsetattr(dev->fd, TCSANOW, &termio));
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_set_line(dev, &config));
+    ASSERT_EQ(2, mraa_uart_write(dev, "ab", 2));
+    ASSERT_EQ(std::string("\000\000", 2), read_all(2));
+
+    termio.c_iflag |= IGNPAR;
+    ASSERT_EQ(0, tcsetattr(dev->fd, TCSANOW, &termio));
+    ASSERT_EQ(2, mraa_uart_write(dev, "ab", 2));
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_flush(dev));
+    ASSERT_FALSE(mraa_uart_data_available(dev, 50));
+}
+
+/* 1-wire on a bus that never answers waits in poll() rather than spinning */
+TEST(mock_board_uart_ow, test_unresponsive_bus)
+{
+    mraa_mock_uart_line_config_t config = { 0, 1000000, 0, 0 };
+    struct timespec cpu_start, cpu_end;
+
+    mraa_uart_ow_context ow = mraa_uart_ow_init(0);
+    ASSERT_TRUE(ow != NULL);
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_set_line(ow->uart, &config));
+
+    /* default deadline, from the bit rate */
+    long start = now_ms();
+    ASSERT_EQ(MRAA_ERROR_NO_DATA_AVAILABLE, mraa_uart_ow_reset(ow));
+    long elapsed = now_ms() - start;
+    ASSERT_GE(elapsed, 50);
+    ASSERT_LT(elapsed, 1000);
+
+    ASSERT_EQ(MRAA_SUCCESS, mraa_uart_ow_set_timeout(ow, 500));
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+    start = now_ms();
+    ASSERT_EQ(MRAA_ERROR_NO_DATA_AVAILABLE, mraa_uart_ow_reset(ow));
+    elapsed = now_ms() - start;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+
+    long cpu_ms = (cpu_end.tv_sec - cpu_start.tv_sec) * 1000 + (cpu_end.tv_nsec - cpu_start.tv_nsec) / 1000000;
+    ASSERT_GE(elapsed, 500);
+    ASSERT_LT(cpu_ms, 50);
+
+    /* a bus that echoes works as before, the loopback is a bus without devices */
+    config.drop_ppm = 0;
+    ASSERT_EQ(MRAA_SUCCESS, mraa_mock_uart_set_line(ow->uart, &config));
+    ASSERT_EQ(MRAA_ERROR_UART_OW_NO_DEVICES, mraa_uart_ow_reset(ow));
+    ASSERT_EQ(0xa5, mraa_uart_ow_write_byte(ow, 0xa5));
+    mraa_uart_ow_stop(ow);
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * The bitwise crc8 is the one mraa used before the lookup tables:
+ * Copyright (c) 2002 Colin O'Flynn
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mraa.h"
+#include "mraa/uart_ow.h"
+
+void
+print_help(const char* name)
+{
+    fprintf(stdout, "Usage: %s [ bytes total ]\n\n", name);
+    fprintf(stdout, "Compares the 1-wire CRC implementations on rom codes, scratchpads\n");
+    fprintf(stdout, "and EEPROM pages\n");
+    fprintf(stdout, "   bytes    : bytes to checksum per size and variant, default 16000000\n");
+}
+
+static uint64_t
+now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint8_t
+crc8_bitwise(uint8_t* buffer, uint16_t length)
+{
+    // 0x18 = X ^ 8 + X ^ 5 + X ^ 4 + X ^ 0
+    static const uint8_t CRC8POLY = 0x18;
+
+    uint8_t crc = 0x00;
+    uint16_t loop_count;
+    uint8_t bit_counter;
+    uint8_t data;
+    uint8_t feedback_bit;
+
+    for (loop_count = 0; loop_count != length; loop_count++) {
+        data = buffer[loop_count];
+        bit_counter = 8;
+        do {
+            feedback_bit = (crc ^ data) & 0x01;
+            if (feedback_bit == 0x01)
+                crc = crc ^ CRC8POLY;
+            crc = (crc >> 1) & 0x7F;
+            if (feedback_bit == 0x01)
+                crc = crc | 0x80;
+            data = data >> 1;
+            bit_counter--;
+        } while (bit_counter > 0);
+    }
+
+    return crc;
+}
+
+static uint16_t
+crc16_bitwise(uint8_t* buffer, uint16_t length)
+{
+    uint16_t crc = 0x0000;
+    uint16_t i;
+    int bit;
+
+    for (i = 0; i < length; i++) {
+        crc ^= buffer[i];
+        for (bit = 0; bit < 8; bit++)
+            crc = (crc & 0x0001) ? (crc >> 1) ^ 0xa001 : crc >> 1;
+    }
+
+    return crc;
+}
+
+typedef struct {
+    const char* name;
+    uint8_t (*crc8)(uint8_t*, uint16_t);
+    uint16_t (*crc16)(uint8_t*, uint16_t);
+} variant_t;
+
+static const variant_t variants[] = {
+    { "crc8 bitwise", crc8_bitwise, NULL },
+    { "crc8 table", mraa_uart_ow_crc8, NULL },
+    { "crc8 slice4", mraa_uart_ow_crc8_slice4, NULL },
+    { "crc16 bitwise", NULL, crc16_bitwise },
+    { "crc16 table", NULL, mraa_uart_ow_crc16 },
+    { "crc16 slice4", NULL, mraa_uart_ow_crc16_slice4 },
+};
+
+// rom code, scratchpad, EEPROM page, larger block
+static const uint16_t sizes[] = { 8, 9, 32, 256, 4096 };
+
+int
+main(int argc, char** argv)
+{
+    long total = 16000000;
+    uint8_t buf[4096 + 8];
+    volatile unsigned int sink = 0;
+    size_t v, s;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_help(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (strcmp(argv[i], "bytes") == 0 && i + 1 < argc) {
+            total = strtol(argv[++i], NULL, 0);
+        } else {
+            print_help(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (total <= 0) {
+        print_help(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    srand(1);
+    for (i = 0; i < (int) sizeof(buf); i++) {
+        buf[i] = rand();
+    }
+
+    fprintf(stdout, "%-14s", "ns/byte");
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        fprintf(stdout, "%10u", sizes[s]);
+    }
+    fprintf(stdout, "\n");
+
+    for (v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+        fprintf(stdout, "%-14s", variants[v].name);
+        for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+            long rounds = total / sizes[s] + 1;
+            long r;
+            uint64_t start = now_ns();
+            for (r = 0; r < rounds; r++) {
+                // vary the start so the compiler can't hoist the call
+                uint8_t* data = buf + (r & 7);
+                if (variants[v].crc8)
+                    sink += variants[v].crc8(data, sizes[s]);
+                else
+                    sink += variants[v].crc16(data, sizes[s]);
+            }
+            uint64_t elapsed = now_ns() - start;
+            fprintf(stdout, "%10.2f", (double) elapsed / ((double) rounds * sizes[s]));
+        }
+        fprintf(stdout, "\n");
+    }
+
+    return EXIT_SUCCESS;
+}
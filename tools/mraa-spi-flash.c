@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "mraa/spi_flash.h"
+
+void
+print_version()
+{
+    fprintf(stdout, "Version %s on %s\n", mraa_get_version(), mraa_get_platform_name());
+}
+
+void
+print_help()
+{
+    fprintf(stdout, "version                       Get mraa version and board name\n");
+    fprintf(stdout, "info bus                      Identify flash on specified bus\n");
+    fprintf(stdout, "read bus addr len [file]      Read flash to file or hexdump to stdout\n");
+    fprintf(stdout, "write bus addr file           Program file to flash, range must be erased\n");
+    fprintf(stdout, "erase bus addr len            Erase range, aligned to the erase size\n");
+    fprintf(stdout, "chiperase bus                 Erase whole flash\n");
+}
+
+void
+print_command_error()
+{
+    fprintf(stdout, "Invalid command, options are:\n");
+    print_help();
+}
+
+static double
+elapsed_seconds(struct timespec* start)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void
+print_rate(const char* what, uint32_t bytes, struct timespec* start)
+{
+    double secs = elapsed_seconds(start);
+    if (secs > 0) {
+        fprintf(stderr, "%s %u bytes in %.3f s, %.1f KiB/s\n", what, bytes, secs, bytes / secs / 1024);
+    }
+}
+
+static void
+print_info(mraa_spi_flash_context flash)
+{
+    static const char* width[] = { "", "1-1-1", "1-1-2", "", "1-1-4" };
+
+    fprintf(stdout, "JEDEC id:     %02x %02x %02x\n", flash->jedec_id[0], flash->jedec_id[1], flash->jedec_id[2]);
+    fprintf(stdout, "SFDP:         %s\n", flash->sfdp ? "yes" : "no");
+    fprintf(stdout, "Size:         %u bytes\n", flash->size);
+    fprintf(stdout, "Page size:    %u bytes\n", flash->page_size);
+    fprintf(stdout, "Erase:        %u bytes, opcode %02x\n", flash->erase_size, flash->erase_opcode);
+    fprintf(stdout, "Read:         opcode %02x, %s, %u dummy bytes\n", flash->read_opcode,
+            width[flash->read_width], flash->read_dummy);
+    fprintf(stdout, "Address:      %u bytes\n", flash->addr_bytes);
+    fprintf(stdout, "Program time: %u us typical\n", flash->program_time_us);
+    fprintf(stdout, "Max transfer: %u bytes\n", flash->max_transfer);
+}
+
+static int
+flash_read(mraa_spi_flash_context flash, uint32_t addr, uint32_t len, const char* path)
+{
+    struct timespec start;
+    uint8_t* buf = malloc(len > 0 ? len : 1);
+    if (buf == NULL) {
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (mraa_spi_flash_read(flash, addr, buf, len) != MRAA_SUCCESS) {
+        fprintf(stdout, "flash read failed\n");
+        free(buf);
+        return 1;
+    }
+    print_rate("Read", len, &start);
+
+    if (path != NULL) {
+        FILE* fh = fopen(path, "wb");
+        if (fh == NULL || fwrite(buf, 1, len, fh) != len) {
+            fprintf(stdout, "Could not write %s\n", path);
+            if (fh != NULL)
+                fclose(fh);
+            free(buf);
+            return 1;
+        }
+        fclose(fh);
+    } else {
+        uint32_t i;
+        for (i = 0; i < len; i++) {
+            if (i % 16 == 0)
+                fprintf(stdout, "%08x: ", addr + i);
+            fprintf(stdout, "%02x ", buf[i]);
+            if ((i + 1) % 16 == 0 || i + 1 == len)
+                fprintf(stdout, "\n");
+        }
+    }
+    free(buf);
+    return 0;
+}
+
+static int
+flash_write(mraa_spi_flash_context flash, uint32_t addr, const char* path)
+{
+    struct timespec start;
+    FILE* fh = fopen(path, "rb");
+    if (fh == NULL) {
+        fprintf(stdout, "Could not open %s\n", path);
+        return 1;
+    }
+    fseek(fh, 0, SEEK_END);
+    long len = ftell(fh);
+    fseek(fh, 0, SEEK_SET);
+
+    uint8_t* buf = malloc(len > 0 ? len : 1);
+    if (buf == NULL || fread(buf, 1, len, fh) != (size_t) len) {
+        fprintf(stdout, "Could not read %s\n", path);
+        fclose(fh);
+        free(buf);
+        return 1;
+    }
+    fclose(fh);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int status = mraa_spi_flash_write(flash, addr, buf, (uint32_t) len) == MRAA_SUCCESS ? 0 : 1;
+    if (status == 0)
+        print_rate("Programmed", (uint32_t) len, &start);
+    else
+        fprintf(stdout, "flash write failed\n");
+    free(buf);
+    return status;
+}
+
+int
+process_command(int argc, char** argv)
+{
+    mraa_spi_flash_context flash;
+    int status = 1;
+
+    if (strncmp(argv[1], "help", strlen("help") + 1) == 0) {
+        print_help();
+        return 0;
+    } else if (strncmp(argv[1], "version", strlen("version") + 1) == 0) {
+        print_version();
+        return 0;
+    }
+
+    if (argc < 3) {
+        print_command_error();
+        return 1;
+    }
+    flash = mraa_spi_flash_init(strtol(argv[2], NULL, 0));
+    if (flash == NULL) {
+        fprintf(stdout, "No flash found on bus %s\n", argv[2]);
+        return 1;
+    }
+
+    if (strncmp(argv[1], "info", strlen("info") + 1) == 0 && argc == 3) {
+        print_info(flash);
+        status = 0;
+    } else if (strncmp(argv[1], "read", strlen("read") + 1) == 0 && (argc == 5 || argc == 6)) {
+        uint32_t addr = strtoul(argv[3], NULL, 0);
+        uint32_t len = strtoul(argv[4], NULL, 0);
+        status = flash_read(flash, addr, len, argc == 6 ? argv[5] : NULL);
+    } else if (strncmp(argv[1], "write", strlen("write") + 1) == 0 && argc == 5) {
+        status = flash_write(flash, strtoul(argv[3], NULL, 0), argv[4]);
+    } else if (strncmp(argv[1], "erase", strlen("erase") + 1) == 0 && argc == 5) {
+        uint32_t addr = strtoul(argv[3], NULL, 0);
+        uint32_t len = strtoul(argv[4], NULL, 0);
+        if (mraa_spi_flash_erase(flash, addr, len) == MRAA_SUCCESS) {
+            status = 0;
+        } else {
+            fprintf(stdout, "flash erase failed\n");
+        }
+    } else if (strncmp(argv[1], "chiperase", strlen("chiperase") + 1) == 0 && argc == 3) {
+        if (mraa_spi_flash_chip_erase(flash) == MRAA_SUCCESS) {
+            status = 0;
+        } else {
+            fprintf(stdout, "flash chip erase failed\n");
+        }
+    } else {
+        print_command_error();
+    }
+
+    mraa_spi_flash_stop(flash);
+    return status;
+}
+
+int
+main(int argc, char** argv)
+{
+    if (argc == 1) {
+        print_help();
+        return 1;
+    }
+    return process_command(argc, argv);
+}
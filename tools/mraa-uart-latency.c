@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 Intel Corporation.
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "mraa.h"
+
+void
+print_help(const char* name)
+{
+    fprintf(stdout, "Usage: %s dev device [ baud bps ] [ count n ] [ size bytes ] [ lowlat on|off ]\n", name);
+    fprintf(stdout, "       [ trigger bytes ] [ timeout ms ]\n\n");
+    fprintf(stdout, "Measures round trip latency over a UART with TX wired to RX\n");
+    fprintf(stdout, "   dev      : uart index or device path\n");
+    fprintf(stdout, "   baud     : baudrate, default 115200\n");
+    fprintf(stdout, "   count    : round trips to measure, default 1000\n");
+    fprintf(stdout, "   size     : bytes per round trip, default 16\n");
+    fprintf(stdout, "   lowlat   : set low latency mode on or off before measuring\n");
+    fprintf(stdout, "   trigger  : receive FIFO level to set along with low latency mode\n");
+    fprintf(stdout, "   timeout  : give up on a round trip after this many ms, default 100\n");
+}
+
+static uint64_t
+now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static int
+compare_u64(const void* a, const void* b)
+{
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return x < y ? -1 : x > y;
+}
+
+static double
+percentile(uint64_t* sorted, int n, double p)
+{
+    int i = (int) (p / 100.0 * (n - 1) + 0.5);
+    return sorted[i] / 1000.0;
+}
+
+// Send size bytes and wait for all of them to come back, returns the
+// round trip in ns or 0 if they didn't arrive intact in time
+static uint64_t
+round_trip(mraa_uart_context uart, char* tx, char* rx, int size, int timeout_ms, int* corrupt)
+{
+    int got = 0;
+
+    uint64_t start = now_ns();
+    if (mraa_uart_write(uart, tx, size) != size) {
+        return 0;
+    }
+    while (got < size) {
+        uint64_t spent_ms = (now_ns() - start) / 1000000;
+        if (spent_ms >= (uint64_t) timeout_ms || !mraa_uart_data_available(uart, timeout_ms - spent_ms)) {
+            return 0;
+        }
+        int n = mraa_uart_read(uart, rx + got, size - got);
+        if (n <= 0) {
+            return 0;
+        }
+        got += n;
+    }
+    uint64_t elapsed = now_ns() - start;
+
+    if (memcmp(tx, rx, size) != 0) {
+        (*corrupt)++;
+        return 0;
+    }
+    return elapsed;
+}
+
+int
+main(int argc, char** argv)
+{
+    mraa_uart_context uart = NULL;
+    int baudrate = 115200, count = 1000, size = 16, timeout_ms = 100;
+    int lowlat = -1, trigger = 0;
+    int i, j, done = 0, lost = 0, corrupt = 0;
+
+    mraa_init();
+
+    for (i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "dev")) {
+            uart = isdigit(argv[i + 1][0]) ? mraa_uart_init(atoi(argv[i + 1])) : mraa_uart_init_raw(argv[i + 1]);
+            if (uart == NULL) {
+                fprintf(stderr, "%s : cannot open uart %s\n", argv[0], argv[i + 1]);
+                return EXIT_FAILURE;
+            }
+        } else if (!strcmp(argv[i], "baud")) {
+            baudrate = atoi(argv[i + 1]);
+        } else if (!strcmp(argv[i], "count")) {
+            count = atoi(argv[i + 1]);
+        } else if (!strcmp(argv[i], "size")) {
+            size = atoi(argv[i + 1]);
+        } else if (!strcmp(argv[i], "lowlat")) {
+            lowlat = !strcmp(argv[i + 1], "on");
+        } else if (!strcmp(argv[i], "trigger")) {
+            trigger = atoi(argv[i + 1]);
+        } else if (!strcmp(argv[i], "timeout")) {
+            timeout_ms = atoi(argv[i + 1]);
+        } else {
+            break;
+        }
+    }
+    if (i != argc || uart == NULL || baudrate <= 0 || count <= 0 || size <= 0 || timeout_ms <= 0) {
+        print_help(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (mraa_uart_set_baudrate(uart, baudrate) != MRAA_SUCCESS) {
+        fprintf(stderr, "%s : cannot set baudrate %d\n", argv[0], baudrate);
+        return EXIT_FAILURE;
+    }
+    if (lowlat >= 0) {
+        mraa_result_t res = mraa_uart_set_low_latency(uart, lowlat, trigger);
+        if (res != MRAA_SUCCESS) {
+            fprintf(stderr, "warning: setting low latency mode failed (%d), measuring anyway\n", res);
+        }
+    }
+    mraa_uart_flush(uart);
+
+    uint64_t* samples = malloc(count * sizeof(uint64_t));
+    char* tx = malloc(size);
+    char* rx = malloc(size);
+    if (samples == NULL || tx == NULL || rx == NULL) {
+        fprintf(stderr, "%s : out of memory\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < count; i++) {
+        for (j = 0; j < size; j++) {
+            tx[j] = (char) (i + j);
+        }
+        uint64_t ns = round_trip(uart, tx, rx, size, timeout_ms, &corrupt);
+        if (ns == 0) {
+            lost++;
+            // let stragglers of a lost round trip arrive and drop them
+            while (mraa_uart_data_available(uart, timeout_ms)) {
+                mraa_uart_read(uart, rx, size);
+            }
+            continue;
+        }
+        samples[done++] = ns;
+    }
+
+    fprintf(stdout, "%s at %u baud, %d byte round trips, rx trigger %d\n", mraa_uart_get_dev_path(uart),
+            mraa_uart_get_baudrate(uart), size, mraa_uart_get_rx_trigger(uart));
+    fprintf(stdout, "wire time      %10.1f us\n", size * 10 * 1e6 / mraa_uart_get_baudrate(uart));
+    if (done > 0) {
+        uint64_t total = 0;
+        qsort(samples, done, sizeof(uint64_t), compare_u64);
+        for (i = 0; i < done; i++) {
+            total += samples[i];
+        }
+        fprintf(stdout, "min            %10.1f us\n", samples[0] / 1000.0);
+        fprintf(stdout, "mean           %10.1f us\n", total / 1000.0 / done);
+        fprintf(stdout, "p50            %10.1f us\n", percentile(samples, done, 50));
+        fprintf(stdout, "p90            %10.1f us\n", percentile(samples, done, 90));
+        fprintf(stdout, "p99            %10.1f us\n", percentile(samples, done, 99));
+        fprintf(stdout, "p99.9          %10.1f us\n", percentile(samples, done, 99.9));
+        fprintf(stdout, "max            %10.1f us\n", samples[done - 1] / 1000.0);
+    }
+    fprintf(stdout, "completed %d, lost %d, corrupt %d\n", done, lost - corrupt, corrupt);
+
+    free(samples);
+    free(tx);
+    free(rx);
+    mraa_uart_stop(uart);
+    mraa_deinit();
+
+    return done > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}